@@ -173,6 +173,12 @@ HPSOCKET_API ITcpPackServer* HP_Create_TcpPackServer(ITcpServerListener* pListen
 HPSOCKET_API ITcpPackAgent* HP_Create_TcpPackAgent(ITcpAgentListener* pListener);
 // 创建 ITcpPackClient 对象
 HPSOCKET_API ITcpPackClient* HP_Create_TcpPackClient(ITcpClientListener* pListener);
+// 创建 ITcpFramedServer 对象
+HPSOCKET_API ITcpFramedServer* HP_Create_TcpFramedServer(ITcpServerListener* pListener);
+// 创建 ITcpFramedAgent 对象
+HPSOCKET_API ITcpFramedAgent* HP_Create_TcpFramedAgent(ITcpAgentListener* pListener);
+// 创建 ITcpFramedClient 对象
+HPSOCKET_API ITcpFramedClient* HP_Create_TcpFramedClient(ITcpClientListener* pListener);
 
 // 销毁 ITcpServer 对象
 HPSOCKET_API void HP_Destroy_TcpServer(ITcpServer* pServer);
@@ -192,6 +198,12 @@ HPSOCKET_API void HP_Destroy_TcpPackServer(ITcpPackServer* pServer);
 HPSOCKET_API void HP_Destroy_TcpPackAgent(ITcpPackAgent* pAgent);
 // 销毁 ITcpPackClient 对象
 HPSOCKET_API void HP_Destroy_TcpPackClient(ITcpPackClient* pClient);
+// 销毁 ITcpFramedServer 对象
+HPSOCKET_API void HP_Destroy_TcpFramedServer(ITcpFramedServer* pServer);
+// 销毁 ITcpFramedAgent 对象
+HPSOCKET_API void HP_Destroy_TcpFramedAgent(ITcpFramedAgent* pAgent);
+// 销毁 ITcpFramedClient 对象
+HPSOCKET_API void HP_Destroy_TcpFramedClient(ITcpFramedClient* pClient);
 
 #ifdef _UDP_SUPPORT
 
@@ -349,6 +361,48 @@ struct TcpPackClient_Creator
 	}
 };
 
+// ITcpFramedServer 对象创建器
+struct TcpFramedServer_Creator
+{
+	static ITcpFramedServer* Create(ITcpServerListener* pListener)
+	{
+		return HP_Create_TcpFramedServer(pListener);
+	}
+
+	static void Destroy(ITcpFramedServer* pServer)
+	{
+		HP_Destroy_TcpFramedServer(pServer);
+	}
+};
+
+// ITcpFramedAgent 对象创建器
+struct TcpFramedAgent_Creator
+{
+	static ITcpFramedAgent* Create(ITcpAgentListener* pListener)
+	{
+		return HP_Create_TcpFramedAgent(pListener);
+	}
+
+	static void Destroy(ITcpFramedAgent* pAgent)
+	{
+		HP_Destroy_TcpFramedAgent(pAgent);
+	}
+};
+
+// ITcpFramedClient 对象创建器
+struct TcpFramedClient_Creator
+{
+	static ITcpFramedClient* Create(ITcpClientListener* pListener)
+	{
+		return HP_Create_TcpFramedClient(pListener);
+	}
+
+	static void Destroy(ITcpFramedClient* pClient)
+	{
+		HP_Destroy_TcpFramedClient(pClient);
+	}
+};
+
 // ITcpServer 对象智能指针
 typedef CHPSocketPtr<ITcpServer, ITcpServerListener, TcpServer_Creator>			CTcpServerPtr;
 // ITcpAgent 对象智能指针
@@ -367,6 +421,12 @@ typedef CHPSocketPtr<ITcpPackServer, ITcpServerListener, TcpPackServer_Creator>
 typedef CHPSocketPtr<ITcpPackAgent, ITcpAgentListener, TcpPackAgent_Creator>	CTcpPackAgentPtr;
 // ITcpPackClient 对象智能指针
 typedef CHPSocketPtr<ITcpPackClient, ITcpClientListener, TcpPackClient_Creator>	CTcpPackClientPtr;
+// ITcpFramedServer 对象智能指针
+typedef CHPSocketPtr<ITcpFramedServer, ITcpServerListener, TcpFramedServer_Creator>	CTcpFramedServerPtr;
+// ITcpFramedAgent 对象智能指针
+typedef CHPSocketPtr<ITcpFramedAgent, ITcpAgentListener, TcpFramedAgent_Creator>	CTcpFramedAgentPtr;
+// ITcpFramedClient 对象智能指针
+typedef CHPSocketPtr<ITcpFramedClient, ITcpClientListener, TcpFramedClient_Creator>	CTcpFramedClientPtr;
 
 #ifdef _UDP_SUPPORT
 
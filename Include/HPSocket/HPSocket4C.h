@@ -97,6 +97,11 @@ typedef HP_Object	HP_PackClient;
 typedef HP_Object	HP_TcpPackServer;
 typedef HP_Object	HP_TcpPackAgent;
 typedef HP_Object	HP_TcpPackClient;
+typedef HP_Object	HP_FramedSocket;
+typedef HP_Object	HP_FramedClient;
+typedef HP_Object	HP_TcpFramedServer;
+typedef HP_Object	HP_TcpFramedAgent;
+typedef HP_Object	HP_TcpFramedClient;
 
 typedef HP_Object	HP_Listener;
 typedef HP_Object	HP_ServerListener;
@@ -115,6 +120,11 @@ typedef HP_Object	HP_PackClientListener;
 typedef HP_Object	HP_TcpPackServerListener;
 typedef HP_Object	HP_TcpPackAgentListener;
 typedef HP_Object	HP_TcpPackClientListener;
+typedef HP_Object	HP_FramedSocketListener;
+typedef HP_Object	HP_FramedClientListener;
+typedef HP_Object	HP_TcpFramedServerListener;
+typedef HP_Object	HP_TcpFramedAgentListener;
+typedef HP_Object	HP_TcpFramedClientListener;
 
 #ifdef _UDP_SUPPORT
 
@@ -163,6 +173,8 @@ typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnReceive)			(HP_Server pSen
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnPullReceive)		(HP_Server pSender, HP_CONNID dwConnID, int iLength);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnClose)			(HP_Server pSender, HP_CONNID dwConnID, En_HP_SocketOperation enOperation, int iErrorCode);
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnShutdown)			(HP_Server pSender);
+// 仅 TCP 服务端组件触发
+typedef En_HP_HandleResult (__HP_CALL *HP_FN_Server_OnSendWatermark)	(HP_Server pSender, HP_CONNID dwConnID, BOOL bHigh, int iPending);
 
 /* Agent 回调函数 */
 typedef En_HP_HandleResult (__HP_CALL *HP_FN_Agent_OnPrepareConnect)	(HP_Agent pSender, HP_CONNID dwConnID, UINT_PTR socket);
@@ -215,6 +227,12 @@ HPSOCKET_API HP_TcpPackServer __HP_CALL Create_HP_TcpPackServer(HP_TcpServerList
 HPSOCKET_API HP_TcpPackAgent __HP_CALL Create_HP_TcpPackAgent(HP_TcpAgentListener pListener);
 // 创建 HP_TcpPackClient 对象
 HPSOCKET_API HP_TcpPackClient __HP_CALL Create_HP_TcpPackClient(HP_TcpClientListener pListener);
+// 创建 HP_TcpFramedServer 对象
+HPSOCKET_API HP_TcpFramedServer __HP_CALL Create_HP_TcpFramedServer(HP_TcpServerListener pListener);
+// 创建 HP_TcpFramedAgent 对象
+HPSOCKET_API HP_TcpFramedAgent __HP_CALL Create_HP_TcpFramedAgent(HP_TcpAgentListener pListener);
+// 创建 HP_TcpFramedClient 对象
+HPSOCKET_API HP_TcpFramedClient __HP_CALL Create_HP_TcpFramedClient(HP_TcpClientListener pListener);
 
 // 销毁 HP_TcpServer 对象
 HPSOCKET_API void __HP_CALL Destroy_HP_TcpServer(HP_TcpServer pServer);
@@ -234,6 +252,12 @@ HPSOCKET_API void __HP_CALL Destroy_HP_TcpPackServer(HP_TcpPackServer pServer);
 HPSOCKET_API void __HP_CALL Destroy_HP_TcpPackAgent(HP_TcpPackAgent pAgent);
 // 销毁 HP_TcpPackClient 对象
 HPSOCKET_API void __HP_CALL Destroy_HP_TcpPackClient(HP_TcpPackClient pClient);
+// 销毁 HP_TcpFramedServer 对象
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedServer(HP_TcpFramedServer pServer);
+// 销毁 HP_TcpFramedAgent 对象
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedAgent(HP_TcpFramedAgent pAgent);
+// 销毁 HP_TcpFramedClient 对象
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedClient(HP_TcpFramedClient pClient);
 
 // 创建 HP_TcpServerListener 对象
 HPSOCKET_API HP_TcpServerListener __HP_CALL Create_HP_TcpServerListener();
@@ -253,6 +277,12 @@ HPSOCKET_API HP_TcpPackServerListener __HP_CALL Create_HP_TcpPackServerListener(
 HPSOCKET_API HP_TcpPackAgentListener __HP_CALL Create_HP_TcpPackAgentListener();
 // 创建 HP_TcpPackClientListener 对象
 HPSOCKET_API HP_TcpPackClientListener __HP_CALL Create_HP_TcpPackClientListener();
+// 创建 HP_TcpFramedServerListener 对象
+HPSOCKET_API HP_TcpFramedServerListener __HP_CALL Create_HP_TcpFramedServerListener();
+// 创建 HP_TcpFramedAgentListener 对象
+HPSOCKET_API HP_TcpFramedAgentListener __HP_CALL Create_HP_TcpFramedAgentListener();
+// 创建 HP_TcpFramedClientListener 对象
+HPSOCKET_API HP_TcpFramedClientListener __HP_CALL Create_HP_TcpFramedClientListener();
 
 // 销毁 HP_TcpServerListener 对象
 HPSOCKET_API void __HP_CALL Destroy_HP_TcpServerListener(HP_TcpServerListener pListener);
@@ -272,6 +302,12 @@ HPSOCKET_API void __HP_CALL Destroy_HP_TcpPackServerListener(HP_TcpPackServerLis
 HPSOCKET_API void __HP_CALL Destroy_HP_TcpPackAgentListener(HP_TcpPackAgentListener pListener);
 // 销毁 HP_TcpPackClientListener 对象
 HPSOCKET_API void __HP_CALL Destroy_HP_TcpPackClientListener(HP_TcpPackClientListener pListener);
+// 销毁 HP_TcpFramedServerListener 对象
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedServerListener(HP_TcpFramedServerListener pListener);
+// 销毁 HP_TcpFramedAgentListener 对象
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedAgentListener(HP_TcpFramedAgentListener pListener);
+// 销毁 HP_TcpFramedClientListener 对象
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedClientListener(HP_TcpFramedClientListener pListener);
 
 #ifdef _UDP_SUPPORT
 
@@ -340,6 +376,7 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnReceive(HP_ServerListener pListen
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnPullReceive(HP_ServerListener pListener		, HP_FN_Server_OnPullReceive fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnClose(HP_ServerListener pListener			, HP_FN_Server_OnClose fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnShutdown(HP_ServerListener pListener			, HP_FN_Server_OnShutdown fn);
+HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnSendWatermark(HP_ServerListener pListener		, HP_FN_Server_OnSendWatermark fn);
 
 /**********************************************************************************/
 /****************************** Agent 回调函数设置方法 *****************************/
@@ -556,7 +593,7 @@ HPSOCKET_API void __HP_CALL HP_Server_SetReuseAddressPolicy(HP_Server pServer, E
 HPSOCKET_API void __HP_CALL HP_Server_SetSendPolicy(HP_Server pServer, En_HP_SendPolicy enSendPolicy);
 /* 设置 OnSend 事件同步策略（默认：OSSP_NONE，不同步） */
 HPSOCKET_API void __HP_CALL HP_Server_SetOnSendSyncPolicy(HP_Server pServer, En_HP_OnSendSyncPolicy enSyncPolicy);
-/* 设置 Socket 缓存对象锁定时间（毫秒，在锁定期间该 Socket 缓存对象不能被获取使用） */
+/* 设置 Socket 缓存对象锁定时间（毫秒，在锁定期间该 Socket 缓存对象不能被获取使用；TCP 服务端组件的 Socket 缓存对象、数据缓冲区及 ARQ 会话已改为按纪元回收，不受该设置影响，仅 UDP 服务端组件及 SSL 会话缓存池仍使用） */
 HPSOCKET_API void __HP_CALL HP_Server_SetFreeSocketObjLockTime(HP_Server pServer, DWORD dwFreeSocketObjLockTime);
 /* 设置 Socket 缓存池大小（通常设置为平均并发连接数量的 1/3 - 1/2） */
 HPSOCKET_API void __HP_CALL HP_Server_SetFreeSocketObjPool(HP_Server pServer, DWORD dwFreeSocketObjPool);
@@ -612,6 +649,127 @@ HPSOCKET_API BOOL __HP_CALL HP_Server_IsMarkSilence(HP_Server pServer);
 */
 HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendSmallFile(HP_Server pServer, HP_CONNID dwConnID, LPCTSTR lpszFileName, const LPWSABUF pHead, const LPWSABUF pTail);
 
+/*
+* 名称：零拷贝发送数据
+* 描述：直接投递调用者的数据缓冲区（不复制），缓冲区不再被组件引用时调用 fnRelease 归还给调用者
+*		仅 SP_DIRECT 发送策略以零拷贝方式发送，其它情形（SP_PACK / SP_SAFE 策略、PACK 及 SSL 组件等）退化为普通发送
+*		无论调用成功与否，fnRelease 都会被调用且只调用一次，在此之前调用者不能修改或释放缓冲区
+*		
+* 参数：		dwConnID	-- 连接 ID
+*			pBuffer		-- 发送缓冲区
+*			iLength		-- 发送缓冲区长度
+*			fnRelease	-- 缓冲区释放函数（可为 nullptr）
+*			pvArg		-- 缓冲区释放函数的自定义参数
+* 返回值：	TRUE	-- 成功
+*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取 Windows 错误代码
+*/
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendZeroCopy(HP_Server pServer, HP_CONNID dwConnID, const BYTE* pBuffer, int iLength, HP_Fn_SendBufferRelease fnRelease, PVOID pvArg);
+
+/*
+* 名称：广播发送数据
+* 描述：把同一份数据发送给多个连接，数据只复制一次，所有连接共享同一个引用计数缓冲区，
+*		最后一个连接发送完成后释放（SSL 组件退化为逐个连接发送）
+*		发送失败的连接将被关闭，其余连接照常发送
+*		
+* 参数：		pConnIDs	-- 连接 ID 数组
+*			iConnCount	-- 连接 ID 数组长度
+*			pBuffers	-- 发送缓冲区数组
+*			iCount		-- 发送缓冲区数目
+* 返回值：	TRUE	-- 全部连接成功
+*			FALSE	-- 至少一个连接失败，可通过 SYS_GetLastError() 获取最后一个 Windows 错误代码
+*/
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendToMany(HP_Server pServer, const HP_CONNID pConnIDs[], int iConnCount, const WSABUF pBuffers[], int iCount);
+
+/*
+* 名称：创建连接分组
+* 描述：创建一个空的连接分组，连接关闭时自动退出其所在的所有分组，组件停止时销毁所有分组
+*		
+* 返回值：	非 0		-- 成功，返回分组 ID
+*			0		-- 失败，可通过 SYS_GetLastError() 获取 Windows 错误代码
+*/
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_CreateGroup(HP_Server pServer);
+
+/*
+* 名称：销毁连接分组
+* 描述：销毁分组并使其所有成员退出该分组（不影响成员连接本身）
+*		
+* 参数：		dwGroupID	-- 分组 ID
+* 返回值：	TRUE	-- 成功
+*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取 Windows 错误代码
+*/
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_DestroyGroup(HP_Server pServer, DWORD dwGroupID);
+
+/*
+* 名称：加入连接分组
+* 描述：把连接加入指定分组，一个连接可以同时加入多个分组，重复加入同一分组不产生重复成员
+*		
+* 参数：		dwGroupID	-- 分组 ID
+*			dwConnID	-- 连接 ID
+* 返回值：	TRUE	-- 成功
+*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取 Windows 错误代码
+*/
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_JoinGroup(HP_Server pServer, DWORD dwGroupID, HP_CONNID dwConnID);
+
+/*
+* 名称：退出连接分组
+* 描述：把连接从指定分组中移除
+*		
+* 参数：		dwGroupID	-- 分组 ID
+*			dwConnID	-- 连接 ID
+* 返回值：	TRUE	-- 成功
+*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取 Windows 错误代码
+*/
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_LeaveGroup(HP_Server pServer, DWORD dwGroupID, HP_CONNID dwConnID);
+
+/*
+* 名称：向分组发送数据
+* 描述：向分组的所有成员发送同一份数据（参考 HP_TcpServer_SendToMany()），空分组直接返回成功
+*		
+* 参数：		dwGroupID	-- 分组 ID
+*			pBuffers	-- 发送缓冲区数组
+*			iCount		-- 发送缓冲区数目
+* 返回值：	TRUE	-- 全部成员成功
+*			FALSE	-- 分组不存在或至少一个成员失败，可通过 SYS_GetLastError() 获取最后一个 Windows 错误代码
+*/
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendToGroup(HP_Server pServer, DWORD dwGroupID, const WSABUF pBuffers[], int iCount);
+
+/*
+* 名称：获取分组成员数量
+*		
+* 参数：		dwGroupID	-- 分组 ID
+* 返回值：	分组成员数量（分组不存在时返回 0）
+*/
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetGroupMemberCount(HP_Server pServer, DWORD dwGroupID);
+
+/*
+* 名称：获取分组所有成员的连接 ID
+*		
+* 参数：		dwGroupID	-- 分组 ID
+*			pIDs		-- 连接 ID 数组
+*			pdwCount	-- 数组长度（输入），实际成员数量（输出）
+* 返回值：	TRUE	-- 成功
+*			FALSE	-- 失败（分组不存在、分组为空或数组长度不足）
+*/
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_GetGroupMemberIDs(HP_Server pServer, DWORD dwGroupID, HP_CONNID pIDs[], DWORD* pdwCount);
+
+/*
+* 名称：发送文件
+* 描述：向指定连接流式发送文件（或文件的指定区间），不受小文件大小限制
+*		各种发送策略下均通过 TransmitFile() 分段发送，文件数据不经过用户态内存，每段发送完成触发一次 OnSend 事件
+*		（此时 OnSend 事件的 pData 参数为 nullptr，iLength 参数为该段发送的字节数）；发送文件期间向该连接发送的其它数据排在文件之后发送
+*		PACK 及 SSL 组件需对数据封包或加密，仍读入内存后发送，此时文件区间大小不能超过 4096 KB
+*		
+* 参数：		dwConnID		-- 连接 ID
+*			lpszFileName	-- 文件路径
+*			ullOffset		-- 文件区间起始偏移量
+*			ullLength		-- 文件区间长度（0 表示发送到文件末尾）
+*			pHead			-- 头部附加数据
+*			pTail			-- 尾部附加数据
+* 返回值：	TRUE	-- 成功
+*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取 Windows 错误代码
+*/
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendFile(HP_Server pServer, HP_CONNID dwConnID, LPCTSTR lpszFileName, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail);
+
 /**********************************************************************************/
 /***************************** TCP Server 属性访问方法 *****************************/
 
@@ -625,6 +783,22 @@ HPSOCKET_API void __HP_CALL HP_TcpServer_SetSocketBufferSize(HP_TcpServer pServe
 HPSOCKET_API void __HP_CALL HP_TcpServer_SetKeepAliveTime(HP_TcpServer pServer, DWORD dwKeepAliveTime);
 /* 设置异常心跳包间隔（毫秒，0 不发送心跳包，，默认：20 * 1000，如果超过若干次 [默认：WinXP 5 次, Win7 10 次] 检测不到心跳确认包则认为已断线） */
 HPSOCKET_API void __HP_CALL HP_TcpServer_SetKeepAliveInterval(HP_TcpServer pServer, DWORD dwKeepAliveInterval);
+/* 设置是否启用零字节接收模式（启用后空闲连接不占用接收缓冲区，适用于大量空闲连接的场景，默认：FALSE） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetZeroByteReceive(HP_TcpServer pServer, BOOL bZeroByteReceive);
+/* 设置是否启用连接亲和模式（启用后每个连接的 I/O、事件及所属线程内的发送操作固定由同一工作线程无锁处理，新连接由 0 号工作线程接受后转交所属工作线程触发 OnAccept 事件，默认：FALSE） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetWorkerAffinity(HP_TcpServer pServer, BOOL bWorkerAffinity);
+/* 设置静默连接超时时间（毫秒，0 则不检测，默认：0，超时后自动断开连接，需启用 MarkSilence） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetSilenceTimeout(HP_TcpServer pServer, DWORD dwSilenceTimeout);
+/* 设置连接最大存活时间（毫秒，0 则不检测，默认：0，超时后自动断开连接） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetMaxLifetime(HP_TcpServer pServer, DWORD dwMaxLifetime);
+/* 设置发送高水位（字节，0 则不检测，默认：0，连接待发送数据超过高水位时触发 OnSendWatermark(bHigh = TRUE) 通知） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetSendHighWatermark(HP_TcpServer pServer, DWORD dwSendHighWatermark);
+/* 设置发送低水位（字节，默认：0，超过高水位的连接待发送数据回落到低水位时触发 OnSendWatermark(bHigh = FALSE) 通知） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetSendLowWatermark(HP_TcpServer pServer, DWORD dwSendLowWatermark);
+/* 设置内存块本地缓存高水位（每 CPU 本地缓存的空闲内存块超过该值时归还到内存块缓存池，0 则不使用本地缓存，默认：64） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetFreeBufferObjLocalHigh(HP_TcpServer pServer, DWORD dwFreeBufferObjLocalHigh);
+/* 设置内存块本地缓存低水位（本地缓存每次归还或补充到该数量，必须低于高水位，默认：16） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetFreeBufferObjLocalLow(HP_TcpServer pServer, DWORD dwFreeBufferObjLocalLow);
 
 /* 获取 Accept 预投递数量 */
 HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetAcceptSocketCount(HP_TcpServer pServer);
@@ -636,6 +810,28 @@ HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSocketListenQueue(HP_TcpServer pSer
 HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetKeepAliveTime(HP_TcpServer pServer);
 /* 获取异常心跳包间隔 */
 HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetKeepAliveInterval(HP_TcpServer pServer);
+/* 检测是否启用零字节接收模式 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_IsZeroByteReceive(HP_TcpServer pServer);
+/* 检测是否启用连接亲和模式 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_IsWorkerAffinity(HP_TcpServer pServer);
+/* 获取静默连接超时时间 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSilenceTimeout(HP_TcpServer pServer);
+/* 获取连接最大存活时间 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetMaxLifetime(HP_TcpServer pServer);
+/* 获取发送高水位 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSendHighWatermark(HP_TcpServer pServer);
+/* 获取发送低水位 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSendLowWatermark(HP_TcpServer pServer);
+/* 获取内存块本地缓存高水位 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetFreeBufferObjLocalHigh(HP_TcpServer pServer);
+/* 获取内存块本地缓存低水位 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetFreeBufferObjLocalLow(HP_TcpServer pServer);
+/* 获取内存块本地缓存命中及未命中次数（组件运行期间的累计值） */
+HPSOCKET_API void __HP_CALL HP_TcpServer_GetFreeBufferObjLocalStat(HP_TcpServer pServer, ULONGLONG* pullHits, ULONGLONG* pullMisses);
+/* 获取私有堆指定尺寸等级的使用统计（Socket 对象及内存块私有堆的合计，dwClass 超出尺寸等级数量或未使用 Slab 私有堆时返回 FALSE） */
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_GetHeapClassStat(HP_TcpServer pServer, DWORD dwClass, HP_THeapClassStat* pStat);
+/* 获取私有堆中超过 32 KB 的大块内存数量及字节数（Socket 对象及内存块私有堆的合计，未使用 Slab 私有堆时返回 FALSE） */
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_GetHeapLargeStat(HP_TcpServer pServer, SIZE_T* pdwCount, SIZE_T* pdwBytes);
 
 #ifdef _UDP_SUPPORT
 
@@ -686,6 +882,12 @@ HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetMaxTransUnit(HP_UdpArqServer pSer
 HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetMaxMessageSize(HP_UdpArqServer pServer, DWORD dwMaxMessageSize);
 /* 设置握手超时时间（毫秒，默认：5000） */
 HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetHandShakeTimeout(HP_UdpArqServer pServer, DWORD dwHandShakeTimeout);
+/* 设置是否启用 UDP 发送分段卸载（默认：FALSE，需 Windows 10 2004 及以上版本，系统不支持时自动回退为逐包发送） */
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetSegmentOffload(HP_UdpArqServer pServer, BOOL bSegmentOffload);
+/* 设置 FEC 数据分片数量（默认：0，每组数据包数量，与校验分片数量均大于 0 时启用 FEC，通信双方必须一致） */
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFecDataShards(HP_UdpArqServer pServer, DWORD dwDataShards);
+/* 设置 FEC 校验分片数量（默认：0，每组校验包数量，分片总数不超过 64） */
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFecParityShards(HP_UdpArqServer pServer, DWORD dwParityShards);
 
 /* 检测是否开启 nodelay 模式 */
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_IsNoDelay(HP_UdpArqServer pServer);
@@ -709,6 +911,18 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetMaxTransUnit(HP_UdpArqServer pSe
 HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetMaxMessageSize(HP_UdpArqServer pServer);
 /* 获取握手超时时间 */
 HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetHandShakeTimeout(HP_UdpArqServer pServer);
+/* 检测是否启用 UDP 发送分段卸载 */
+HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_IsSegmentOffload(HP_UdpArqServer pServer);
+/* 获取 FEC 数据分片数量 */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFecDataShards(HP_UdpArqServer pServer);
+/* 获取 FEC 校验分片数量 */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFecParityShards(HP_UdpArqServer pServer);
+/* 获取 KCP 数据段缓存池命中次数（组件运行期间的累计值） */
+HPSOCKET_API ULONGLONG __HP_CALL HP_UdpArqServer_GetSegmentPoolHitCount(HP_UdpArqServer pServer);
+/* 获取 KCP 数据段缓存池未命中次数（组件运行期间的累计值） */
+HPSOCKET_API ULONGLONG __HP_CALL HP_UdpArqServer_GetSegmentPoolMissCount(HP_UdpArqServer pServer);
+/* 获取超过缓存尺寸而直接分配的 KCP 数据段数量（组件运行期间的累计值） */
+HPSOCKET_API ULONGLONG __HP_CALL HP_UdpArqServer_GetSegmentPoolOversizeCount(HP_UdpArqServer pServer);
 
 /* 获取等待发送包数量 */
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_GetWaitingSendMessageCount(HP_UdpArqServer pServer, HP_CONNID dwConnID, int* piCount);
@@ -974,7 +1188,7 @@ HPSOCKET_API void __HP_CALL HP_Agent_SetReuseAddressPolicy(HP_Agent pAgent, En_H
 HPSOCKET_API void __HP_CALL HP_Agent_SetSendPolicy(HP_Agent pAgent, En_HP_SendPolicy enSendPolicy);
 /* 设置 OnSend 事件同步策略（默认：OSSP_NONE，不同步） */
 HPSOCKET_API void __HP_CALL HP_Agent_SetOnSendSyncPolicy(HP_Agent pAgent, En_HP_OnSendSyncPolicy enSyncPolicy);
-/* 设置 Socket 缓存对象锁定时间（毫秒，在锁定期间该 Socket 缓存对象不能被获取使用） */
+/* 设置 Socket 缓存对象锁定时间（毫秒，在锁定期间该 Socket 缓存对象不能被获取使用；数据缓冲区已改为按纪元回收，不受该设置影响） */
 HPSOCKET_API void __HP_CALL HP_Agent_SetFreeSocketObjLockTime(HP_Agent pAgent, DWORD dwFreeSocketObjLockTime);
 /* 设置 Socket 缓存池大小（通常设置为平均并发连接数量的 1/3 - 1/2） */
 HPSOCKET_API void __HP_CALL HP_Agent_SetFreeSocketObjPool(HP_Agent pAgent, DWORD dwFreeSocketObjPool);
@@ -1039,6 +1253,8 @@ HPSOCKET_API void __HP_CALL HP_TcpAgent_SetSocketBufferSize(HP_TcpAgent pAgent,
 HPSOCKET_API void __HP_CALL HP_TcpAgent_SetKeepAliveTime(HP_TcpAgent pAgent, DWORD dwKeepAliveTime);
 /* 设置异常心跳包间隔（毫秒，0 不发送心跳包，，默认：20 * 1000，如果超过若干次 [默认：WinXP 5 次, Win7 10 次] 检测不到心跳确认包则认为已断线） */
 HPSOCKET_API void __HP_CALL HP_TcpAgent_SetKeepAliveInterval(HP_TcpAgent pAgent, DWORD dwKeepAliveInterval);
+/* 设置是否启用零字节接收模式（启用后空闲连接不占用接收缓冲区，适用于大量空闲连接的场景，默认：FALSE） */
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetZeroByteReceive(HP_TcpAgent pAgent, BOOL bZeroByteReceive);
 
 /* 获取通信数据缓冲区大小 */
 HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetSocketBufferSize(HP_TcpAgent pAgent);
@@ -1046,6 +1262,8 @@ HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetSocketBufferSize(HP_TcpAgent pAgent)
 HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetKeepAliveTime(HP_TcpAgent pAgent);
 /* 获取异常心跳包间隔 */
 HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetKeepAliveInterval(HP_TcpAgent pAgent);
+/* 检测是否启用零字节接收模式 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpAgent_IsZeroByteReceive(HP_TcpAgent pAgent);
 
 /******************************************************************************/
 /***************************** Client 组件操作方法 *****************************/
@@ -1276,6 +1494,10 @@ HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetMaxTransUnit(HP_UdpArqClient pCli
 HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetMaxMessageSize(HP_UdpArqClient pClient, DWORD dwMaxMessageSize);
 /* 设置握手超时时间（毫秒，默认：5000） */
 HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetHandShakeTimeout(HP_UdpArqClient pClient, DWORD dwHandShakeTimeout);
+/* 设置 FEC 数据分片数量（默认：0，每组数据包数量，与校验分片数量均大于 0 时启用 FEC，通信双方必须一致） */
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFecDataShards(HP_UdpArqClient pClient, DWORD dwDataShards);
+/* 设置 FEC 校验分片数量（默认：0，每组校验包数量，分片总数不超过 64） */
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFecParityShards(HP_UdpArqClient pClient, DWORD dwParityShards);
 
 /* 检测是否开启 nodelay 模式 */
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_IsNoDelay(HP_UdpArqClient pClient);
@@ -1299,6 +1521,10 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetMaxTransUnit(HP_UdpArqClient pCl
 HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetMaxMessageSize(HP_UdpArqClient pClient);
 /* 获取握手超时时间 */
 HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetHandShakeTimeout(HP_UdpArqClient pClient);
+/* 获取 FEC 数据分片数量 */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFecDataShards(HP_UdpArqClient pClient);
+/* 获取 FEC 校验分片数量 */
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFecParityShards(HP_UdpArqClient pClient);
 
 /* 获取等待发送包数量 */
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_GetWaitingSendMessageCount(HP_UdpArqClient pClient, int* piCount);
@@ -1643,6 +1869,114 @@ HPSOCKET_API DWORD __HP_CALL HP_TcpPackClient_GetMaxPackSize(HP_TcpPackClient pC
 /* 获取包头标识 */
 HPSOCKET_API USHORT __HP_CALL HP_TcpPackClient_GetPackHeaderFlag(HP_TcpPackClient pClient);
 
+/***************************************************************************************/
+/***************************** TCP Framed Server 组件操作方法 *****************************/
+
+/***************************************************************************************/
+/***************************** TCP Framed Server 属性访问方法 *****************************/
+
+/* 设置帧头长度（帧头必须包含长度字段，有效取值范围 1 ~ 256，默认：4） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetFrameHeaderSize(HP_TcpFramedServer pServer, DWORD dwHeaderSize);
+/* 设置长度字段在帧头中的偏移量（默认：0） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthFieldOffset(HP_TcpFramedServer pServer, DWORD dwOffset);
+/* 设置长度字段字节数（有效取值：1 / 2 / 3 / 4，默认：4） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthFieldSize(HP_TcpFramedServer pServer, DWORD dwSize);
+/* 设置长度字段是否为大端字节序（默认：FALSE，小端字节序） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthFieldBigEndian(HP_TcpFramedServer pServer, BOOL bBigEndian);
+/* 设置长度字段值是否包含帧头长度（默认：FALSE） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthIncludeHeader(HP_TcpFramedServer pServer, BOOL bIncludeHeader);
+/* 设置长度修正值（帧总长度 = 长度字段值 + 修正值 [+ 帧头长度]，默认：0） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthAdjustment(HP_TcpFramedServer pServer, int iAdjustment);
+/* 设置帧最大长度（包含帧头，有效帧最大长度不能超过 268435455/0xFFFFFFF 字节，默认：262144/0x40000） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetMaxFrameSize(HP_TcpFramedServer pServer, DWORD dwMaxFrameSize);
+
+/* 获取帧头长度 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedServer_GetFrameHeaderSize(HP_TcpFramedServer pServer);
+/* 获取长度字段偏移量 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedServer_GetLengthFieldOffset(HP_TcpFramedServer pServer);
+/* 获取长度字段字节数 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedServer_GetLengthFieldSize(HP_TcpFramedServer pServer);
+/* 检测长度字段是否为大端字节序 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedServer_IsLengthFieldBigEndian(HP_TcpFramedServer pServer);
+/* 检测长度字段值是否包含帧头长度 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedServer_IsLengthIncludeHeader(HP_TcpFramedServer pServer);
+/* 获取长度修正值 */
+HPSOCKET_API int __HP_CALL HP_TcpFramedServer_GetLengthAdjustment(HP_TcpFramedServer pServer);
+/* 获取帧最大长度 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedServer_GetMaxFrameSize(HP_TcpFramedServer pServer);
+
+/***************************************************************************************/
+/***************************** TCP Framed Agent 组件操作方法 *****************************/
+
+/***************************************************************************************/
+/***************************** TCP Framed Agent 属性访问方法 *****************************/
+
+/* 设置帧头长度（帧头必须包含长度字段，有效取值范围 1 ~ 256，默认：4） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetFrameHeaderSize(HP_TcpFramedAgent pAgent, DWORD dwHeaderSize);
+/* 设置长度字段在帧头中的偏移量（默认：0） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthFieldOffset(HP_TcpFramedAgent pAgent, DWORD dwOffset);
+/* 设置长度字段字节数（有效取值：1 / 2 / 3 / 4，默认：4） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthFieldSize(HP_TcpFramedAgent pAgent, DWORD dwSize);
+/* 设置长度字段是否为大端字节序（默认：FALSE，小端字节序） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthFieldBigEndian(HP_TcpFramedAgent pAgent, BOOL bBigEndian);
+/* 设置长度字段值是否包含帧头长度（默认：FALSE） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthIncludeHeader(HP_TcpFramedAgent pAgent, BOOL bIncludeHeader);
+/* 设置长度修正值（帧总长度 = 长度字段值 + 修正值 [+ 帧头长度]，默认：0） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthAdjustment(HP_TcpFramedAgent pAgent, int iAdjustment);
+/* 设置帧最大长度（包含帧头，有效帧最大长度不能超过 268435455/0xFFFFFFF 字节，默认：262144/0x40000） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetMaxFrameSize(HP_TcpFramedAgent pAgent, DWORD dwMaxFrameSize);
+
+/* 获取帧头长度 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedAgent_GetFrameHeaderSize(HP_TcpFramedAgent pAgent);
+/* 获取长度字段偏移量 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedAgent_GetLengthFieldOffset(HP_TcpFramedAgent pAgent);
+/* 获取长度字段字节数 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedAgent_GetLengthFieldSize(HP_TcpFramedAgent pAgent);
+/* 检测长度字段是否为大端字节序 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedAgent_IsLengthFieldBigEndian(HP_TcpFramedAgent pAgent);
+/* 检测长度字段值是否包含帧头长度 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedAgent_IsLengthIncludeHeader(HP_TcpFramedAgent pAgent);
+/* 获取长度修正值 */
+HPSOCKET_API int __HP_CALL HP_TcpFramedAgent_GetLengthAdjustment(HP_TcpFramedAgent pAgent);
+/* 获取帧最大长度 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedAgent_GetMaxFrameSize(HP_TcpFramedAgent pAgent);
+
+/***************************************************************************************/
+/***************************** TCP Framed Client 组件操作方法 *****************************/
+
+/***************************************************************************************/
+/***************************** TCP Framed Client 属性访问方法 *****************************/
+
+/* 设置帧头长度（帧头必须包含长度字段，有效取值范围 1 ~ 256，默认：4） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetFrameHeaderSize(HP_TcpFramedClient pClient, DWORD dwHeaderSize);
+/* 设置长度字段在帧头中的偏移量（默认：0） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthFieldOffset(HP_TcpFramedClient pClient, DWORD dwOffset);
+/* 设置长度字段字节数（有效取值：1 / 2 / 3 / 4，默认：4） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthFieldSize(HP_TcpFramedClient pClient, DWORD dwSize);
+/* 设置长度字段是否为大端字节序（默认：FALSE，小端字节序） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthFieldBigEndian(HP_TcpFramedClient pClient, BOOL bBigEndian);
+/* 设置长度字段值是否包含帧头长度（默认：FALSE） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthIncludeHeader(HP_TcpFramedClient pClient, BOOL bIncludeHeader);
+/* 设置长度修正值（帧总长度 = 长度字段值 + 修正值 [+ 帧头长度]，默认：0） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthAdjustment(HP_TcpFramedClient pClient, int iAdjustment);
+/* 设置帧最大长度（包含帧头，有效帧最大长度不能超过 268435455/0xFFFFFFF 字节，默认：262144/0x40000） */
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetMaxFrameSize(HP_TcpFramedClient pClient, DWORD dwMaxFrameSize);
+
+/* 获取帧头长度 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedClient_GetFrameHeaderSize(HP_TcpFramedClient pClient);
+/* 获取长度字段偏移量 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedClient_GetLengthFieldOffset(HP_TcpFramedClient pClient);
+/* 获取长度字段字节数 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedClient_GetLengthFieldSize(HP_TcpFramedClient pClient);
+/* 检测长度字段是否为大端字节序 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedClient_IsLengthFieldBigEndian(HP_TcpFramedClient pClient);
+/* 检测长度字段值是否包含帧头长度 */
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedClient_IsLengthIncludeHeader(HP_TcpFramedClient pClient);
+/* 获取长度修正值 */
+HPSOCKET_API int __HP_CALL HP_TcpFramedClient_GetLengthAdjustment(HP_TcpFramedClient pClient);
+/* 获取帧最大长度 */
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedClient_GetMaxFrameSize(HP_TcpFramedClient pClient);
+
 /*****************************************************************************************************************************************************/
 /*************************************************************** Global Function Exports *************************************************************/
 /*****************************************************************************************************************************************************/
@@ -1838,6 +2172,7 @@ typedef HP_FN_Server_OnReceive				HP_FN_HttpServer_OnReceive;
 typedef HP_FN_Server_OnSend					HP_FN_HttpServer_OnSend;
 typedef HP_FN_Server_OnClose				HP_FN_HttpServer_OnClose;
 typedef HP_FN_Server_OnShutdown				HP_FN_HttpServer_OnShutdown;
+typedef HP_FN_Server_OnSendWatermark		HP_FN_HttpServer_OnSendWatermark;
 
 /* HTTP Agent 回调函数 */
 typedef HP_FN_Http_OnMessageBegin			HP_FN_HttpAgent_OnMessageBegin;
@@ -1946,6 +2281,7 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_HttpServer_OnReceive(HP_HttpServerListener
 HPSOCKET_API void __HP_CALL HP_Set_FN_HttpServer_OnSend(HP_HttpServerListener pListener				, HP_FN_HttpServer_OnSend fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_HttpServer_OnClose(HP_HttpServerListener pListener			, HP_FN_HttpServer_OnClose fn);
 HPSOCKET_API void __HP_CALL HP_Set_FN_HttpServer_OnShutdown(HP_HttpServerListener pListener			, HP_FN_HttpServer_OnShutdown fn);
+HPSOCKET_API void __HP_CALL HP_Set_FN_HttpServer_OnSendWatermark(HP_HttpServerListener pListener	, HP_FN_HttpServer_OnSendWatermark fn);
 
 /**********************************************************************************/
 /**************************** HTTP Agent 回调函数设置方法 **************************/
@@ -2019,7 +2355,7 @@ HPSOCKET_API BOOL __HP_CALL HP_HttpServer_SendResponse(HP_HttpServer pServer, HP
 
 /*
 * 名称：发送本地文件
-* 描述：向指定连接发送 4096 KB 以下的小文件
+* 描述：向指定连接发送本地文件（SP_DIRECT 发送策略的 HTTP 组件通过 TransmitFile() 流式发送，其它情形只能发送 4096 KB 以下的小文件）
 *		
 * 参数：		dwConnID		-- 连接 ID
 *			lpszFileName	-- 文件路径
@@ -2626,6 +2962,22 @@ HPSOCKET_API BOOL __HP_CALL HP_ThreadPool_Submit(HP_ThreadPool pThreadPool, HP_F
 */
 HPSOCKET_API BOOL __HP_CALL HP_ThreadPool_Submit_Task(HP_ThreadPool pThreadPool, HP_LPTSocketTask pTask, DWORD dwMaxWait /*= INFINITE*/);
 
+/*
+* 名称：串行提交 Socket 任务
+* 描述：向线程池提交异步 Socket 任务，同一发起对象（sender）同一 CONNID 的任务按提交顺序依次执行，其它任务并行执行
+*		连接的串行队列在其任务全部执行完毕后自动销毁，因此在 OnClose 中无需额外清理
+*		串行队列中尚未执行的任务计入任务队列大小，任务队列已满时按拒绝策略处理（TRP_CALLER_RUN 策略下，
+*		该连接没有待执行任务时由调用线程直接执行，否则为保证执行顺序等待任务队列空位）
+*		
+* 参数：		pTask		-- 任务参数
+*			dwMaxWait	-- 任务提交最大等待时间（仅对 TRP_WAIT_FOR 及需要等待的 TRP_CALLER_RUN 类型线程池生效，默认：INFINITE，一直等待）
+* 返回值：	TRUE	-- 成功
+*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取系统错误代码
+*							其中，错误码 ERROR_DESTINATION_ELEMENT_FULL 表示任务队列已满
+*							注意：如果提交失败，需要手工调用 Destroy_HP_SocketTaskObj() 销毁 TSocketTask 对象
+*/
+HPSOCKET_API BOOL __HP_CALL HP_ThreadPool_Submit_SerialTask(HP_ThreadPool pThreadPool, HP_LPTSocketTask pTask, DWORD dwMaxWait /*= INFINITE*/);
+
 /*
 * 名称：调整线程池大小
 * 描述：增加或减少线程池的工作线程数量
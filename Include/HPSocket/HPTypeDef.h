@@ -244,6 +244,30 @@ typedef struct TIPAddr
 	LPCTSTR		 address;
 } *LPTIPAddr, HP_TIPAddr, *HP_LPTIPAddr;
 
+/************************************************************************
+名称：私有堆尺寸等级使用统计
+描述：组件 Slab 私有堆某个尺寸等级的内存使用统计
+************************************************************************/
+typedef struct THeapClassStat
+{
+	SIZE_T slotSize;	// 槽位大小（含块头）
+	SIZE_T slabCount;	// Slab 数量
+	SIZE_T totalSlots;	// 已切分的槽位数量
+	SIZE_T usedSlots;	// 正在使用的槽位数量
+	SIZE_T cachedSlots;	// CPU 弹匣缓存的槽位数量
+} HP_THeapClassStat, *LPTHeapClassStat, *HP_LPTHeapClassStat;
+
+/************************************************************************
+名称：发送缓冲区释放函数
+描述：零拷贝发送的数据缓冲区不再被组件引用时，通过该函数把缓冲区归还给调用者
+参数：pBuffer	-- 数据缓冲区
+		iLength	-- 数据缓冲区长度
+		pvArg	-- 自定义参数
+返回值：（无）
+************************************************************************/
+typedef VOID (__HP_CALL *Fn_SendBufferRelease)(const BYTE* pBuffer, int iLength, PVOID pvArg);
+typedef Fn_SendBufferRelease	HP_Fn_SendBufferRelease;
+
 /************************************************************************
 名称：拒绝策略
 描述：调用被拒绝后的处理策略
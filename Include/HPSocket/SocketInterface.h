@@ -265,7 +265,7 @@ public:
 	virtual void SetOnSendSyncPolicy		(EnOnSendSyncPolicy enSyncPolicy)	= 0;
 	/* 设置最大连接数（组件会根据设置值预分配内存，因此需要根据实际情况设置，不宜过大）*/
 	virtual void SetMaxConnectionCount		(DWORD dwMaxConnectionCount)		= 0;
-	/* 设置 Socket 缓存对象锁定时间（毫秒，在锁定期间该 Socket 缓存对象不能被获取使用） */
+	/* 设置 Socket 缓存对象锁定时间（毫秒，在锁定期间该 Socket 缓存对象不能被获取使用；TCP 服务端组件的 Socket 缓存对象及各组件的数据缓冲区、ARQ 会话已改为按纪元回收，不受该设置影响，仅 TCP Agent 与 UDP 服务端组件的 Socket 缓存对象及 SSL 会话缓存池仍使用） */
 	virtual void SetFreeSocketObjLockTime	(DWORD dwFreeSocketObjLockTime)		= 0;
 	/* 设置 Socket 缓存池大小（通常设置为平均并发连接数的 1/3 - 1/2） */
 	virtual void SetFreeSocketObjPool		(DWORD dwFreeSocketObjPool)			= 0;
@@ -362,6 +362,127 @@ public:
 	*/
 	virtual BOOL SendSmallFile(CONNID dwConnID, LPCTSTR lpszFileName, const LPWSABUF pHead = nullptr, const LPWSABUF pTail = nullptr)	= 0;
 
+	/*
+	* 名称：零拷贝发送数据
+	* 描述：直接投递调用者的数据缓冲区（不复制），缓冲区不再被组件引用时调用 fnRelease 归还给调用者
+	*		仅 SP_DIRECT 发送策略以零拷贝方式发送，其它情形（SP_PACK / SP_SAFE 策略、PACK 及 SSL 组件等）退化为普通发送
+	*		无论调用成功与否，fnRelease 都会被调用且只调用一次，在此之前调用者不能修改或释放缓冲区
+	*		
+	* 参数：		dwConnID	-- 连接 ID
+	*			pBuffer		-- 发送缓冲区
+	*			iLength		-- 发送缓冲区长度
+	*			fnRelease	-- 缓冲区释放函数（可为 nullptr）
+	*			pvArg		-- 缓冲区释放函数的自定义参数
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL SendZeroCopy(CONNID dwConnID, const BYTE* pBuffer, int iLength, Fn_SendBufferRelease fnRelease, PVOID pvArg = nullptr)	= 0;
+
+	/*
+	* 名称：广播发送数据
+	* 描述：把同一份数据发送给多个连接，数据只复制一次，所有连接共享同一个引用计数缓冲区，
+	*		最后一个连接发送完成后释放（SSL 组件退化为逐个连接发送）
+	*		发送失败的连接将被关闭，其余连接照常发送
+	*		
+	* 参数：		pConnIDs	-- 连接 ID 数组
+	*			iConnCount	-- 连接 ID 数组长度
+	*			pBuffers	-- 发送缓冲区数组
+	*			iCount		-- 发送缓冲区数目
+	* 返回值：	TRUE	-- 全部连接成功
+	*			FALSE	-- 至少一个连接失败，可通过 SYS_GetLastError() 获取最后一个错误代码
+	*/
+	virtual BOOL SendToMany(const CONNID pConnIDs[], int iConnCount, const WSABUF pBuffers[], int iCount)	= 0;
+
+	/*
+	* 名称：创建连接分组
+	* 描述：创建一个空的连接分组，连接关闭时自动退出其所在的所有分组，组件停止时销毁所有分组
+	*		
+	* 返回值：	非 0		-- 成功，返回分组 ID
+	*			0		-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual DWORD CreateGroup()																		= 0;
+
+	/*
+	* 名称：销毁连接分组
+	* 描述：销毁分组并使其所有成员退出该分组（不影响成员连接本身）
+	*		
+	* 参数：		dwGroupID	-- 分组 ID
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL DestroyGroup(DWORD dwGroupID)														= 0;
+
+	/*
+	* 名称：加入连接分组
+	* 描述：把连接加入指定分组，一个连接可以同时加入多个分组，重复加入同一分组不产生重复成员
+	*		
+	* 参数：		dwGroupID	-- 分组 ID
+	*			dwConnID	-- 连接 ID
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL JoinGroup(DWORD dwGroupID, CONNID dwConnID)										= 0;
+
+	/*
+	* 名称：退出连接分组
+	* 描述：把连接从指定分组中移除
+	*		
+	* 参数：		dwGroupID	-- 分组 ID
+	*			dwConnID	-- 连接 ID
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL LeaveGroup(DWORD dwGroupID, CONNID dwConnID)										= 0;
+
+	/*
+	* 名称：向分组发送数据
+	* 描述：向分组的所有成员发送同一份数据（参考 SendToMany()），空分组直接返回成功
+	*		
+	* 参数：		dwGroupID	-- 分组 ID
+	*			pBuffers	-- 发送缓冲区数组
+	*			iCount		-- 发送缓冲区数目
+	* 返回值：	TRUE	-- 全部成员成功
+	*			FALSE	-- 分组不存在或至少一个成员失败，可通过 SYS_GetLastError() 获取最后一个错误代码
+	*/
+	virtual BOOL SendToGroup(DWORD dwGroupID, const WSABUF pBuffers[], int iCount)					= 0;
+
+	/*
+	* 名称：获取分组成员数量
+	*		
+	* 参数：		dwGroupID	-- 分组 ID
+	* 返回值：	分组成员数量（分组不存在时返回 0）
+	*/
+	virtual DWORD GetGroupMemberCount(DWORD dwGroupID)												= 0;
+
+	/*
+	* 名称：获取分组所有成员的连接 ID
+	*		
+	* 参数：		dwGroupID	-- 分组 ID
+	*			pIDs		-- 连接 ID 数组
+	*			dwCount		-- 数组长度（输入），实际成员数量（输出）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败（分组不存在、分组为空或数组长度不足）
+	*/
+	virtual BOOL GetGroupMemberIDs(DWORD dwGroupID, CONNID pIDs[], DWORD& dwCount)					= 0;
+
+	/*
+	* 名称：发送文件
+	* 描述：向指定连接流式发送文件（或文件的指定区间），不受小文件大小限制
+	*		各种发送策略下均通过 TransmitFile() 分段发送，文件数据不经过用户态内存，每段发送完成触发一次 OnSend 事件
+	*		（此时 OnSend 事件的 pData 参数为 nullptr，iLength 参数为该段发送的字节数）；发送文件期间向该连接发送的其它数据排在文件之后发送
+	*		PACK 及 SSL 组件需对数据封包或加密，仍读入内存后发送，此时文件区间大小不能超过 4096 KB
+	*		
+	* 参数：		dwConnID		-- 连接 ID
+	*			lpszFileName	-- 文件路径
+	*			ullOffset		-- 文件区间起始偏移量
+	*			ullLength		-- 文件区间长度（0 表示发送到文件末尾）
+	*			pHead			-- 头部附加数据
+	*			pTail			-- 尾部附加数据
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*/
+	virtual BOOL SendFile(CONNID dwConnID, LPCTSTR lpszFileName, ULONGLONG ullOffset = 0, ULONGLONG ullLength = 0, const LPWSABUF pHead = nullptr, const LPWSABUF pTail = nullptr)	= 0;
+
 #ifdef _SSL_SUPPORT
 	/*
 	* 名称：初始化通信组件 SSL 环境参数
@@ -475,6 +596,22 @@ public:
 	virtual void SetKeepAliveTime		(DWORD dwKeepAliveTime)			= 0;
 	/* 设置异常心跳包间隔（毫秒，0 不发送心跳包，，默认：20 * 1000，如果超过若干次 [默认：WinXP 5 次, Win7 10 次] 检测不到心跳确认包则认为已断线） */
 	virtual void SetKeepAliveInterval	(DWORD dwKeepAliveInterval)		= 0;
+	/* 设置是否启用零字节接收模式（启用后空闲连接不占用接收缓冲区，适用于大量空闲连接的场景，默认：FALSE） */
+	virtual void SetZeroByteReceive		(BOOL bZeroByteReceive)			= 0;
+	/* 设置是否启用连接亲和模式（启用后每个连接的 I/O、事件及所属线程内的发送操作固定由同一工作线程无锁处理，新连接由 0 号工作线程接受后转交所属工作线程触发 OnAccept 事件，默认：FALSE） */
+	virtual void SetWorkerAffinity		(BOOL bWorkerAffinity)			= 0;
+	/* 设置静默连接超时时间（毫秒，0 则不检测，默认：0，超时后自动断开连接，需启用 MarkSilence） */
+	virtual void SetSilenceTimeout		(DWORD dwSilenceTimeout)		= 0;
+	/* 设置连接最大存活时间（毫秒，0 则不检测，默认：0，超时后自动断开连接） */
+	virtual void SetMaxLifetime			(DWORD dwMaxLifetime)			= 0;
+	/* 设置发送高水位（字节，0 则不检测，默认：0，连接待发送数据超过高水位时触发 OnSendWatermark(bHigh = TRUE) 通知） */
+	virtual void SetSendHighWatermark	(DWORD dwSendHighWatermark)		= 0;
+	/* 设置发送低水位（字节，默认：0，超过高水位的连接待发送数据回落到低水位时触发 OnSendWatermark(bHigh = FALSE) 通知） */
+	virtual void SetSendLowWatermark	(DWORD dwSendLowWatermark)		= 0;
+	/* 设置内存块本地缓存高水位（每 CPU 本地缓存的空闲内存块超过该值时归还到内存块缓存池，0 则不使用本地缓存，默认：64） */
+	virtual void SetFreeBufferObjLocalHigh	(DWORD dwFreeBufferObjLocalHigh)	= 0;
+	/* 设置内存块本地缓存低水位（本地缓存每次归还或补充到该数量，必须低于高水位，默认：16） */
+	virtual void SetFreeBufferObjLocalLow	(DWORD dwFreeBufferObjLocalLow)		= 0;
 
 	/* 获取 Accept 预投递数量 */
 	virtual DWORD GetAcceptSocketCount	()	= 0;
@@ -486,6 +623,28 @@ public:
 	virtual DWORD GetKeepAliveTime		()	= 0;
 	/* 获取异常心跳包间隔 */
 	virtual DWORD GetKeepAliveInterval	()	= 0;
+	/* 检测是否启用零字节接收模式 */
+	virtual BOOL IsZeroByteReceive		()	= 0;
+	/* 检测是否启用连接亲和模式 */
+	virtual BOOL IsWorkerAffinity		()	= 0;
+	/* 获取静默连接超时时间 */
+	virtual DWORD GetSilenceTimeout		()	= 0;
+	/* 获取连接最大存活时间 */
+	virtual DWORD GetMaxLifetime		()	= 0;
+	/* 获取发送高水位 */
+	virtual DWORD GetSendHighWatermark	()	= 0;
+	/* 获取发送低水位 */
+	virtual DWORD GetSendLowWatermark	()	= 0;
+	/* 获取内存块本地缓存高水位 */
+	virtual DWORD GetFreeBufferObjLocalHigh	()	= 0;
+	/* 获取内存块本地缓存低水位 */
+	virtual DWORD GetFreeBufferObjLocalLow	()	= 0;
+	/* 获取内存块本地缓存命中及未命中次数（组件运行期间的累计值） */
+	virtual void GetFreeBufferObjLocalStat	(ULONGLONG& ullHits, ULONGLONG& ullMisses)	= 0;
+	/* 获取私有堆指定尺寸等级的使用统计（Socket 对象及内存块私有堆的合计，dwClass 超出尺寸等级数量或未使用 Slab 私有堆时返回 FALSE） */
+	virtual BOOL GetHeapClassStat			(DWORD dwClass, THeapClassStat& stat)		= 0;
+	/* 获取私有堆中超过 32 KB 的大块内存数量及字节数（Socket 对象及内存块私有堆的合计，未使用 Slab 私有堆时返回 FALSE） */
+	virtual BOOL GetHeapLargeStat			(SIZE_T& dwCount, SIZE_T& dwBytes)			= 0;
 	
 #ifdef _SSL_SUPPORT
 	/* 设置通信组件握手方式（默认：TRUE，自动握手） */
@@ -586,6 +745,12 @@ public:
 	virtual void SetMaxMessageSize		(DWORD dwMaxMessageSize)	= 0;
 	/* 设置握手超时时间（毫秒，默认：5000） */
 	virtual void SetHandShakeTimeout	(DWORD dwHandShakeTimeout)	= 0;
+	/* 设置是否启用 UDP 发送分段卸载（默认：FALSE，需 Windows 10 2004 及以上版本，系统不支持时自动回退为逐包发送） */
+	virtual void SetSegmentOffload		(BOOL bSegmentOffload)		= 0;
+	/* 设置 FEC 数据分片数量（默认：0，每组数据包数量，与校验分片数量均大于 0 时启用 FEC，通信双方必须一致） */
+	virtual void SetFecDataShards		(DWORD dwDataShards)		= 0;
+	/* 设置 FEC 校验分片数量（默认：0，每组校验包数量，分片总数不超过 64） */
+	virtual void SetFecParityShards		(DWORD dwParityShards)		= 0;
 
 	/* 检测是否开启 nodelay 模式 */
 	virtual BOOL IsNoDelay				()							= 0;
@@ -609,6 +774,18 @@ public:
 	virtual DWORD GetMaxMessageSize		()							= 0;
 	/* 获取握手超时时间 */
 	virtual DWORD GetHandShakeTimeout	()							= 0;
+	/* 检测是否启用 UDP 发送分段卸载 */
+	virtual BOOL IsSegmentOffload		()							= 0;
+	/* 获取 FEC 数据分片数量 */
+	virtual DWORD GetFecDataShards		()							= 0;
+	/* 获取 FEC 校验分片数量 */
+	virtual DWORD GetFecParityShards	()							= 0;
+	/* 获取 KCP 数据段缓存池命中次数（组件运行期间的累计值） */
+	virtual ULONGLONG GetSegmentPoolHitCount		()				= 0;
+	/* 获取 KCP 数据段缓存池未命中次数（组件运行期间的累计值） */
+	virtual ULONGLONG GetSegmentPoolMissCount		()				= 0;
+	/* 获取超过缓存尺寸而直接分配的 KCP 数据段数量（组件运行期间的累计值） */
+	virtual ULONGLONG GetSegmentPoolOversizeCount	()				= 0;
 
 	/* 获取等待发送包数量 */
 	virtual BOOL GetWaitingSendMessageCount	(CONNID dwConnID, int& iCount)	= 0;
@@ -761,6 +938,8 @@ public:
 	virtual void SetKeepAliveTime		(DWORD dwKeepAliveTime)			= 0;
 	/* 设置异常心跳包间隔（毫秒，0 不发送心跳包，，默认：20 * 1000，如果超过若干次 [默认：WinXP 5 次, Win7 10 次] 检测不到心跳确认包则认为已断线） */
 	virtual void SetKeepAliveInterval	(DWORD dwKeepAliveInterval)		= 0;
+	/* 设置是否启用零字节接收模式（启用后空闲连接不占用接收缓冲区，适用于大量空闲连接的场景，默认：FALSE） */
+	virtual void SetZeroByteReceive		(BOOL bZeroByteReceive)			= 0;
 
 	/* 获取通信数据缓冲区大小 */
 	virtual DWORD GetSocketBufferSize	()	= 0;
@@ -768,6 +947,8 @@ public:
 	virtual DWORD GetKeepAliveTime		()	= 0;
 	/* 获取异常心跳包间隔 */
 	virtual DWORD GetKeepAliveInterval	()	= 0;
+	/* 检测是否启用零字节接收模式 */
+	virtual BOOL IsZeroByteReceive		()	= 0;
 
 #ifdef _SSL_SUPPORT
 	/* 设置通信组件握手方式（默认：TRUE，自动握手） */
@@ -1317,6 +1498,10 @@ public:
 	virtual void SetMaxMessageSize		(DWORD dwMaxMessageSize)	= 0;
 	/* 设置握手超时时间（毫秒，默认：5000） */
 	virtual void SetHandShakeTimeout	(DWORD dwHandShakeTimeout)	= 0;
+	/* 设置 FEC 数据分片数量（默认：0，每组数据包数量，与校验分片数量均大于 0 时启用 FEC，通信双方必须一致） */
+	virtual void SetFecDataShards		(DWORD dwDataShards)		= 0;
+	/* 设置 FEC 校验分片数量（默认：0，每组校验包数量，分片总数不超过 64） */
+	virtual void SetFecParityShards		(DWORD dwParityShards)		= 0;
 
 	/* 检测是否开启 nodelay 模式 */
 	virtual BOOL IsNoDelay				()							= 0;
@@ -1340,6 +1525,10 @@ public:
 	virtual DWORD GetMaxMessageSize		()							= 0;
 	/* 获取握手超时时间 */
 	virtual DWORD GetHandShakeTimeout	()							= 0;
+	/* 获取 FEC 数据分片数量 */
+	virtual DWORD GetFecDataShards		()							= 0;
+	/* 获取 FEC 校验分片数量 */
+	virtual DWORD GetFecParityShards	()							= 0;
 
 	/* 获取等待发送包数量 */
 	virtual BOOL GetWaitingSendMessageCount	(int& iCount)			= 0;
@@ -1488,6 +1677,106 @@ typedef	DualInterface<IPackSocket, ITcpServer>	ITcpPackServer;
 typedef	DualInterface<IPackSocket, ITcpAgent>	ITcpPackAgent;
 typedef	DualInterface<IPackClient, ITcpClient>	ITcpPackClient;
 
+/************************************************************************
+名称：Server/Agent FRAMED 模型组件接口
+描述：定义 Server/Agent 组件的 FRAMED 模型组件的所有操作方法
+		FRAMED 模型按帧头中的长度字段拆分数据帧，每次 OnReceive() 通知一个包含帧头的完整数据帧，
+		发送时不附加任何帧头，由应用程序自行构造
+************************************************************************/
+class IFramedSocket
+{
+public:
+
+	/***********************************************************************/
+	/***************************** 属性访问方法 *****************************/
+
+	/* 设置帧头长度（帧头必须包含长度字段，有效取值范围 1 ~ 256，默认：4） */
+	virtual void SetFrameHeaderSize		(DWORD dwHeaderSize)			= 0;
+	/* 设置长度字段在帧头中的偏移量（默认：0） */
+	virtual void SetLengthFieldOffset	(DWORD dwOffset)				= 0;
+	/* 设置长度字段字节数（有效取值：1 / 2 / 3 / 4，默认：4） */
+	virtual void SetLengthFieldSize		(DWORD dwSize)					= 0;
+	/* 设置长度字段是否为大端字节序（默认：FALSE，小端字节序） */
+	virtual void SetLengthFieldBigEndian(BOOL bBigEndian)				= 0;
+	/* 设置长度字段值是否包含帧头长度（默认：FALSE） */
+	virtual void SetLengthIncludeHeader	(BOOL bIncludeHeader)			= 0;
+	/* 设置长度修正值（帧总长度 = 长度字段值 + 修正值 [+ 帧头长度]，默认：0） */
+	virtual void SetLengthAdjustment	(int iAdjustment)				= 0;
+	/* 设置帧最大长度（包含帧头，有效帧最大长度不能超过 268435455/0xFFFFFFF 字节，默认：262144/0x40000） */
+	virtual void SetMaxFrameSize		(DWORD dwMaxFrameSize)			= 0;
+
+	/* 获取帧头长度 */
+	virtual DWORD GetFrameHeaderSize	()								= 0;
+	/* 获取长度字段偏移量 */
+	virtual DWORD GetLengthFieldOffset	()								= 0;
+	/* 获取长度字段字节数 */
+	virtual DWORD GetLengthFieldSize	()								= 0;
+	/* 检测长度字段是否为大端字节序 */
+	virtual BOOL IsLengthFieldBigEndian	()								= 0;
+	/* 检测长度字段值是否包含帧头长度 */
+	virtual BOOL IsLengthIncludeHeader	()								= 0;
+	/* 获取长度修正值 */
+	virtual int GetLengthAdjustment		()								= 0;
+	/* 获取帧最大长度 */
+	virtual DWORD GetMaxFrameSize		()								= 0;
+
+public:
+	virtual ~IFramedSocket() {}
+};
+
+/************************************************************************
+名称：Client FRAMED 模型组件接口
+描述：定义 Client 组件的 FRAMED 模型组件的所有操作方法
+************************************************************************/
+class IFramedClient
+{
+public:
+
+	/***********************************************************************/
+	/***************************** 属性访问方法 *****************************/
+
+	/* 设置帧头长度（帧头必须包含长度字段，有效取值范围 1 ~ 256，默认：4） */
+	virtual void SetFrameHeaderSize		(DWORD dwHeaderSize)			= 0;
+	/* 设置长度字段在帧头中的偏移量（默认：0） */
+	virtual void SetLengthFieldOffset	(DWORD dwOffset)				= 0;
+	/* 设置长度字段字节数（有效取值：1 / 2 / 3 / 4，默认：4） */
+	virtual void SetLengthFieldSize		(DWORD dwSize)					= 0;
+	/* 设置长度字段是否为大端字节序（默认：FALSE，小端字节序） */
+	virtual void SetLengthFieldBigEndian(BOOL bBigEndian)				= 0;
+	/* 设置长度字段值是否包含帧头长度（默认：FALSE） */
+	virtual void SetLengthIncludeHeader	(BOOL bIncludeHeader)			= 0;
+	/* 设置长度修正值（帧总长度 = 长度字段值 + 修正值 [+ 帧头长度]，默认：0） */
+	virtual void SetLengthAdjustment	(int iAdjustment)				= 0;
+	/* 设置帧最大长度（包含帧头，有效帧最大长度不能超过 268435455/0xFFFFFFF 字节，默认：262144/0x40000） */
+	virtual void SetMaxFrameSize		(DWORD dwMaxFrameSize)			= 0;
+
+	/* 获取帧头长度 */
+	virtual DWORD GetFrameHeaderSize	()								= 0;
+	/* 获取长度字段偏移量 */
+	virtual DWORD GetLengthFieldOffset	()								= 0;
+	/* 获取长度字段字节数 */
+	virtual DWORD GetLengthFieldSize	()								= 0;
+	/* 检测长度字段是否为大端字节序 */
+	virtual BOOL IsLengthFieldBigEndian	()								= 0;
+	/* 检测长度字段值是否包含帧头长度 */
+	virtual BOOL IsLengthIncludeHeader	()								= 0;
+	/* 获取长度修正值 */
+	virtual int GetLengthAdjustment		()								= 0;
+	/* 获取帧最大长度 */
+	virtual DWORD GetMaxFrameSize		()								= 0;
+
+public:
+	virtual ~IFramedClient() {}
+};
+
+/************************************************************************
+名称：TCP FRAMED 模型组件接口
+描述：继承了 FRAMED 和 Socket 接口
+************************************************************************/
+typedef	DualInterface<IFramedSocket, ITcpServer>	ITcpFramedServer;
+typedef	DualInterface<IFramedSocket, ITcpAgent>		ITcpFramedAgent;
+typedef	DualInterface<IFramedClient, ITcpClient>	ITcpFramedClient;
+
 /************************************************************************
 名称：Socket 监听器基接口
 描述：定义组件监听器的公共方法
@@ -1619,6 +1908,20 @@ class ITcpServerListener : public IServerListenerT<ITcpServer>
 {
 public:
 
+	/*
+	* 名称：发送水位通知
+	* 描述：连接待发送数据（已缓存及正在发送）超过高水位或回落到低水位时，Socket 监听器将收到该通知，
+	*		应用程序可据此暂停或恢复向该连接发送数据，避免待发送数据无限堆积；
+	*		该通知由连接所属的工作线程异步触发（不在发送方法内部触发），同一连接的高、低水位通知交替触发且不会并发（默认实现忽略该通知）
+	*		
+	* 参数：		pSender		-- 事件源对象
+	*			dwConnID	-- 连接 ID
+	*			bHigh		-- TRUE：超过高水位，FALSE：回落到低水位
+	*			iPending	-- 当前待发送数据长度
+	* 返回值：	HR_OK / HR_IGNORE	-- 继续执行
+	*			HR_ERROR			-- 该通知不允许返回 HR_ERROR（调试模式下引发断言错误）
+	*/
+	virtual EnHandleResult OnSendWatermark(ITcpServer* pSender, CONNID dwConnID, BOOL bHigh, int iPending)	{return HR_IGNORE;}
 };
 
 /************************************************************************
@@ -1633,6 +1936,7 @@ public:
 	virtual EnHandleResult OnHandShake(ITcpServer* pSender, CONNID dwConnID)								{return HR_IGNORE;}
 	virtual EnHandleResult OnReceive(ITcpServer* pSender, CONNID dwConnID, int iLength)						{return HR_IGNORE;}
 	virtual EnHandleResult OnSend(ITcpServer* pSender, CONNID dwConnID, const BYTE* pData, int iLength)		{return HR_IGNORE;}
+	virtual EnHandleResult OnSendWatermark(ITcpServer* pSender, CONNID dwConnID, BOOL bHigh, int iPending)	{return HR_IGNORE;}
 	virtual EnHandleResult OnShutdown(ITcpServer* pSender)													{return HR_IGNORE;}
 };
 
@@ -2202,7 +2506,7 @@ public:
 
 	/*
 	* 名称：发送本地文件
-	* 描述：向指定连接发送 4096 KB 以下的小文件
+	* 描述：向指定连接发送本地文件（SP_DIRECT 发送策略的 HTTP 组件通过 TransmitFile() 流式发送，其它情形只能发送 4096 KB 以下的小文件）
 	*		
 	* 参数：		dwConnID		-- 连接 ID
 	*			lpszFileName	-- 文件路径
@@ -2732,6 +3036,7 @@ public:
 	virtual EnHandleResult OnReceive(ITcpServer* pSender, CONNID dwConnID, int iLength)									{return HR_IGNORE;}
 	virtual EnHandleResult OnReceive(ITcpServer* pSender, CONNID dwConnID, const BYTE* pData, int iLength)				{return HR_IGNORE;}
 	virtual EnHandleResult OnSend(ITcpServer* pSender, CONNID dwConnID, const BYTE* pData, int iLength)					{return HR_IGNORE;}
+	virtual EnHandleResult OnSendWatermark(ITcpServer* pSender, CONNID dwConnID, BOOL bHigh, int iPending)				{return HR_IGNORE;}
 	virtual EnHandleResult OnShutdown(ITcpServer* pSender)																{return HR_IGNORE;}
 
 	virtual EnHttpParseResult OnMessageBegin(IHttpServer* pSender, CONNID dwConnID)										{return HPR_OK;}
@@ -2892,6 +3197,23 @@ public:
 	*/
 	virtual BOOL Submit	(LPTSocketTask pTask, DWORD dwMaxWait = INFINITE)					= 0;
 
+	/*
+	* 名称：串行提交 Socket 任务
+	* 描述：向线程池提交异步 Socket 任务，同一发起对象（sender）同一 CONNID 的任务按提交顺序依次执行，其它任务并行执行
+	*		连接的串行队列在其任务全部执行完毕后自动销毁，因此在 OnClose 中无需额外清理
+	*		串行队列中尚未执行的任务计入任务队列大小，任务队列已满时按拒绝策略处理（TRP_CALLER_RUN 策略下，
+	*		该连接没有待执行任务时由调用线程直接执行，否则为保证执行顺序等待任务队列空位）
+	*		（提示：以 TBT_ATTACH 或 TBT_REFER 方式创建任务可避免拷贝数据包）
+	*		
+	* 参数：		pTask		-- 任务参数
+	*			dwMaxWait	-- 任务提交最大等待时间（仅对 TRP_WAIT_FOR 及需要等待的 TRP_CALLER_RUN 类型线程池生效，默认：INFINITE，一直等待）
+	* 返回值：	TRUE	-- 成功
+	*			FALSE	-- 失败，可通过 SYS_GetLastError() 获取错误代码
+	*							其中，错误码 ERROR_DESTINATION_ELEMENT_FULL 表示任务队列已满
+	*							注意：如果提交失败，需要手工调用 Destroy_HP_SocketTaskObj() 销毁 TSocketTask 对象
+	*/
+	virtual BOOL SubmitSerial(LPTSocketTask pTask, DWORD dwMaxWait = INFINITE)				= 0;
+
 	/*
 	* 名称：调整线程池大小
 	* 描述：增加或减少线程池的工作线程数量
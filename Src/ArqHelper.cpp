@@ -38,4 +38,395 @@ DWORD GenerateConversationID()
 	return dwConvID;
 }
 
+const DWORD CArqSegmentPool::DEFAULT_SEGMENT_POOL_HOLD	= 1024;
+
+CArqSegmentPool::CArqSegmentPool()
+: m_dwSegmentSize	(0)
+, m_dwShardHold		(0)
+, m_shShards		(TRUE)
+, m_lOversize		(0)
+{
+
+}
+
+CArqSegmentPool::~CArqSegmentPool()
+{
+	Clear();
+}
+
+void CArqSegmentPool::Prepare(DWORD dwMtu, DWORD dwPoolHold)
+{
+	ASSERT(dwMtu > KCP_HEADER_SIZE);
+
+	Clear();
+
+	m_dwSegmentSize	= (DWORD)sizeof(IKCPSEG) + dwMtu - KCP_HEADER_SIZE;
+	m_dwShardHold	= max(dwPoolHold / m_shShards.GetCount(), 1UL);
+}
+
+void CArqSegmentPool::Clear()
+{
+	for(DWORD i = 0, dwCount = m_shShards.GetCount(); i < dwCount; i++)
+	{
+		TShard& shard = m_shShards[i];
+
+		CSpinLock locallock(shard.cs);
+
+		while(shard.pFree != nullptr)
+		{
+			TFreeNode* pNode = shard.pFree;
+			shard.pFree		 = pNode->next;
+
+			m_hpSegment.Free(pNode);
+		}
+
+		shard.dwCount	= 0;
+		shard.ullHits	= 0;
+		shard.ullMisses	= 0;
+	}
+
+	m_lOversize = 0;
+}
+
+IKCPSEG* CArqSegmentPool::Alloc(int iSize)
+{
+	SIZE_T dwSize = sizeof(IKCPSEG) + iSize;
+
+	if(dwSize > m_dwSegmentSize)
+	{
+		::InterlockedIncrement64(&m_lOversize);
+		return (IKCPSEG*)m_hpSegment.Alloc(dwSize);
+	}
+
+	TShard* pShard = GetShard();
+
+	{
+		CSpinLock locallock(pShard->cs);
+
+		TFreeNode* pNode = pShard->pFree;
+
+		if(pNode != nullptr)
+		{
+			pShard->pFree = pNode->next;
+			--pShard->dwCount;
+			++pShard->ullHits;
+
+			return (IKCPSEG*)pNode;
+		}
+
+		++pShard->ullMisses;
+	}
+
+	return (IKCPSEG*)m_hpSegment.Alloc(m_dwSegmentSize);
+}
+
+void CArqSegmentPool::Free(IKCPSEG* pSegment)
+{
+	if(m_hpSegment.Size(pSegment) == m_dwSegmentSize)
+	{
+		TShard* pShard = GetShard();
+
+		CSpinLock locallock(pShard->cs);
+
+		if(pShard->dwCount < m_dwShardHold)
+		{
+			TFreeNode* pNode = (TFreeNode*)pSegment;
+			pNode->next		 = pShard->pFree;
+			pShard->pFree	 = pNode;
+
+			++pShard->dwCount;
+
+			return;
+		}
+	}
+
+	m_hpSegment.Free(pSegment);
+}
+
+ULONGLONG CArqSegmentPool::GetHitCount()
+{
+	ULONGLONG ullHits = 0;
+
+	for(DWORD i = 0, dwCount = m_shShards.GetCount(); i < dwCount; i++)
+		ullHits += m_shShards[i].ullHits;
+
+	return ullHits;
+}
+
+ULONGLONG CArqSegmentPool::GetMissCount()
+{
+	ULONGLONG ullMisses = 0;
+
+	for(DWORD i = 0, dwCount = m_shShards.GetCount(); i < dwCount; i++)
+		ullMisses += m_shShards[i].ullMisses;
+
+	return ullMisses;
+}
+
+CArqFec::CArqFec()
+: m_iShardSize		(0)
+, m_dwSendGroup		(0)
+, m_iSendCount		(0)
+, m_dwRecoverCount	(0)
+{
+	::ZeroMemory(m_rgRecv, sizeof(m_rgRecv));
+}
+
+BOOL CArqFec::Init(DWORD dwDataShards, DWORD dwParityShards, DWORD dwMtu)
+{
+	Reset();
+
+	if(!m_rs.Init((int)dwDataShards, (int)dwParityShards))
+		return FALSE;
+
+	m_iShardSize = (int)dwMtu - ARQ_FEC_HEADER_SIZE;
+
+	m_bfSend.Malloc(GetShardCount() * (ARQ_FEC_HEADER_SIZE + m_iShardSize));
+	m_bfRecv.Malloc(ARQ_FEC_RECV_GROUPS * GetShardCount() * m_iShardSize);
+
+	return TRUE;
+}
+
+void CArqFec::Reset()
+{
+	m_rs.Reset();
+	m_bfSend.Free();
+	m_bfRecv.Free();
+
+	m_iShardSize	 = 0;
+	m_dwSendGroup	 = 0;
+	m_iSendCount	 = 0;
+	m_dwRecoverCount = 0;
+
+	::ZeroMemory(m_rgRecv, sizeof(m_rgRecv));
+}
+
+void CArqFec::WriteHeader(BYTE* pHeader, DWORD dwGroupID, int iIndex, int iCount)
+{
+	*((DWORD*)(pHeader + 0)) = dwGroupID;
+	*((UINT8*)(pHeader + 4)) = (UINT8)iIndex;
+	*((UINT8*)(pHeader + 5)) = (UINT8)iCount;
+}
+
+int CArqFec::Encode(const BYTE* pData, int iLength, Fn_ShardProc fnOutput, PVOID pv)
+{
+	ASSERT(IsEnabled() && iLength > 0 && iLength + 2 <= m_iShardSize);
+
+	BYTE* pShard = GetSendShard(m_iSendCount);
+
+	WriteHeader(pShard, m_dwSendGroup, m_iSendCount, 0);
+	*((UINT16*)(pShard + ARQ_FEC_HEADER_SIZE)) = (UINT16)iLength;
+	memcpy(pShard + ARQ_FEC_OVERHEAD, pData, iLength);
+
+	m_iSendLength[m_iSendCount++] = iLength + 2;
+
+	int rs = fnOutput(pShard, ARQ_FEC_OVERHEAD + iLength, pv);
+
+	if(m_iSendCount == m_rs.GetDataShards())
+	{
+		int rs2 = Seal(fnOutput, pv);
+		if(rs == NO_ERROR) rs = rs2;
+	}
+
+	return rs;
+}
+
+int CArqFec::Seal(Fn_ShardProc fnOutput, PVOID pv)
+{
+	if(m_iSendCount == 0)
+		return NO_ERROR;
+
+	const int k	= m_rs.GetDataShards();
+	const int m	= m_rs.GetParityShards();
+	int iSize	= 0;
+
+	for(int j = 0; j < m_iSendCount; j++)
+		iSize = max(iSize, m_iSendLength[j]);
+
+	const BYTE* pData[ARQ_FEC_MAX_SHARDS];
+	BYTE* pParity[ARQ_FEC_MAX_SHARDS];
+
+	// 较短的数据分片以 0 补齐至本组最大长度
+	for(int j = 0; j < m_iSendCount; j++)
+	{
+		BYTE* pBody = GetSendShard(j) + ARQ_FEC_HEADER_SIZE;
+		::ZeroMemory(pBody + m_iSendLength[j], iSize - m_iSendLength[j]);
+
+		pData[j] = pBody;
+	}
+
+	for(int i = 0; i < m; i++)
+		pParity[i] = GetSendShard(k + i) + ARQ_FEC_HEADER_SIZE;
+
+	m_rs.Encode(pData, m_iSendCount, pParity, iSize);
+
+	int rs = NO_ERROR;
+
+	for(int i = 0; i < m; i++)
+	{
+		BYTE* pShard = GetSendShard(k + i);
+		WriteHeader(pShard, m_dwSendGroup, k + i, m_iSendCount);
+
+		int rs2 = fnOutput(pShard, ARQ_FEC_HEADER_SIZE + iSize, pv);
+		if(rs == NO_ERROR) rs = rs2;
+	}
+
+	++m_dwSendGroup;
+	m_iSendCount = 0;
+
+	return rs;
+}
+
+int CArqFec::Decode(const BYTE* pData, int iLength, Fn_ShardProc fnInput, PVOID pv)
+{
+	ASSERT(IsEnabled());
+
+	if(iLength < ARQ_FEC_OVERHEAD + KCP_HEADER_SIZE || iLength > ARQ_FEC_HEADER_SIZE + m_iShardSize)
+		return ERROR_INVALID_DATA;
+
+	const int k		= m_rs.GetDataShards();
+	DWORD dwGroupID	= *((DWORD*)(pData + 0));
+	int iIndex		= *((UINT8*)(pData + 4));
+	int iCount		= *((UINT8*)(pData + 5));
+	BOOL bData		= (iIndex < k);
+
+	const BYTE* pBody	= pData + ARQ_FEC_HEADER_SIZE;
+	int iBodyLength		= iLength - ARQ_FEC_HEADER_SIZE;
+
+	if(bData)
+	{
+		if(iCount != 0 || *((UINT16*)pBody) + 2 != iBodyLength)
+			return ERROR_INVALID_DATA;
+	}
+	else if(iIndex >= GetShardCount() || iCount == 0 || iCount > k)
+		return ERROR_INVALID_DATA;
+
+	int iSlot			= 0;
+	TRecvGroup* pGroup	= FindRecvGroup(dwGroupID, iSlot);
+
+	if(pGroup != nullptr && pGroup->present[iIndex])
+		return NO_ERROR;
+
+	int rs = NO_ERROR;
+
+	if(bData)
+		rs = fnInput(pBody + 2, iBodyLength - 2, pv);
+
+	if(pGroup == nullptr || pGroup->done)
+		return rs;
+
+	if(!bData)
+	{
+		if(pGroup->count == 0)
+		{
+			pGroup->count		 = iCount;
+			pGroup->parityLength = iBodyLength;
+		}
+		else if(pGroup->count != iCount || pGroup->parityLength != iBodyLength)
+			return rs;
+	}
+
+	memcpy(GetRecvShard(iSlot, iIndex), pBody, iBodyLength);
+
+	pGroup->present[iIndex]	= TRUE;
+	pGroup->length[iIndex]	= iBodyLength;
+
+	if(pGroup->count == 0)
+		return rs;
+
+	int iValid	= 0;
+	int iData	= 0;
+
+	for(int j = 0; j < pGroup->count; j++)
+	{
+		if(pGroup->present[j])
+			++iData;
+	}
+
+	for(int i = k; i < GetShardCount(); i++)
+	{
+		if(pGroup->present[i])
+			++iValid;
+	}
+
+	iValid += iData;
+
+	if(iData == pGroup->count)
+		pGroup->done = TRUE;
+	else if(iValid >= pGroup->count)
+	{
+		Recover(pGroup, iSlot, fnInput, pv);
+		pGroup->done = TRUE;
+	}
+
+	return rs;
+}
+
+CArqFec::TRecvGroup* CArqFec::FindRecvGroup(DWORD dwGroupID, int& iSlot)
+{
+	iSlot = (int)(dwGroupID % ARQ_FEC_RECV_GROUPS);
+	TRecvGroup* pGroup = &m_rgRecv[iSlot];
+
+	if(pGroup->used)
+	{
+		if(pGroup->id == dwGroupID)
+			return pGroup;
+
+		// 已被更新的组占用，过期分片不再参与恢复
+		if((int)(dwGroupID - pGroup->id) < 0)
+			return nullptr;
+	}
+
+	::ZeroMemory(pGroup, sizeof(TRecvGroup));
+
+	pGroup->id	 = dwGroupID;
+	pGroup->used = TRUE;
+
+	return pGroup;
+}
+
+void CArqFec::Recover(TRecvGroup* pGroup, int iSlot, Fn_ShardProc fnInput, PVOID pv)
+{
+	const int k	= m_rs.GetDataShards();
+	int iSize	= pGroup->parityLength;
+
+	BYTE* pShards[ARQ_FEC_MAX_SHARDS];
+	BOOL bPresent[ARQ_FEC_MAX_SHARDS];
+
+	for(int i = 0; i < GetShardCount(); i++)
+	{
+		BOOL bPadding = (i >= pGroup->count && i < k);
+
+		pShards[i]	= bPadding ? nullptr : GetRecvShard(iSlot, i);
+		bPresent[i]	= bPadding ? FALSE : pGroup->present[i];
+
+		if(i < k && bPresent[i])
+		{
+			if(pGroup->length[i] > iSize)
+				return;
+
+			::ZeroMemory(pShards[i] + pGroup->length[i], iSize - pGroup->length[i]);
+		}
+	}
+
+	if(!m_rs.Reconstruct(pShards, bPresent, pGroup->count, iSize))
+		return;
+
+	for(int j = 0; j < pGroup->count; j++)
+	{
+		if(pGroup->present[j])
+			continue;
+
+		const BYTE* pBody	= pShards[j];
+		int iLength			= *((UINT16*)pBody);
+
+		if(iLength >= KCP_HEADER_SIZE && iLength + 2 <= iSize)
+		{
+			// 恢复出的数据包交付失败不影响当前收到的数据包
+			fnInput(pBody + 2, iLength, pv);
+			++m_dwRecoverCount;
+		}
+	}
+}
+
 #endif
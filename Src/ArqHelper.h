@@ -31,6 +31,7 @@
 
 #include "Common/WaitFor.h"
 #include "Common/BufferPool.h"
+#include "Common/ReedSolomon.h"
 #include "Common/kcp/ikcp.h"
 
 #define DEFAULT_ARQ_NO_DELAY			FALSE
@@ -44,11 +45,20 @@
 #define DEFAULT_ARQ_MAX_TRANS_UNIT		DEFAULT_UDP_MAX_DATAGRAM_SIZE
 #define DEFAULT_ARQ_MAX_MSG_SIZE		DEFAULT_BUFFER_CACHE_CAPACITY
 #define DEFAULT_ARQ_HANND_SHAKE_TIMEOUT	5000
+#define DEFAULT_ARQ_SEGMENT_OFFLOAD		FALSE
+#define DEFAULT_ARQ_FEC_DATA_SHARDS		0
+#define DEFAULT_ARQ_FEC_PARITY_SHARDS	0
 
 #define KCP_HEADER_SIZE					24
 #define KCP_MIN_RECV_WND				128
 
 #define ARQ_MAX_HANDSHAKE_INTERVAL		2000
+#define ARQ_MAX_OFFLOAD_SEGMENTS		8
+
+#define ARQ_FEC_HEADER_SIZE				6
+#define ARQ_FEC_OVERHEAD				(ARQ_FEC_HEADER_SIZE + 2)
+#define ARQ_FEC_MAX_SHARDS				64
+#define ARQ_FEC_RECV_GROUPS				4
 
 typedef int (*Fn_ArqOutputProc)(const char* pBuffer, int iLength, IKCPCB* kcp, LPVOID pv);
 
@@ -142,6 +152,9 @@ struct TArqAttr
 	DWORD	dwFastLimit;
 	DWORD	dwMaxMessageSize;
 	DWORD	dwHandShakeTimeout;
+	BOOL	bSegmentOffload;
+	DWORD	dwFecDataShards;
+	DWORD	dwFecParityShards;
 
 public:
 	TArqAttr( BOOL no_delay				= DEFAULT_ARQ_NO_DELAY
@@ -155,6 +168,9 @@ public:
 			, DWORD fast_limit			= DEFAULT_ARQ_FAST_LIMIT
 			, DWORD max_msg_size		= DEFAULT_ARQ_MAX_MSG_SIZE
 			, DWORD hand_shake_timeout	= DEFAULT_ARQ_HANND_SHAKE_TIMEOUT
+			, BOOL segment_offload		= DEFAULT_ARQ_SEGMENT_OFFLOAD
+			, DWORD fec_data_shards		= DEFAULT_ARQ_FEC_DATA_SHARDS
+			, DWORD fec_parity_shards	= DEFAULT_ARQ_FEC_PARITY_SHARDS
 			)
 	: bNoDelay			(no_delay)
 	, bTurnoffNc		(turnoff_nc)
@@ -167,10 +183,16 @@ public:
 	, dwFastLimit		(fast_limit)
 	, dwMaxMessageSize	(max_msg_size)
 	, dwHandShakeTimeout(hand_shake_timeout)
+	, bSegmentOffload	(segment_offload)
+	, dwFecDataShards	(fec_data_shards)
+	, dwFecParityShards	(fec_parity_shards)
 	{
 		ASSERT(IsValid());
 	}
 
+	BOOL IsFecEnabled()		const	{return dwFecDataShards > 0 && dwFecParityShards > 0;}
+	DWORD GetFecOverhead()	const	{return IsFecEnabled() ? ARQ_FEC_OVERHEAD : 0;}
+
 	BOOL IsValid() const
 	{
 		return 	((int)dwResendByAcks >= 0)																				&&
@@ -181,11 +203,147 @@ public:
 				((int)dwFastLimit >= 0)																					&&
 				((int)dwHandShakeTimeout > 2 * (int)dwMinRto)															&&
 				((int)dwMtu >= 3 * KCP_HEADER_SIZE && dwMtu <= MAXIMUM_UDP_MAX_DATAGRAM_SIZE)							&&
-				((int)dwMaxMessageSize > 0 && dwMaxMessageSize < ((KCP_MIN_RECV_WND - 1) * (dwMtu - KCP_HEADER_SIZE)))	;
+				(dwFecDataShards <= ARQ_FEC_MAX_SHARDS && dwFecParityShards <= ARQ_FEC_MAX_SHARDS)						&&
+				(dwFecDataShards + dwFecParityShards <= ARQ_FEC_MAX_SHARDS)												&&
+				((int)dwMaxMessageSize > 0 && dwMaxMessageSize < ((KCP_MIN_RECV_WND - 1) * (dwMtu - KCP_HEADER_SIZE - GetFecOverhead())));
 	}
 
 };
 
+/************************************************************************
+名称：KCP 分段内存池
+描述：分段尺寸由协商的 MTU 决定，每个 CPU 分片缓存一定数量的空闲分段，
+	  分配 / 释放通常只访问当前 CPU 的分片；超出尺寸的分段直接从私有堆分配
+************************************************************************/
+class CArqSegmentPool
+{
+	struct TFreeNode
+	{
+		TFreeNode* next;
+	};
+
+	struct TShard
+	{
+		CSpinGuard	cs;
+		TFreeNode*	pFree;
+		DWORD		dwCount;
+		ULONGLONG	ullHits;
+		ULONGLONG	ullMisses;
+
+		char		pack[CACHE_LINE];
+	};
+
+public:
+	IKCPSEG* Alloc(int iSize);
+	void Free(IKCPSEG* pSegment);
+
+	void Prepare(DWORD dwMtu, DWORD dwPoolHold = DEFAULT_SEGMENT_POOL_HOLD);
+	void Clear();
+
+	static IKCPSEG* SegmentNewProc(IKCPCB* kcp, int iSize, LPVOID pv)		{return ((CArqSegmentPool*)pv)->Alloc(iSize);}
+	static void SegmentDeleteProc(IKCPCB* kcp, IKCPSEG* pSegment, LPVOID pv)	{((CArqSegmentPool*)pv)->Free(pSegment);}
+
+public:
+	DWORD GetSegmentSize()		const	{return m_dwSegmentSize;}
+	ULONGLONG GetOversizeCount()	const	{return (ULONGLONG)m_lOversize;}
+
+	ULONGLONG GetHitCount();
+	ULONGLONG GetMissCount();
+
+private:
+	TShard* GetShard() {return &m_shShards.Current();}
+
+public:
+	CArqSegmentPool();
+	~CArqSegmentPool();
+
+	DECLARE_NO_COPY_CLASS(CArqSegmentPool)
+
+public:
+	static const DWORD DEFAULT_SEGMENT_POOL_HOLD;
+
+private:
+	CPrivateHeap	m_hpSegment;
+
+	DWORD			m_dwSegmentSize;
+	DWORD			m_dwShardHold;
+
+	CCpuShards<TShard>	m_shShards;
+
+	volatile LONGLONG m_lOversize;
+};
+
+/************************************************************************
+名称：ARQ 前向纠错
+描述：位于 UDP 与 KCP 之间，每 DataShards 个 KCP 数据包为一组，
+	  以 Reed-Solomon 编码附加 ParityShards 个校验包；接收端在同组
+	  丢包数不超过 ParityShards 时直接恢复，无需等待 KCP 重传。
+	  数据包立即发送和交付，不足一组时由周期刷新提前封组。
+	  通信双方的分片数量配置必须一致。
+
+	  数据包：| 组号(4) | 序号(1) | 0(1) | 长度(2) | KCP 数据 |
+	  校验包：| 组号(4) | 序号(1) | 本组数据包数量(1) | 校验数据 |
+************************************************************************/
+class CArqFec
+{
+public:
+	/* 分片处理回调：发送端用于输出 UDP 数据包，接收端用于向 KCP 交付数据包 */
+	typedef int (*Fn_ShardProc)(const BYTE* pBuffer, int iLength, PVOID pv);
+
+private:
+	struct TRecvGroup
+	{
+		DWORD	id;
+		BOOL	used;
+		BOOL	done;
+		int		count;
+		int		parityLength;
+		BOOL	present[ARQ_FEC_MAX_SHARDS];
+		int		length[ARQ_FEC_MAX_SHARDS];
+	};
+
+public:
+	BOOL Init(DWORD dwDataShards, DWORD dwParityShards, DWORD dwMtu);
+	void Reset();
+
+	int Encode(const BYTE* pData, int iLength, Fn_ShardProc fnOutput, PVOID pv);
+	int Seal(Fn_ShardProc fnOutput, PVOID pv);
+	int Decode(const BYTE* pData, int iLength, Fn_ShardProc fnInput, PVOID pv);
+
+	BOOL IsEnabled()		const	{return m_rs.IsValid();}
+	BOOL HasPending()		const	{return m_iSendCount > 0;}
+	DWORD GetRecoverCount()	const	{return m_dwRecoverCount;}
+
+private:
+	TRecvGroup* FindRecvGroup(DWORD dwGroupID, int& iSlot);
+	void Recover(TRecvGroup* pGroup, int iSlot, Fn_ShardProc fnInput, PVOID pv);
+
+	BYTE* GetSendShard(int iIndex)				{return m_bfSend.Ptr() + iIndex * (ARQ_FEC_HEADER_SIZE + m_iShardSize);}
+	BYTE* GetRecvShard(int iSlot, int iIndex)	{return m_bfRecv.Ptr() + (iSlot * GetShardCount() + iIndex) * m_iShardSize;}
+
+	int GetShardCount() const {return m_rs.GetDataShards() + m_rs.GetParityShards();}
+
+	static void WriteHeader(BYTE* pHeader, DWORD dwGroupID, int iIndex, int iCount);
+
+public:
+	CArqFec();
+
+	DECLARE_NO_COPY_CLASS(CArqFec)
+
+private:
+	CReedSolomon	m_rs;
+	int				m_iShardSize;
+
+	DWORD			m_dwSendGroup;
+	int				m_iSendCount;
+	int				m_iSendLength[ARQ_FEC_MAX_SHARDS];
+	CBufferPtr		m_bfSend;
+
+	TRecvGroup		m_rgRecv[ARQ_FEC_RECV_GROUPS];
+	CBufferPtr		m_bfRecv;
+	DWORD			m_dwRecoverCount;
+};
+
 template<class T, class S> class CArqSessionT
 {
 public:
@@ -307,9 +465,22 @@ public:
 				}
 
 				if(bForce)
+				{
+					// 空闲会话不会被周期性 ikcp_update()，强制刷新前先校正 KCP 当前时间
+					m_kcp->current = ::TimeGetTime();
 					::ikcp_flush(m_kcp);
+				}
 				else
+				{
 					::ikcp_update(m_kcp, ::TimeGetTime());
+
+					// 周期刷新时封闭未满的 FEC 组，校验包最多延迟一个刷新间隔
+					if(m_fec.HasPending())
+						m_fec.Seal(FecOutputProc, this);
+				}
+
+				if(m_bSegmentOffload)
+					CommitOffload();
 			}
 		}
 
@@ -334,11 +505,41 @@ public:
 		}
 
 		if(rs == NO_ERROR)
+		{
 			Flush(TRUE);
+			ActiveExtra();
+		}
 
 		return rs;
 	}
 
+	/* 返回距下一次需要检查会话的时间（毫秒），0 表示会话空闲（无待发送、待确认数据），在下一次收发前无需检查 */
+	DWORD GetNextCheckDelay(DWORD dwDefault)
+	{
+		if(!IsValid())
+			return 0;
+
+		CCriSecTryLock locallock(m_cs);
+
+		if(!locallock.IsValid())
+			return dwDefault;
+
+		if(!IsValid())
+			return 0;
+
+		if(!IsReady() || !m_bHSComplete)
+			return dwDefault;
+
+		if(	m_kcp->nsnd_que == 0 && m_kcp->nsnd_buf == 0 && m_kcp->ackcount == 0 &&
+			m_kcp->probe	== 0 && m_kcp->rmt_wnd	!= 0 && !m_fec.HasPending()		)
+			return 0;
+
+		DWORD dwCurrent	= ::TimeGetTime();
+		DWORD dwDelay	= ::ikcp_check(m_kcp, dwCurrent) - dwCurrent;
+
+		return max(dwDelay, 1UL);
+	}
+
 	int GetWaitingSend()
 	{
 		if(!IsValid())
@@ -468,7 +669,11 @@ public:
 				return HR_ERROR;
 			}
 
-			int rs = ::ikcp_input(m_kcp, (const char*)pData, iLength);
+			m_kcp->current = ::TimeGetTime();
+
+			int rs = m_fec.IsEnabled()
+						? m_fec.Decode(pData, iLength, FecInputProc, this)
+						: ::ikcp_input(m_kcp, (const char*)pData, iLength);
 
 			if(rs != NO_ERROR)
 			{
@@ -498,6 +703,7 @@ public:
 		}
 
 		Flush(TRUE);
+		ActiveExtra();
 
 		return HR_OK;
 	}
@@ -514,11 +720,91 @@ private:
 
 		::ikcp_nodelay(m_kcp, attr.bNoDelay ? 1 : 0, (int)attr.dwFlushInterval, (int)attr.dwResendByAcks, attr.bTurnoffNc ? 1 : 0);
 		::ikcp_wndsize(m_kcp, (int)attr.dwSendWndSize, (int)attr.dwRecvWndSize);
-		::ikcp_setmtu(m_kcp, attr.dwMtu);
+		::ikcp_setmtu(m_kcp, attr.dwMtu - attr.GetFecOverhead());
 
 		m_kcp->rx_minrto	= (int)attr.dwMinRto;
 		m_kcp->fastlimit	= (int)attr.dwFastLimit;
 		m_kcp->output		= m_pContext->GetArqOutputProc();
+
+		CArqSegmentPool* pSegmentPool = m_pContext->GetArqSegmentPool();
+
+		if(pSegmentPool != nullptr)
+			::ikcp_segment_allocator(m_kcp, CArqSegmentPool::SegmentNewProc, CArqSegmentPool::SegmentDeleteProc, pSegmentPool);
+
+		m_bSegmentOffload	= attr.bSegmentOffload;
+
+		if(m_bSegmentOffload)
+		{
+			m_iOffloadLimit	= (int)(attr.dwMtu * ARQ_MAX_OFFLOAD_SEGMENTS);
+			m_kcp->output	= OffloadOutputProc;
+			m_kcp->user		= this;
+
+			m_bfOffload.Malloc(m_iOffloadLimit);
+			m_bfOffload.SetSize(0);
+		}
+
+		if(attr.IsFecEnabled())
+		{
+			ENSURE(m_fec.Init(attr.dwFecDataShards, attr.dwFecParityShards, attr.dwMtu));
+
+			m_kcp->output	= FecKcpOutputProc;
+			m_kcp->user		= this;
+		}
+	}
+
+	static int FecKcpOutputProc(const char* pBuffer, int iLength, IKCPCB* kcp, LPVOID pv)
+	{
+		CArqSessionT* pSession = (CArqSessionT*)pv;
+		return pSession->m_fec.Encode((const BYTE*)pBuffer, iLength, FecOutputProc, pSession);
+	}
+
+	static int FecOutputProc(const BYTE* pBuffer, int iLength, PVOID pv)
+	{
+		CArqSessionT* pSession = (CArqSessionT*)pv;
+
+		if(pSession->m_bSegmentOffload)
+			return pSession->OffloadOutput((const char*)pBuffer, iLength);
+
+		return pSession->m_pContext->GetArqOutputProc()((const char*)pBuffer, iLength, pSession->m_kcp, pSession->m_pSocket);
+	}
+
+	static int FecInputProc(const BYTE* pBuffer, int iLength, PVOID pv)
+	{
+		return ::ikcp_input(((CArqSessionT*)pv)->m_kcp, (const char*)pBuffer, iLength);
+	}
+
+	static int OffloadOutputProc(const char* pBuffer, int iLength, IKCPCB* kcp, LPVOID pv)
+	{
+		return ((CArqSessionT*)pv)->OffloadOutput(pBuffer, iLength);
+	}
+
+	int OffloadOutput(const char* pBuffer, int iLength)
+	{
+		int rs = NO_ERROR;
+
+		if((int)m_bfOffload.Size() + iLength > m_iOffloadLimit)
+			rs = CommitOffload();
+
+		m_bfOffload.Cat((const BYTE*)pBuffer, iLength);
+
+		// 分段卸载要求除最后一个分段外其余分段长度均为 MTU
+		if(iLength < m_iOffloadLimit / ARQ_MAX_OFFLOAD_SEGMENTS)
+			rs = CommitOffload();
+
+		return rs;
+	}
+
+	int CommitOffload()
+	{
+		int iLength = (int)m_bfOffload.Size();
+
+		if(iLength == 0)
+			return NO_ERROR;
+
+		int rs = m_pContext->GetArqOutputProc()((const char*)m_bfOffload.Ptr(), iLength, m_kcp, m_pSocket);
+		m_bfOffload.SetSize(0);
+
+		return rs;
 	}
 
 	void DoReset()
@@ -528,6 +814,8 @@ private:
 			::ikcp_release(m_kcp);
 			m_kcp = nullptr;
 		}
+
+		m_fec.Reset();
 	}
 
 public:
@@ -545,6 +833,7 @@ public:
 protected:
 	virtual void RenewExtra(const TArqAttr& attr) {}
 	virtual void ResetExtra() {}
+	virtual void ActiveExtra() {}
 
 public:
 	CArqSessionT()
@@ -558,6 +847,8 @@ public:
 	, m_dwHSNextTime(0)
 	, m_dwHSSndCount(0)
 	, m_bHSComplete	(FALSE)
+	, m_bSegmentOffload(FALSE)
+	, m_iOffloadLimit(0)
 	{
 
 	}
@@ -586,44 +877,66 @@ private:
 	DWORD	m_dwPeerConvID;
 	EnArqHandShakeStatus m_enStatus;
 
+	BOOL		m_bSegmentOffload;
+	int			m_iOffloadLimit;
+	CBufferPtr	m_bfOffload;
+
+	CArqFec	m_fec;
+
 	CCriSec m_cs;
 	IKCPCB* m_kcp;
 };
 
+template<class T, class S> class CArqSessionPoolT;
+
 template<class T, class S> class CArqSessionExT : public CArqSessionT<T, S>
 {
+	friend class CArqSessionPoolT<T, S>;
+
 public:
 	DWORD GetFreeTime	()	const	{return m_dwFreeTime;}
-	HANDLE GetTimer		()	const	{return m_hTimer;}
+
+	static BOOL IsReclaimable(CArqSessionExT* pSession) {return TRUE;}
 
 protected:
 	virtual void RenewExtra(const TArqAttr& attr)
 	{
-		m_hTimer = m_tqFlush.CreateTimer(FlushProc, this, attr.dwFlushInterval);
+		m_dwFlushInterval = attr.dwFlushInterval;
+		m_twFlush.Schedule(&m_tnFlush, m_dwFlushInterval);
 	}
 
 	virtual void ResetExtra()
 	{
-		m_tqFlush.DeleteTimer(m_hTimer);
+		m_twFlush.Cancel(&m_tnFlush);
 
 		m_dwFreeTime = ::TimeGetTime();
-		m_hTimer	 = nullptr;
+	}
+
+	virtual void ActiveExtra()
+	{
+		if(!m_tnFlush.IsPending())
+			m_twFlush.Schedule(&m_tnFlush, m_dwFlushInterval);
 	}
 
 private:
-	static void WINAPI FlushProc(LPVOID pv, BOOLEAN bTimerFired)
+	void OnFlushTimer()
 	{
-		CArqSessionExT* pSession = (CArqSessionExT*)pv;
+		DWORD dwDelay = m_dwFlushInterval;
+
+		if(this->Check())
+			dwDelay = this->GetNextCheckDelay(m_dwFlushInterval);
+		else if(this->IsValid() && TUdpSocketObj::IsValid(this->m_pSocket))
+			this->m_pContext->Disconnect(this->m_pSocket->connID);
 
-		if(!pSession->Check() && pSession->IsValid() && TUdpSocketObj::IsValid(pSession->m_pSocket))
-			pSession->m_pContext->Disconnect(pSession->m_pSocket->connID);
+		if(dwDelay != 0 && this->IsValid())
+			m_twFlush.Schedule(&m_tnFlush, dwDelay);
 	}
 
 public:
-	CArqSessionExT(CTimerQueue& tqFlush)
-	: m_tqFlush		(tqFlush)
-	, m_hTimer		(nullptr)
-	, m_dwFreeTime	(0)
+	CArqSessionExT(CTimingWheel& twFlush)
+	: m_twFlush			(twFlush)
+	, m_dwFlushInterval	(DEFAULT_ARQ_FLUSH_INTERVAL)
+	, m_dwFreeTime		(0)
 	{
 
 	}
@@ -631,18 +944,21 @@ public:
 	virtual ~CArqSessionExT()
 	{
 		Reset();
+
+		m_twFlush.Cancel(&m_tnFlush);
 	}
 
-	static CArqSessionExT* Construct(CTimerQueue& tqFlush)
-		{return new CArqSessionExT(tqFlush);}
+	static CArqSessionExT* Construct(CTimingWheel& twFlush)
+		{return new CArqSessionExT(twFlush);}
 
 	static void Destruct(CArqSessionExT* pSession)
 		{if(pSession) delete pSession;}
 
 private:
-	CTimerQueue& m_tqFlush;
+	CTimingWheel&	m_twFlush;
+	TTimerNode		m_tnFlush;
 
-	HANDLE	m_hTimer;
+	DWORD	m_dwFlushInterval;
 	DWORD	m_dwFreeTime;
 };
 
@@ -650,26 +966,14 @@ template<class T, class S> class CArqSessionPoolT
 {
 	typedef CArqSessionExT<T, S>		CArqSessionEx;
 	typedef CRingPool<CArqSessionEx>	TArqSessionList;
-	typedef CCASQueue<CArqSessionEx>	TArqSessionQueue;
+	typedef CEpochGCT<CArqSessionEx>	TArqSessionGC;
 
 public:
 	CArqSessionEx* PickFreeSession(T* pContext, S* pSocket, const TArqAttr& attr)
 	{
-		DWORD dwIndex;
 		CArqSessionEx* pSession = nullptr;
 
-		if(m_lsFreeSession.TryLock(&pSession, dwIndex))
-		{
-			if(::GetTimeGap32(pSession->GetFreeTime()) >= m_dwSessionLockTime)
-				ENSURE(m_lsFreeSession.ReleaseLock(nullptr, dwIndex));
-			else
-			{
-				ENSURE(m_lsFreeSession.ReleaseLock(pSession, dwIndex));
-				pSession = nullptr;
-			}
-		}
-
-		if(!pSession) pSession = CArqSessionEx::Construct(m_tqFlush);
+		if(!m_lsFreeSession.TryGet(&pSession)) pSession = CArqSessionEx::Construct(m_twFlush);
 
 		ASSERT(pSession);
 		return (CArqSessionEx*)pSession->Renew(pContext, pSocket, attr);
@@ -679,32 +983,65 @@ public:
 	{
 		if(pSession->Reset())
 		{
+			m_gcSession.Retire(pSession);
 			ReleaseGCSession();
-
-			if(!m_lsFreeSession.TryPut(pSession))
-				m_lsGCSession.PushBack(pSession);
 		}
 	}
 
-	void Prepare()
+	void Prepare(DWORD dwFlushTick)
 	{
 		m_lsFreeSession.Reset(m_dwSessionPoolSize);
+
+		m_twFlush.Reset(dwFlushTick);
+		m_tqFlush.CreateTimer(FlushTimerProc, this, dwFlushTick);
 	}
 
 	void Clear()
 	{
 		m_tqFlush.Reset();
+		m_twFlush.Reset();
 
 		m_lsFreeSession.Clear();
 
 		ReleaseGCSession(TRUE);
-		ENSURE(m_lsGCSession.IsEmpty());
+		ENSURE(m_gcSession.IsEmpty());
 	}
 
 private:
 	void ReleaseGCSession(BOOL bForce = FALSE)
 	{
-		::ReleaseGCObj(m_lsGCSession, m_dwSessionLockTime, bForce);
+		m_gcSession.Reclaim(m_lsFreeSession, bForce);
+	}
+
+	/* 所有会话共用一个时间轮，每个刻度只处理到期的会话；到期会话在时间轮锁外检查，检查后按 ikcp_check() 重新挂载 */
+	void FlushDueSessions()
+	{
+		CCriSecTryLock locallock(m_csFlush);
+
+		if(!locallock.IsValid())
+			return;
+
+		CEpochLock epochlock(GetEpoch());
+
+		m_twFlush.Advance(CollectDueSession, this);
+
+		for(size_t i = 0; i < m_vtDueSessions.size(); i++)
+			m_vtDueSessions[i]->OnFlushTimer();
+
+		m_vtDueSessions.clear();
+	}
+
+	static DWORD CollectDueSession(TTimerNode* pNode, PVOID pv)
+	{
+		CArqSessionPoolT* pPool = (CArqSessionPoolT*)pv;
+		pPool->m_vtDueSessions.push_back(CONTAINING_RECORD(pNode, CArqSessionEx, m_tnFlush));
+
+		return 0;
+	}
+
+	static void WINAPI FlushTimerProc(LPVOID pv, BOOLEAN bTimerFired)
+	{
+		((CArqSessionPoolT*)pv)->FlushDueSessions();
 	}
 
 public:
@@ -716,6 +1053,8 @@ public:
 	DWORD GetSessionPoolSize()	{return m_dwSessionPoolSize;}
 	DWORD GetSessionPoolHold()	{return m_dwSessionPoolHold;}
 
+	CEpoch& GetEpoch()			{return m_gcSession.GetEpoch();}
+
 public:
 	CArqSessionPoolT(
 					DWORD dwPoolSize = DEFAULT_SESSION_POOL_SIZE,
@@ -739,13 +1078,17 @@ public:
 
 private:
 	CTimerQueue			m_tqFlush;
+	CTimingWheel		m_twFlush;
+	CCriSec				m_csFlush;
+
+	vector<CArqSessionEx*>	m_vtDueSessions;
 
-	DWORD				m_dwSessionLockTime;
+	DWORD				m_dwSessionLockTime;	// 已改为按纪元回收，仅为兼容保留
 	DWORD				m_dwSessionPoolSize;
 	DWORD				m_dwSessionPoolHold;
 
 	TArqSessionList		m_lsFreeSession;
-	TArqSessionQueue	m_lsGCSession;
+	TArqSessionGC		m_gcSession;
 };
 
 template<class T, class S> const DWORD CArqSessionPoolT<T, S>::DEFAULT_SESSION_LOCK_TIME	= DEFAULT_OBJECT_CACHE_LOCK_TIME;
@@ -243,16 +243,14 @@ void CBufferPool::PutFreeBuffer(TBuffer* pBuffer)
 	{
 		m_itPool.PutFreeItem(pBuffer->items);
 
+		m_gcBuffer.Retire(pBuffer);
 		ReleaseGCBuffer();
-
-		if(!m_lsFreeBuffer.TryPut(pBuffer))
-			m_lsGCBuffer.PushBack(pBuffer);
 	}
 }
 
 void CBufferPool::ReleaseGCBuffer(BOOL bForce)
 {
-	::ReleaseGCObj(m_lsGCBuffer, m_dwBufferLockTime, bForce);
+	m_gcBuffer.Reclaim(m_lsFreeBuffer, bForce);
 }
 
 TBuffer* CBufferPool::PutCacheBuffer(ULONG_PTR dwID)
@@ -269,21 +267,9 @@ TBuffer* CBufferPool::PickFreeBuffer(ULONG_PTR dwID)
 {
 	ASSERT( dwID != 0);
 
-	DWORD dwIndex;
 	TBuffer* pBuffer = nullptr;
 
-	if(m_lsFreeBuffer.TryLock(&pBuffer, dwIndex))
-	{
-		if(::GetTimeGap32(pBuffer->freeTime) >= m_dwBufferLockTime)
-			ENSURE(m_lsFreeBuffer.ReleaseLock(nullptr, dwIndex));
-		else
-		{
-			ENSURE(m_lsFreeBuffer.ReleaseLock(pBuffer, dwIndex));
-			pBuffer = nullptr;
-		}
-	}
-
-	if(pBuffer)	pBuffer->id	= dwID;
+	if(m_lsFreeBuffer.TryGet(&pBuffer))	pBuffer->id	= dwID;
 	else		pBuffer		= TBuffer::Construct(*this, dwID);
 
 	ASSERT(pBuffer);
@@ -326,7 +312,7 @@ void CBufferPool::Clear()
 	m_lsFreeBuffer.Clear();
 
 	ReleaseGCBuffer(TRUE);
-	ENSURE(m_lsGCBuffer.IsEmpty());
+	ENSURE(m_gcBuffer.IsEmpty());
 
 	m_itPool.Clear();
 	m_heap.Reset();
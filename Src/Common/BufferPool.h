@@ -35,6 +35,7 @@ Desc:
 #include "STLHelper.h"
 #include "RingBuffer.h"
 #include "PrivateHeap.h"
+#include "Epoch.h"
 
 #pragma warning(push)
 #pragma warning(disable: 4458)
@@ -260,13 +261,66 @@ private:
 
 template<class T> class CNodePoolT
 {
+	/* 每 CPU 本地空闲链表，批量从全局缓存池补充或归还 */
+	struct TLocalList
+	{
+		CSpinGuard	cs;
+		T*			pHead;
+		DWORD		count;
+		ULONGLONG	hits;
+		ULONGLONG	misses;
+
+		BYTE		padding[64];
+	};
+
 public:
 	void PutFreeItem(T* pItem)
 	{
 		ASSERT(pItem != nullptr);
 
-		if(!m_lsFreeItem.TryPut(pItem))
-			T::Destruct(pItem);
+		TLocalList* pList = GetLocalList();
+
+		if(pList == nullptr)
+		{
+			if(!m_lsFreeItem.TryPut(pItem))
+				T::Destruct(pItem);
+
+			return;
+		}
+
+		T* pOverflow = nullptr;
+
+		{
+			CSpinLock locallock(pList->cs);
+
+			pItem->next	 = pList->pHead;
+			pList->pHead = pItem;
+
+			// 超过高水位时归还到低水位，全局缓存池已满的内存块在解锁后释放
+			if(++pList->count > m_dwLocalHigh)
+			{
+				while(pList->count > m_dwLocalLow)
+				{
+					T* pFlush	 = pList->pHead;
+					pList->pHead = (T*)pFlush->next;
+
+					--pList->count;
+
+					if(!m_lsFreeItem.TryPut(pFlush))
+					{
+						pFlush->next = pOverflow;
+						pOverflow	 = pFlush;
+					}
+				}
+			}
+		}
+
+		while(pOverflow != nullptr)
+		{
+			T* pNext = (T*)pOverflow->next;
+			T::Destruct(pOverflow);
+			pOverflow = pNext;
+		}
 	}
 
 	void PutFreeItem(TSimpleList<T>& lsItem)
@@ -281,9 +335,9 @@ public:
 
 	T* PickFreeItem()
 	{
-		T* pItem = nullptr;
+		T* pItem = PickLocalItem();
 
-		if(!m_lsFreeItem.TryGet(&pItem))
+		if(pItem == nullptr)
 			pItem = T::Construct(m_heap, m_dwItemCapacity);
 
 		ASSERT(pItem);
@@ -295,22 +349,118 @@ public:
 	void Prepare()
 	{
 		m_lsFreeItem.Reset(m_dwPoolSize);
+
+		// 低水位必须低于高水位，否则超过高水位后不会归还，本地链表将无限增长
+		if(m_dwLocalLow >= m_dwLocalHigh)
+			m_dwLocalLow = m_dwLocalHigh / 2;
+
+		if(m_dwLocalHigh > 0 && !m_shLocalLists.IsValid())
+			m_shLocalLists.Create();
 	}
 
 	void Clear()
 	{
+		if(m_shLocalLists.IsValid())
+		{
+			for(DWORD i = 0, dwCount = m_shLocalLists.GetCount(); i < dwCount; i++)
+			{
+				T* pItem = m_shLocalLists[i].pHead;
+
+				while(pItem != nullptr)
+				{
+					T* pNext = (T*)pItem->next;
+					T::Destruct(pItem);
+					pItem = pNext;
+				}
+			}
+
+			m_shLocalLists.Destroy();
+		}
+
 		m_lsFreeItem.Clear();
 
 		m_heap.Reset();
 	}
 
+	void GetLocalCacheStat(ULONGLONG& ullHits, ULONGLONG& ullMisses)
+	{
+		ullHits		= 0;
+		ullMisses	= 0;
+
+		for(DWORD i = 0, dwCount = m_shLocalLists.GetCount(); i < dwCount; i++)
+		{
+			TLocalList& ll = m_shLocalLists[i];
+			CSpinLock locallock(ll.cs);
+
+			ullHits		+= ll.hits;
+			ullMisses	+= ll.misses;
+		}
+	}
+
+private:
+	TLocalList* GetLocalList()
+	{
+		if(!m_shLocalLists.IsValid())
+			return nullptr;
+
+		return &m_shLocalLists.Current();
+	}
+
+	T* PickLocalItem()
+	{
+		T* pItem		  = nullptr;
+		TLocalList* pList = GetLocalList();
+
+		if(pList == nullptr)
+		{
+			m_lsFreeItem.TryGet(&pItem);
+			return pItem;
+		}
+
+		CSpinLock locallock(pList->cs);
+
+		if(pList->count > 0)
+			++pList->hits;
+		else
+		{
+			++pList->misses;
+
+			DWORD dwRefill = max(m_dwLocalLow, 1UL);
+
+			// 本地链表为空时从全局缓存池批量补充到低水位
+			for(DWORD i = 0; i < dwRefill && m_lsFreeItem.TryGet(&pItem); i++)
+			{
+				pItem->next	 = pList->pHead;
+				pList->pHead = pItem;
+
+				++pList->count;
+			}
+		}
+
+		pItem = pList->pHead;
+
+		if(pItem != nullptr)
+		{
+			pList->pHead = (T*)pItem->next;
+			--pList->count;
+		}
+
+		return pItem;
+	}
+
 public:
 	void SetItemCapacity(DWORD dwItemCapacity)	{m_dwItemCapacity	= dwItemCapacity;}
 	void SetPoolSize	(DWORD dwPoolSize)		{m_dwPoolSize		= dwPoolSize;}
 	void SetPoolHold	(DWORD dwPoolHold)		{m_dwPoolHold		= dwPoolHold;}
+	/* 本地链表水位（高水位为 0 时不使用本地链表），Prepare() 时保证低水位低于高水位 */
+	void SetLocalHigh	(DWORD dwLocalHigh)		{m_dwLocalHigh		= dwLocalHigh;}
+	void SetLocalLow	(DWORD dwLocalLow)		{m_dwLocalLow		= dwLocalLow;}
 	DWORD GetItemCapacity	()					{return m_dwItemCapacity;}
 	DWORD GetPoolSize		()					{return m_dwPoolSize;}
 	DWORD GetPoolHold		()					{return m_dwPoolHold;}
+	DWORD GetLocalHigh		()					{return m_dwLocalHigh;}
+	DWORD GetLocalLow		()					{return m_dwLocalLow;}
+	CPrivateHeap& GetPrivateHeap()				{return m_heap;}
 
 public:
 	CNodePoolT(	DWORD dwPoolSize	 = DEFAULT_POOL_SIZE,
@@ -319,6 +469,8 @@ public:
 				: m_dwPoolSize(dwPoolSize)
 				, m_dwPoolHold(dwPoolHold)
 				, m_dwItemCapacity(dwItemCapacity)
+				, m_dwLocalHigh(DEFAULT_LOCAL_HIGH)
+				, m_dwLocalLow(DEFAULT_LOCAL_LOW)
 	{
 	}
 
@@ -330,6 +482,8 @@ public:
 	static const DWORD DEFAULT_ITEM_CAPACITY;
 	static const DWORD DEFAULT_POOL_SIZE;
 	static const DWORD DEFAULT_POOL_HOLD;
+	static const DWORD DEFAULT_LOCAL_HIGH;
+	static const DWORD DEFAULT_LOCAL_LOW;
 
 private:
 	CPrivateHeap	m_heap;
@@ -337,13 +491,19 @@ private:
 	DWORD			m_dwItemCapacity;
 	DWORD			m_dwPoolSize;
 	DWORD			m_dwPoolHold;
+	DWORD			m_dwLocalHigh;
+	DWORD			m_dwLocalLow;
 
 	CRingPool<T>	m_lsFreeItem;
+
+	CCpuShards<TLocalList>	m_shLocalLists;
 };
 
 template<class T> const DWORD CNodePoolT<T>::DEFAULT_ITEM_CAPACITY	= TItem::DEFAULT_ITEM_CAPACITY;
 template<class T> const DWORD CNodePoolT<T>::DEFAULT_POOL_SIZE		= DEFAULT_BUFFER_CACHE_POOL_SIZE;
 template<class T> const DWORD CNodePoolT<T>::DEFAULT_POOL_HOLD		= DEFAULT_BUFFER_CACHE_POOL_HOLD;
+template<class T> const DWORD CNodePoolT<T>::DEFAULT_LOCAL_HIGH		= DEFAULT_BUFFER_CACHE_LOCAL_HIGH;
+template<class T> const DWORD CNodePoolT<T>::DEFAULT_LOCAL_LOW		= DEFAULT_BUFFER_CACHE_LOCAL_LOW;
 
 typedef CNodePoolT<TItem>	CItemPool;
 
@@ -704,6 +864,8 @@ public:
 
 	DWORD GetFreeTime	()	const	{return freeTime;}
 
+	static BOOL IsReclaimable(TBuffer* pBuffer) {return TRUE;}
+
 private:
 	int IncreaseLength	(int len)	{return (length += len);}
 	int DecreaseLength	(int len)	{return (length -= len);}
@@ -739,7 +901,7 @@ private:
 class CBufferPool
 {
 	typedef CRingPool<TBuffer>						TBufferList;
-	typedef CCASQueue<TBuffer>						TBufferQueue;
+	typedef CEpochGCT<TBuffer>						TBufferGC;
 
 	typedef CRingCache<TBuffer, ULONG_PTR, true>	TBufferCache;
 
@@ -775,6 +937,8 @@ public:
 	DWORD GetBufferPoolSize	()							{return m_dwBufferPoolSize;}
 	DWORD GetBufferPoolHold	()							{return m_dwBufferPoolHold;}
 
+	CEpoch& GetEpoch		()							{return m_gcBuffer.GetEpoch();}
+
 	TBuffer* operator []	(ULONG_PTR dwID)			{return FindCacheBuffer(dwID);}
 
 public:
@@ -809,7 +973,7 @@ public:
 
 private:
 	DWORD			m_dwMaxCacheSize;
-	DWORD			m_dwBufferLockTime;
+	DWORD			m_dwBufferLockTime;	// 已改为按纪元回收，仅为兼容保留
 	DWORD			m_dwBufferPoolSize;
 	DWORD			m_dwBufferPoolHold;
 
@@ -819,7 +983,7 @@ private:
 	TBufferCache	m_bfCache;
 
 	TBufferList		m_lsFreeBuffer;
-	TBufferQueue	m_lsGCBuffer;
+	TBufferGC		m_gcBuffer;
 };
 
 #pragma warning(pop)
@@ -354,6 +354,17 @@ private:
 	BOOL		m_bValid;
 };
 
+template<class CLockObj> class CLocalCondLock
+{
+public:
+	CLocalCondLock(CLockObj& obj, BOOL bLock) : m_lock(obj), m_bLock(bLock) {if(m_bLock) m_lock.Lock();}
+	~CLocalCondLock() {if(m_bLock) m_lock.Unlock();}
+
+private:
+	CLockObj&	m_lock;
+	BOOL		m_bLock;
+};
+
 typedef CInterCriSec						CCriSec;
 
 typedef CLocalLock<CCriSec>					CCriSecLock;
@@ -370,4 +381,6 @@ typedef CLocalTryLock<CInterCriSec2>		CInterCriSecTryLock2;
 typedef CLocalTryLock<CMTX>					CMutexTryLock;
 typedef CLocalTryLock<CSpinGuard>			CSpinTryLock;
 typedef CLocalTryLock<CReentrantSpinGuard>	CReentrantSpinTryLock;
-typedef	CLocalTryLock<CFakeGuard>			CFakeTryLock;
\ No newline at end of file
+typedef	CLocalTryLock<CFakeGuard>			CFakeTryLock;
+
+typedef CLocalCondLock<CCriSec>				CCriSecCondLock;
\ No newline at end of file
@@ -0,0 +1,89 @@
+﻿/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+/******************************************************************************
+Module:  Epoch.cpp
+Notices: Copyright (c) 2013 Bruce Liang
+Purpose: 基于纪元的对象回收
+Desc:
+******************************************************************************/
+
+#include "stdafx.h"
+#include "Epoch.h"
+#include "SysHelper.h"
+
+CEpoch::CEpoch()
+: m_lEpoch(0)
+, m_shSlots(TRUE)
+{
+
+}
+
+CEpoch::~CEpoch()
+{
+
+}
+
+DWORD CEpoch::Enter()
+{
+	DWORD dwSlot	= m_shSlots.GetCurrentIndex();
+	DWORD dwParity	= (DWORD)m_lEpoch & 1;
+
+	// InterlockedIncrement 带完全内存屏障，之后的共享对象读取不会越过计数
+	::InterlockedIncrement(&m_shSlots[dwSlot].readers[dwParity]);
+
+	return (dwSlot << 1) | dwParity;
+}
+
+void CEpoch::Leave(DWORD dwToken)
+{
+	::InterlockedDecrement(&m_shSlots[dwToken >> 1].readers[dwToken & 1]);
+}
+
+BOOL CEpoch::TryAdvance()
+{
+	if(!m_csAdvance.TryLock())
+		return FALSE;
+
+	BOOL isOK		= TRUE;
+	DWORD dwParity	= (DWORD)(m_lEpoch + 1) & 1;
+
+	::MemoryBarrier();
+
+	// 上一纪元的读者尚未全部退出则不能推进
+	for(DWORD i = 0, dwCount = m_shSlots.GetCount(); i < dwCount; i++)
+	{
+		if(m_shSlots[i].readers[dwParity] != 0)
+		{
+			isOK = FALSE;
+			break;
+		}
+	}
+
+	if(isOK)
+		::InterlockedIncrement(&m_lEpoch);
+
+	m_csAdvance.Unlock();
+
+	return isOK;
+}
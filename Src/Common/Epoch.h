@@ -0,0 +1,146 @@
+﻿/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+/******************************************************************************
+Module:  Epoch.h
+Notices: Copyright (c) 2013 Bruce Liang
+Purpose: 基于纪元的对象回收
+Desc:
+		1. CEpoch 以奇偶两组读者计数区分新旧纪元, 读者计数按 CPU 分片,
+		   任意线程均可进入 / 退出读者区, 无需注册
+		2. 只有旧纪元的读者全部退出后纪元才会推进; 对象在纪元 E 退役后,
+		   纪元推进到 E + 2 时已不可能被任何读者持有
+		3. CEpochGCT 保存退役对象, 安全后归还空闲池 (T::IsReclaimable()
+		   可附加宿主对象自身的回收条件, 如未完成的 IOCP 操作)
+******************************************************************************/
+
+#pragma once
+
+#include "CriticalSection.h"
+#include "SysHelper.h"
+#include "RingBuffer.h"
+#include "STLHelper.h"
+
+class CEpoch
+{
+public:
+	DWORD Enter		();
+	void Leave		(DWORD dwToken);
+	BOOL TryAdvance	();
+
+	ULONG GetEpoch	()						const	{return (ULONG)m_lEpoch;}
+	BOOL IsSafe		(ULONG ulRetireEpoch)	const	{return (LONG)(GetEpoch() - ulRetireEpoch) >= 2;}
+
+public:
+	CEpoch();
+	~CEpoch();
+
+	DECLARE_NO_COPY_CLASS(CEpoch)
+
+private:
+	struct TReaderSlot
+	{
+		volatile LONG	readers[2];
+		BYTE			padding[64 - 2 * sizeof(LONG)];
+	};
+
+	volatile LONG	m_lEpoch;
+	CSpinGuard		m_csAdvance;
+
+	CCpuShards<TReaderSlot>	m_shSlots;
+};
+
+class CEpochLock
+{
+public:
+	CEpochLock(CEpoch& epoch) : m_epoch(epoch), m_dwToken(epoch.Enter()) {}
+	~CEpochLock() {m_epoch.Leave(m_dwToken);}
+
+	DECLARE_NO_COPY_CLASS(CEpochLock)
+
+private:
+	CEpoch&	m_epoch;
+	DWORD	m_dwToken;
+};
+
+template<class T> class CEpochGCT
+{
+	typedef pair<T*, ULONG>		TRetired;
+	typedef deque<TRetired>		TRetiredQueue;
+
+public:
+	void Retire(T* pObj)
+	{
+		ASSERT(pObj != nullptr);
+
+		CSpinLock locallock(m_cs);
+
+		m_dqRetired.push_back(TRetired(pObj, m_epoch.GetEpoch()));
+		m_lSize = (LONG)m_dqRetired.size();
+	}
+
+	void Reclaim(CRingPool<T>& lsFree, BOOL bForce = FALSE)
+	{
+		if(IsEmpty())
+			return;
+
+		if(!bForce)
+			m_epoch.TryAdvance();
+
+		CSpinLock locallock(m_cs);
+
+		// 未完成宿主回收条件的对象移到队尾，不阻塞其后已安全的对象
+		for(size_t i = 0, size = m_dqRetired.size(); i < size; i++)
+		{
+			TRetired retired = m_dqRetired.front();
+
+			if(!bForce && !m_epoch.IsSafe(retired.second))
+				break;
+
+			m_dqRetired.pop_front();
+
+			if(!bForce && !T::IsReclaimable(retired.first))
+				m_dqRetired.push_back(retired);
+			else if(bForce || !lsFree.TryPut(retired.first))
+				T::Destruct(retired.first);
+		}
+
+		m_lSize = (LONG)m_dqRetired.size();
+	}
+
+	BOOL IsEmpty()		const	{return m_lSize == 0;}
+	DWORD Size()		const	{return (DWORD)m_lSize;}
+	CEpoch& GetEpoch()			{return m_epoch;}
+
+public:
+	CEpochGCT() : m_lSize(0) {}
+	~CEpochGCT() {ASSERT(IsEmpty());}
+
+	DECLARE_NO_COPY_CLASS(CEpochGCT)
+
+private:
+	CEpoch			m_epoch;
+	CSpinGuard		m_cs;
+	TRetiredQueue	m_dqRetired;
+	volatile LONG	m_lSize;
+};
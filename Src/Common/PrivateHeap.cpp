@@ -29,3 +29,416 @@ Purpose: 管理进程私有堆.
 
 #include "StdAfx.h"
 #include "PrivateHeap.h"
+#include "SysHelper.h"
+
+CSlabHeapImpl::CSlabHeapImpl(DWORD dwOptions, SIZE_T dwInitSize, SIZE_T dwMaxSize)
+: m_dwOptions(dwOptions | HEAP_GENERATE_EXCEPTIONS), m_dwInitSize(dwInitSize), m_dwMaxSize(dwMaxSize)
+{
+	m_shShards.Create(MAX_SHARD_COUNT);
+	m_hHeap = nullptr;
+
+	Initialize();
+	ENSURE(IsValid());
+}
+
+CSlabHeapImpl::~CSlabHeapImpl()
+{
+	Release();
+}
+
+BOOL CSlabHeapImpl::Reset()
+{
+	Release();
+	Initialize();
+
+	return IsValid();
+}
+
+void CSlabHeapImpl::Initialize()
+{
+	m_hHeap = ::HeapCreate(m_dwOptions, m_dwInitSize, m_dwMaxSize);
+
+	for(DWORD i = 0; i < CLASS_COUNT; i++)
+	{
+		TSizeClass& sc = m_classes[i];
+
+		sc.pFree		= nullptr;
+		sc.pCarve		= nullptr;
+		sc.pCarveEnd	= nullptr;
+		sc.pSlabs		= nullptr;
+		sc.slabCount	= 0;
+		sc.totalSlots	= 0;
+		sc.freeSlots	= 0;
+	}
+
+	for(DWORD i = 0, dwCount = m_shShards.GetCount(); i < dwCount; i++)
+		m_shShards[i] = nullptr;
+
+	m_lLargeCount	= 0;
+	m_llLargeBytes	= 0;
+}
+
+void CSlabHeapImpl::Release()
+{
+	for(DWORD i = 0; i < CLASS_COUNT; i++)
+	{
+		TSlab* pSlab = m_classes[i].pSlabs;
+
+		while(pSlab != nullptr)
+		{
+			TSlab* pNext = pSlab->next;
+			VERIFY(::VirtualFree(pSlab, 0, MEM_RELEASE));
+			pSlab = pNext;
+		}
+
+		m_classes[i].pSlabs = nullptr;
+	}
+
+	// CPU 分片、弹匣和大块内存都在内部私有堆中，随堆一起销毁
+	if(IsValid())
+	{
+		::HeapDestroy(m_hHeap);
+		m_hHeap = nullptr;
+	}
+}
+
+PVOID CSlabHeapImpl::Alloc(SIZE_T dwSize, DWORD dwFlags)
+{
+	SIZE_T dwTotal = dwSize + sizeof(TBlockHeader);
+	TBlockHeader* pHeader;
+
+	if(dwTotal <= MAX_SLOT_SIZE)
+	{
+		DWORD dwClass = SizeToClass(dwTotal);
+
+		pHeader		 = (TBlockHeader*)AllocSlot(dwClass);
+		pHeader->cls = dwClass;
+	}
+	else
+	{
+		pHeader = (TBlockHeader*)::HeapAlloc(m_hHeap, 0, dwTotal);
+
+		if(pHeader == nullptr)
+			return nullptr;
+
+		pHeader->cls = LARGE_CLASS;
+
+		::InterlockedIncrement(&m_lLargeCount);
+		::InterlockedExchangeAdd64(&m_llLargeBytes, (LONGLONG)dwSize);
+	}
+
+	pHeader->size	  = dwSize;
+	pHeader->reserved = 0;
+
+	PVOID pv = pHeader + 1;
+
+	if(dwFlags & HEAP_ZERO_MEMORY)
+		::ZeroMemory(pv, dwSize);
+
+	return pv;
+}
+
+PVOID CSlabHeapImpl::ReAlloc(PVOID pvMemory, SIZE_T dwSize, DWORD dwFlags)
+{
+	if(pvMemory == nullptr)
+		return Alloc(dwSize, dwFlags);
+
+	TBlockHeader* pHeader = (TBlockHeader*)pvMemory - 1;
+	SIZE_T dwOldSize	  = (SIZE_T)pHeader->size;
+	SIZE_T dwTotal		  = dwSize + sizeof(TBlockHeader);
+
+	if(pHeader->cls != LARGE_CLASS)
+	{
+		// 当前槽位容纳得下则原地调整
+		if(dwTotal <= GetClassSize(pHeader->cls))
+		{
+			if((dwFlags & HEAP_ZERO_MEMORY) && dwSize > dwOldSize)
+				::ZeroMemory((BYTE*)pvMemory + dwOldSize, dwSize - dwOldSize);
+
+			pHeader->size = dwSize;
+			return pvMemory;
+		}
+	}
+	else if(dwTotal > MAX_SLOT_SIZE)
+	{
+		pHeader = (TBlockHeader*)::HeapReAlloc(m_hHeap, dwFlags & (HEAP_ZERO_MEMORY | HEAP_REALLOC_IN_PLACE_ONLY), pHeader, dwTotal);
+
+		if(pHeader == nullptr)
+			return nullptr;
+
+		::InterlockedExchangeAdd64(&m_llLargeBytes, (LONGLONG)dwSize - (LONGLONG)dwOldSize);
+
+		pHeader->size = dwSize;
+		return pHeader + 1;
+	}
+
+	if(dwFlags & HEAP_REALLOC_IN_PLACE_ONLY)
+		return nullptr;
+
+	PVOID pvNew = Alloc(dwSize);
+
+	if(pvNew == nullptr)
+		return nullptr;
+
+	memcpy(pvNew, pvMemory, min(dwOldSize, dwSize));
+
+	if((dwFlags & HEAP_ZERO_MEMORY) && dwSize > dwOldSize)
+		::ZeroMemory((BYTE*)pvNew + dwOldSize, dwSize - dwOldSize);
+
+	Free(pvMemory);
+
+	return pvNew;
+}
+
+SIZE_T CSlabHeapImpl::Size(PVOID pvMemory, DWORD dwFlags)
+{
+	if(pvMemory == nullptr)
+		return (SIZE_T)-1;
+
+	return (SIZE_T)((TBlockHeader*)pvMemory - 1)->size;
+}
+
+BOOL CSlabHeapImpl::Free(PVOID pvMemory, DWORD dwFlags)
+{
+	if(pvMemory == nullptr)
+		return TRUE;
+
+	TBlockHeader* pHeader = (TBlockHeader*)pvMemory - 1;
+
+	if(pHeader->cls == LARGE_CLASS)
+	{
+		::InterlockedDecrement(&m_lLargeCount);
+		::InterlockedExchangeAdd64(&m_llLargeBytes, -(LONGLONG)pHeader->size);
+
+		return ::HeapFree(m_hHeap, 0, pHeader);
+	}
+
+	ASSERT(pHeader->cls < CLASS_COUNT);
+
+	FreeSlot(pHeader->cls, pHeader);
+
+	return TRUE;
+}
+
+BOOL CSlabHeapImpl::GetClassStat(DWORD dwClass, TClassStat& stat)
+{
+	if(dwClass >= CLASS_COUNT)
+		return FALSE;
+
+	TSizeClass& sc = m_classes[dwClass];
+
+	stat.slotSize	 = GetClassSize(dwClass);
+	stat.cachedSlots = 0;
+
+	SIZE_T freeSlots;
+
+	{
+		CSpinLock locallock(sc.cs);
+
+		stat.slabCount	= sc.slabCount;
+		stat.totalSlots	= sc.totalSlots;
+		freeSlots		= sc.freeSlots;
+	}
+
+	for(DWORD i = 0, dwCount = m_shShards.GetCount(); i < dwCount; i++)
+	{
+		TShard* pShard = m_shShards[i];
+
+		if(pShard == nullptr)
+			continue;
+
+		CSpinLock locallock(pShard->cs);
+
+		if(pShard->mags[dwClass] != nullptr)
+			stat.cachedSlots += pShard->mags[dwClass]->count;
+	}
+
+	// 各计数不是同一时刻的快照，并发分配时取近似值
+	SIZE_T idle		= freeSlots + stat.cachedSlots;
+	stat.usedSlots	= stat.totalSlots > idle ? stat.totalSlots - idle : 0;
+
+	return TRUE;
+}
+
+void CSlabHeapImpl::GetLargeStat(SIZE_T& dwCount, SIZE_T& dwBytes)
+{
+	dwCount	= (SIZE_T)m_lLargeCount;
+	dwBytes	= (SIZE_T)m_llLargeBytes;
+}
+
+DWORD CSlabHeapImpl::SizeToClass(SIZE_T dwTotal)
+{
+	ASSERT(dwTotal > 0 && dwTotal <= MAX_SLOT_SIZE);
+
+	// 128 字节以内按 16 字节递增，之后每个 2 的幂区间均分为 4 个等级
+	if(dwTotal <= (SMALL_CLASS_COUNT << 4))
+		return (DWORD)((dwTotal + 15) >> 4) - 1;
+
+	DWORD v = (DWORD)(dwTotal - 1);
+	DWORD p;
+
+	::_BitScanReverse(&p, v);
+
+	return SMALL_CLASS_COUNT + (p - 7) * 4 + (v >> (p - 2)) - 4;
+}
+
+SIZE_T CSlabHeapImpl::GetClassSize(DWORD dwClass)
+{
+	ASSERT(dwClass < CLASS_COUNT);
+
+	if(dwClass < SMALL_CLASS_COUNT)
+		return (SIZE_T)(dwClass + 1) << 4;
+
+	DWORD k = dwClass - SMALL_CLASS_COUNT;
+	DWORD p = 7 + k / 4;
+	DWORD m = 4 + k % 4;
+
+	return (SIZE_T)(m + 1) << (p - 2);
+}
+
+SIZE_T CSlabHeapImpl::GetSlabSize(DWORD dwClass)
+{
+	SIZE_T dwSize = SLAB_HEADER_SIZE + GetClassSize(dwClass) * 8;
+
+	return (dwSize + SLAB_UNIT_SIZE - 1) / SLAB_UNIT_SIZE * SLAB_UNIT_SIZE;
+}
+
+int CSlabHeapImpl::GetMagazineCapacity(DWORD dwClass)
+{
+	SIZE_T dwCapacity = MAGAZINE_BYTES / GetClassSize(dwClass);
+
+	return (int)max(min(dwCapacity, (SIZE_T)64), (SIZE_T)4);
+}
+
+CSlabHeapImpl::TShard* CSlabHeapImpl::GetShard()
+{
+	DWORD dwIndex	= m_shShards.GetCurrentIndex();
+	TShard* pShard	= m_shShards[dwIndex];
+
+	if(pShard != nullptr)
+		return pShard;
+
+	pShard = (TShard*)::HeapAlloc(m_hHeap, HEAP_ZERO_MEMORY, sizeof(TShard));
+	::new (pShard) TShard;
+
+	for(DWORD i = 0; i < CLASS_COUNT; i++)
+		pShard->mags[i] = nullptr;
+
+	TShard* pOld = (TShard*)::InterlockedCompareExchangePointer((PVOID volatile*)&m_shShards[dwIndex], pShard, nullptr);
+
+	if(pOld != nullptr)
+	{
+		pShard->~TShard();
+		::HeapFree(m_hHeap, 0, pShard);
+
+		pShard = pOld;
+	}
+
+	return pShard;
+}
+
+CSlabHeapImpl::TMagazine* CSlabHeapImpl::GetMagazine(TShard* pShard, DWORD dwClass)
+{
+	TMagazine* pMag = pShard->mags[dwClass];
+
+	if(pMag == nullptr)
+	{
+		int iCapacity = GetMagazineCapacity(dwClass);
+
+		pMag			= (TMagazine*)::HeapAlloc(m_hHeap, 0, sizeof(TMagazine) + (iCapacity - 1) * sizeof(PVOID));
+		pMag->count		= 0;
+		pMag->capacity	= iCapacity;
+
+		pShard->mags[dwClass] = pMag;
+	}
+
+	return pMag;
+}
+
+PVOID CSlabHeapImpl::AllocSlot(DWORD dwClass)
+{
+	TShard* pShard = GetShard();
+	CSpinLock locallock(pShard->cs);
+
+	TMagazine* pMag = GetMagazine(pShard, dwClass);
+
+	if(pMag->count == 0)
+		Refill(pMag, dwClass);
+
+	return pMag->items[--pMag->count];
+}
+
+void CSlabHeapImpl::FreeSlot(DWORD dwClass, PVOID pvSlot)
+{
+	TShard* pShard = GetShard();
+	CSpinLock locallock(pShard->cs);
+
+	TMagazine* pMag = GetMagazine(pShard, dwClass);
+
+	if(pMag->count == pMag->capacity)
+		Flush(pMag, dwClass, pMag->capacity / 2);
+
+	pMag->items[pMag->count++] = pvSlot;
+}
+
+void CSlabHeapImpl::Refill(TMagazine* pMag, DWORD dwClass)
+{
+	TSizeClass& sc	= m_classes[dwClass];
+	SIZE_T dwSlot	= GetClassSize(dwClass);
+	int iTarget		= max(pMag->capacity / 2, 1);
+
+	CSpinLock locallock(sc.cs);
+
+	while(pMag->count < iTarget && sc.pFree != nullptr)
+	{
+		TFreeNode* pNode = sc.pFree;
+		sc.pFree		 = pNode->next;
+
+		--sc.freeSlots;
+		pMag->items[pMag->count++] = pNode;
+	}
+
+	while(pMag->count < iTarget)
+	{
+		if(sc.pCarve == nullptr || sc.pCarve + dwSlot > sc.pCarveEnd)
+			NewSlab(sc, dwClass);
+
+		pMag->items[pMag->count++] = sc.pCarve;
+
+		sc.pCarve += dwSlot;
+		++sc.totalSlots;
+	}
+}
+
+void CSlabHeapImpl::Flush(TMagazine* pMag, DWORD dwClass, int iCount)
+{
+	TSizeClass& sc = m_classes[dwClass];
+	CSpinLock locallock(sc.cs);
+
+	for(int i = 0; i < iCount && pMag->count > 0; i++)
+	{
+		TFreeNode* pNode = (TFreeNode*)pMag->items[--pMag->count];
+		pNode->next		 = sc.pFree;
+		sc.pFree		 = pNode;
+
+		++sc.freeSlots;
+	}
+}
+
+void CSlabHeapImpl::NewSlab(TSizeClass& sc, DWORD dwClass)
+{
+	SIZE_T dwSize = GetSlabSize(dwClass);
+	TSlab* pSlab  = (TSlab*)::VirtualAlloc(nullptr, dwSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+	if(pSlab == nullptr)
+		::RaiseException(STATUS_NO_MEMORY, 0, 0, nullptr);
+
+	pSlab->next	= sc.pSlabs;
+	pSlab->size	= dwSize;
+	sc.pSlabs	= pSlab;
+
+	sc.pCarve		= (BYTE*)pSlab + SLAB_HEADER_SIZE;
+	sc.pCarveEnd	= (BYTE*)pSlab + dwSize;
+
+	++sc.slabCount;
+}
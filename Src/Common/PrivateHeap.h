@@ -35,6 +35,11 @@ Desc:
 								一般用于在函数体内分配和释放局部作用域的堆内存
 								从而避免对 CPrivateHeap::Alloc() 和 
 								CPrivateHeap::Free() 的调用
+		 3. CSlabHeapImpl:		Slab 分配器, 与 CPrivateHeapImpl 接口相同
+								小于 32 KB 的内存块按固定尺寸等级从按页对齐的
+								Slab 中切分, 每个 CPU 持有各尺寸等级的弹匣缓存,
+								分配 / 释放通常只访问当前 CPU 的弹匣; 大块内存
+								仍由内部私有堆分配. 可报告各尺寸等级的使用统计
 
 Examples:
 			CPrivateHeap g_hpPrivate;
@@ -64,6 +69,8 @@ Examples:
 
 #pragma once
 
+#include "SysHelper.h"
+
 class CPrivateHeapImpl
 {
 public:
@@ -177,10 +184,140 @@ private:
 	CGlobalHeapImpl operator = (const CGlobalHeapImpl&);
 };
 
-#ifndef _NOT_USE_PRIVATE_HEAP
+class CSlabHeapImpl
+{
+public:
+	/* 尺寸等级使用统计 */
+	struct TClassStat
+	{
+		SIZE_T slotSize;	// 槽位大小（含块头）
+		SIZE_T slabCount;	// Slab 数量
+		SIZE_T totalSlots;	// 已切分的槽位数量
+		SIZE_T usedSlots;	// 正在使用的槽位数量
+		SIZE_T cachedSlots;	// CPU 弹匣缓存的槽位数量
+	};
+
+public:
+	PVOID Alloc(SIZE_T dwSize, DWORD dwFlags = 0);
+	PVOID ReAlloc(PVOID pvMemory, SIZE_T dwSize, DWORD dwFlags = 0);
+	SIZE_T Size(PVOID pvMemory, DWORD dwFlags = 0);
+	BOOL Free(PVOID pvMemory, DWORD dwFlags = 0);
+
+	SIZE_T Compact(DWORD dwFlags = 0)
+		{return ::HeapCompact(m_hHeap, dwFlags);}
+
+	BOOL IsValid() {return m_hHeap != nullptr;}
+	BOOL Reset();
+
+	BOOL GetClassStat(DWORD dwClass, TClassStat& stat);
+	void GetLargeStat(SIZE_T& dwCount, SIZE_T& dwBytes);
+
+	static DWORD GetClassCount()	{return CLASS_COUNT;}
+	static SIZE_T GetClassSize(DWORD dwClass);
+
+public:
+	CSlabHeapImpl(DWORD dwOptions = 0, SIZE_T dwInitSize = 0, SIZE_T dwMaxSize = 0);
+	~CSlabHeapImpl();
+
+	operator HANDLE	()	{return m_hHeap;}
+
+private:
+	CSlabHeapImpl(const CSlabHeapImpl&);
+	CSlabHeapImpl operator = (const CSlabHeapImpl&);
+
+private:
+	static const DWORD CLASS_COUNT			= 40;
+	static const DWORD SMALL_CLASS_COUNT	= 8;
+	static const DWORD LARGE_CLASS			= (DWORD)-1;
+	static const DWORD MAX_SHARD_COUNT		= 64;
+	static const SIZE_T MAX_SLOT_SIZE		= 32768;
+	static const SIZE_T SLAB_UNIT_SIZE		= 64 * 1024;
+	static const SIZE_T SLAB_HEADER_SIZE	= 64;
+	static const SIZE_T MAGAZINE_BYTES		= 64 * 1024;
+
+	/* 块头，位于返回给调用者的内存之前，保持 16 字节对齐 */
+	struct TBlockHeader
+	{
+		ULONGLONG	size;
+		DWORD		cls;
+		DWORD		reserved;
+	};
+
+	static_assert(sizeof(TBlockHeader) == 16, "TBlockHeader must keep 16-byte alignment");
+
+	struct TFreeNode
+	{
+		TFreeNode* next;
+	};
+
+	struct TSlab
+	{
+		TSlab*	next;
+		SIZE_T	size;
+	};
+
+	/* 尺寸等级的中心空闲链表和 Slab 切分状态 */
+	struct TSizeClass
+	{
+		CSpinGuard	cs;
+		TFreeNode*	pFree;
+		BYTE*		pCarve;
+		BYTE*		pCarveEnd;
+		TSlab*		pSlabs;
+		SIZE_T		slabCount;
+		SIZE_T		totalSlots;
+		SIZE_T		freeSlots;
+	};
+
+	/* 弹匣：缓存某一尺寸等级的空闲槽位 */
+	struct TMagazine
+	{
+		int		count;
+		int		capacity;
+		PVOID	items[1];
+	};
+
+	/* CPU 分片：持有该 CPU 上各尺寸等级的弹匣 */
+	struct TShard
+	{
+		CSpinGuard	cs;
+		TMagazine*	mags[CLASS_COUNT];
+	};
+
+private:
+	static DWORD SizeToClass(SIZE_T dwTotal);
+	static SIZE_T GetSlabSize(DWORD dwClass);
+	static int GetMagazineCapacity(DWORD dwClass);
+
+	TShard* GetShard();
+	TMagazine* GetMagazine(TShard* pShard, DWORD dwClass);
+	PVOID AllocSlot(DWORD dwClass);
+	void FreeSlot(DWORD dwClass, PVOID pvSlot);
+	void Refill(TMagazine* pMag, DWORD dwClass);
+	void Flush(TMagazine* pMag, DWORD dwClass, int iCount);
+	void NewSlab(TSizeClass& sc, DWORD dwClass);
+	void Initialize();
+	void Release();
+
+private:
+	HANDLE	m_hHeap;
+	DWORD	m_dwOptions;
+	SIZE_T	m_dwInitSize;
+	SIZE_T	m_dwMaxSize;
+
+	TSizeClass						m_classes[CLASS_COUNT];
+	CCpuShards<TShard* volatile>	m_shShards;
+
+	volatile LONG					m_lLargeCount;
+	volatile LONGLONG				m_llLargeBytes;
+};
+
+#if defined(_NOT_USE_PRIVATE_HEAP)
+	typedef CGlobalHeapImpl		CPrivateHeap;
+#elif defined(_NOT_USE_SLAB_HEAP)
 	typedef CPrivateHeapImpl	CPrivateHeap;
 #else
-	typedef CGlobalHeapImpl		CPrivateHeap;
+	typedef CSlabHeapImpl		CPrivateHeap;
 #endif
 
 template<class T> class CPrivateHeapBuffer
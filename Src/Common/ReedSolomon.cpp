@@ -0,0 +1,284 @@
+﻿/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+/******************************************************************************
+Module:  ReedSolomon.cpp
+Notices: Copyright (c) 2013 Bruce Liang
+Purpose: GF(2^8) 上的系统 Reed-Solomon 纠删码
+Desc:
+******************************************************************************/
+
+#include "stdafx.h"
+#include "ReedSolomon.h"
+
+/* GF(2^8) 运算表，本原多项式 x^8 + x^4 + x^3 + x^2 + 1 */
+struct TGaloisField
+{
+	BYTE exp[512];
+	BYTE log[256];
+	BYTE mul[256][256];
+
+	BYTE Inverse(BYTE a) const	{ASSERT(a != 0); return exp[255 - log[a]];}
+
+	TGaloisField()
+	{
+		int x = 1;
+
+		for(int i = 0; i < 255; i++)
+		{
+			exp[i]		= (BYTE)x;
+			exp[i + 255]= (BYTE)x;
+			log[x]		= (BYTE)i;
+
+			x <<= 1;
+
+			if(x & 0x100)
+				x ^= 0x11D;
+		}
+
+		exp[510] = exp[0];
+		exp[511] = exp[1];
+		log[0]	 = 0;
+
+		for(int a = 0; a < 256; a++)
+		{
+			for(int b = 0; b < 256; b++)
+				mul[a][b] = (a == 0 || b == 0) ? 0 : exp[log[a] + log[b]];
+		}
+	}
+};
+
+static const TGaloisField s_gf;
+
+CReedSolomon::CReedSolomon()
+: m_iDataShards		(0)
+, m_iParityShards	(0)
+, m_pMatrix			(nullptr)
+{
+
+}
+
+CReedSolomon::~CReedSolomon()
+{
+	Reset();
+}
+
+BOOL CReedSolomon::Init(int iDataShards, int iParityShards)
+{
+	if(iDataShards <= 0 || iParityShards <= 0 || iDataShards + iParityShards > MAX_SHARDS)
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	if(m_iDataShards == iDataShards && m_iParityShards == iParityShards)
+		return TRUE;
+
+	Reset();
+
+	m_iDataShards	= iDataShards;
+	m_iParityShards	= iParityShards;
+	m_pMatrix		= new BYTE[iParityShards * iDataShards];
+
+	// Cauchy 矩阵：m[i][j] = 1 / (x[i] ^ y[j])，x[i] = DataShards + i，y[j] = j
+	for(int i = 0; i < iParityShards; i++)
+	{
+		for(int j = 0; j < iDataShards; j++)
+			m_pMatrix[i * iDataShards + j] = s_gf.Inverse((BYTE)((iDataShards + i) ^ j));
+	}
+
+	return TRUE;
+}
+
+void CReedSolomon::Reset()
+{
+	if(m_pMatrix != nullptr)
+	{
+		delete[] m_pMatrix;
+		m_pMatrix = nullptr;
+	}
+
+	m_iDataShards	= 0;
+	m_iParityShards	= 0;
+}
+
+void CReedSolomon::Encode(const BYTE* const pData[], int iDataCount, BYTE* const pParity[], int iSize)
+{
+	ASSERT(IsValid() && iDataCount > 0 && iDataCount <= m_iDataShards);
+
+	for(int i = 0; i < m_iParityShards; i++)
+	{
+		const BYTE* pRow = m_pMatrix + i * m_iDataShards;
+
+		::ZeroMemory(pParity[i], iSize);
+
+		for(int j = 0; j < iDataCount; j++)
+			MulAdd(pParity[i], pData[j], pRow[j], iSize);
+	}
+}
+
+BOOL CReedSolomon::Reconstruct(BYTE* const pShards[], const BOOL bPresent[], int iDataCount, int iSize)
+{
+	ASSERT(IsValid() && iDataCount > 0 && iDataCount <= m_iDataShards);
+
+	const int k = m_iDataShards;
+
+	int iRows[MAX_SHARDS];
+	int iMissing[MAX_SHARDS];
+	int iRowCount	  = 0;
+	int iMissingCount = 0;
+
+	// 补齐的全零分片视为有效数据分片
+	for(int j = 0; j < k; j++)
+	{
+		if(j >= iDataCount || bPresent[j])
+			iRows[iRowCount++] = j;
+		else
+			iMissing[iMissingCount++] = j;
+	}
+
+	if(iMissingCount == 0)
+		return TRUE;
+
+	for(int i = 0; i < m_iParityShards && iRowCount < k; i++)
+	{
+		if(bPresent[k + i])
+			iRows[iRowCount++] = k + i;
+	}
+
+	if(iRowCount < k)
+		return FALSE;
+
+	// 以选中分片对应的编码矩阵行构造方阵并求逆
+	unique_ptr<BYTE[]> matrixPtr(new BYTE[k * k]);
+	BYTE* pMatrix = matrixPtr.get();
+
+	for(int r = 0; r < k; r++)
+	{
+		BYTE* pRow = pMatrix + r * k;
+
+		if(iRows[r] < k)
+		{
+			::ZeroMemory(pRow, k);
+			pRow[iRows[r]] = 1;
+		}
+		else
+			memcpy(pRow, m_pMatrix + (iRows[r] - k) * k, k);
+	}
+
+	if(!InvertMatrix(pMatrix, k))
+		return FALSE;
+
+	for(int m = 0; m < iMissingCount; m++)
+	{
+		int j		= iMissing[m];
+		BYTE* pDest	= pShards[j];
+		BYTE* pRow	= pMatrix + j * k;
+
+		::ZeroMemory(pDest, iSize);
+
+		for(int r = 0; r < k; r++)
+		{
+			if(iRows[r] < iDataCount || iRows[r] >= k)
+				MulAdd(pDest, pShards[iRows[r]], pRow[r], iSize);
+		}
+	}
+
+	return TRUE;
+}
+
+BOOL CReedSolomon::InvertMatrix(BYTE* pMatrix, int n)
+{
+	unique_ptr<BYTE[]> inversePtr(new BYTE[n * n]);
+	BYTE* pInverse = inversePtr.get();
+
+	::ZeroMemory(pInverse, n * n);
+
+	for(int i = 0; i < n; i++)
+		pInverse[i * n + i] = 1;
+
+	for(int c = 0; c < n; c++)
+	{
+		int p = c;
+
+		while(p < n && pMatrix[p * n + c] == 0)
+			++p;
+
+		if(p == n)
+			return FALSE;
+
+		if(p != c)
+		{
+			for(int i = 0; i < n; i++)
+			{
+				swap(pMatrix[p * n + i], pMatrix[c * n + i]);
+				swap(pInverse[p * n + i], pInverse[c * n + i]);
+			}
+		}
+
+		BYTE bInv = s_gf.Inverse(pMatrix[c * n + c]);
+
+		for(int i = 0; i < n; i++)
+		{
+			pMatrix[c * n + i]	= s_gf.mul[bInv][pMatrix[c * n + i]];
+			pInverse[c * n + i]	= s_gf.mul[bInv][pInverse[c * n + i]];
+		}
+
+		for(int r = 0; r < n; r++)
+		{
+			BYTE f = pMatrix[r * n + c];
+
+			if(r == c || f == 0)
+				continue;
+
+			for(int i = 0; i < n; i++)
+			{
+				pMatrix[r * n + i]	^= s_gf.mul[f][pMatrix[c * n + i]];
+				pInverse[r * n + i]	^= s_gf.mul[f][pInverse[c * n + i]];
+			}
+		}
+	}
+
+	memcpy(pMatrix, pInverse, n * n);
+
+	return TRUE;
+}
+
+void CReedSolomon::MulAdd(BYTE* pDest, const BYTE* pSrc, BYTE c, int iSize)
+{
+	if(c == 0)
+		return;
+
+	if(c == 1)
+	{
+		for(int i = 0; i < iSize; i++)
+			pDest[i] ^= pSrc[i];
+	}
+	else
+	{
+		const BYTE* pMul = s_gf.mul[c];
+
+		for(int i = 0; i < iSize; i++)
+			pDest[i] ^= pMul[pSrc[i]];
+	}
+}
@@ -0,0 +1,80 @@
+﻿/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+/******************************************************************************
+Module:  ReedSolomon.h
+Notices: Copyright (c) 2013 Bruce Liang
+Purpose: GF(2^8) 上的系统 Reed-Solomon 纠删码
+Desc:
+		1. 校验矩阵采用 Cauchy 矩阵，任意 DataShards 个分片即可恢复全部数据分片
+		2. 数据分片可少于 DataShards 个（不足部分视为全零分片），用于提前封组
+		3. 所有分片长度必须一致，较短的数据分片需先以 0 补齐
+******************************************************************************/
+
+#pragma once
+
+class CReedSolomon
+{
+public:
+	/* 初始化编码器：iDataShards + iParityShards 不能超过 MAX_SHARDS */
+	BOOL Init(int iDataShards, int iParityShards);
+	void Reset();
+
+	/* 根据前 iDataCount 个数据分片计算全部校验分片 */
+	void Encode(const BYTE* const pData[], int iDataCount, BYTE* const pParity[], int iSize);
+
+	/*
+	* 恢复缺失的数据分片
+	* 
+	*	pShards		-- 分片数组（前 DataShards 个为数据分片，其后为校验分片），缺失数据分片的缓冲区用于写入恢复结果
+	*	bPresent	-- 分片是否有效
+	*	iDataCount	-- 本组实际数据分片数量（其余数据分片视为全零分片）
+	*	iSize		-- 分片长度
+	* 
+	* 返回值：有效分片不足时返回 FALSE
+	*/
+	BOOL Reconstruct(BYTE* const pShards[], const BOOL bPresent[], int iDataCount, int iSize);
+
+	int GetDataShards()		const	{return m_iDataShards;}
+	int GetParityShards()	const	{return m_iParityShards;}
+	BOOL IsValid()			const	{return m_pMatrix != nullptr;}
+
+private:
+	BOOL InvertMatrix(BYTE* pMatrix, int n);
+
+	static void MulAdd(BYTE* pDest, const BYTE* pSrc, BYTE c, int iSize);
+
+public:
+	CReedSolomon();
+	~CReedSolomon();
+
+	DECLARE_NO_COPY_CLASS(CReedSolomon)
+
+public:
+	static const int MAX_SHARDS = 128;
+
+private:
+	int		m_iDataShards;
+	int		m_iParityShards;
+	BYTE*	m_pMatrix;	// 校验矩阵（ParityShards x DataShards）
+};
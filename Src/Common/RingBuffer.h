@@ -26,6 +26,7 @@
 #include "RWLock.h"
 #include "STLHelper.h"
 #include "CriticalSection.h"
+#include "SysHelper.h"
 
 #define CACHE_LINE		64
 #define PACK_SIZE_OF(T)	(CACHE_LINE - sizeof(T) % CACHE_LINE)
@@ -1117,6 +1118,383 @@ template <class T, class index_type, bool adjust_index> DWORD const CRingCache2<
 																																	;
 // ------------------------------------------------------------------------------------------------------------- //
 
+/*
+	代际槽位表：索引 = ((代数 << 槽位位数) | 槽位) + 1。
+	查找只需一次数组寻址加一次代数比较；空闲槽位按 CPU 分片管理，分配与回收不竞争同一个共享计数器。
+*/
+template <class T, class index_type = ULONG_PTR> class CSlotMap
+{
+public:
+
+	enum EnGetResult {GR_FAIL = -1, GR_INVALID = 0, GR_VALID = 1};
+
+	typedef T*			TPTR;
+	typedef volatile T*	VTPTR;
+
+	static TPTR const E_EMPTY;
+	static TPTR const E_LOCKED;
+	static TPTR const E_MAX_STATUS;
+	static DWORD const MAX_SIZE;
+
+	static_assert(sizeof(index_type) == sizeof(PVOID), "CSlotMap index_type must be pointer sized");
+
+private:
+
+	struct TSlot
+	{
+		VTPTR					value;
+		volatile index_type		index;
+	};
+
+	/* 空闲槽位按先进先出顺序重用，使同一槽位的索引尽量晚地重复出现 */
+	struct TShard
+	{
+		CSpinGuard		cs;
+		deque<DWORD>	slots;
+	};
+
+	index_type MAKE_INDEX(index_type gen, DWORD dwSlot)	const	{return ((gen << m_dwShift) | dwSlot) + 1;}
+	DWORD INDEX_SLOT(index_type dwIndex)				const	{return (DWORD)((dwIndex - 1) & m_dwMask);}
+
+	index_type NEXT_INDEX(index_type dwIndex) const
+	{
+		index_type dwNext = dwIndex + ((index_type)1 << m_dwShift);
+
+		// 代数回绕到 0 号索引时跳过
+		if(dwNext == 0)
+			dwNext += ((index_type)1 << m_dwShift);
+
+		return dwNext;
+	}
+
+public:
+
+	BOOL Put(TPTR pElement, index_type& dwIndex)
+	{
+		ASSERT(pElement != nullptr);
+
+		if(!IsValid()) return FALSE;
+
+		DWORD dwSlot;
+
+		if(!PopSlot(dwSlot))
+			return FALSE;
+
+		TSlot& slot	= m_pSlots[dwSlot];
+		dwIndex		= slot.index;
+		slot.value	= pElement;
+
+		::InterlockedIncrement(&m_dwCount);
+
+		if(pElement != E_LOCKED)
+			::InterlockedIncrement(&m_dwElements);
+
+		return TRUE;
+	}
+
+	EnGetResult Get(index_type dwIndex, TPTR* ppElement)
+	{
+		ASSERT(ppElement != nullptr);
+
+		*ppElement = nullptr;
+
+		if(!IsValid() || dwIndex == 0)
+			return GR_FAIL;
+
+		DWORD dwSlot = INDEX_SLOT(dwIndex);
+
+		if(dwSlot >= m_dwSize)
+			return GR_FAIL;
+
+		TSlot& slot = m_pSlots[dwSlot];
+
+		if(slot.index != dwIndex)
+			return GR_FAIL;
+
+		TPTR pElement = (TPTR)slot.value;
+
+		// 读取期间槽位被回收重用则索引已变化
+		if(slot.index != dwIndex)
+			return GR_FAIL;
+
+		*ppElement = pElement;
+
+		return IsValidElement(pElement) ? GR_VALID : GR_INVALID;
+	}
+
+	BOOL Set(index_type dwIndex, TPTR pElement, TPTR* ppOldElement = nullptr)
+	{
+		TPTR pElement2 = nullptr;
+
+		if(Get(dwIndex, &pElement2) == GR_FAIL)
+			return FALSE;
+
+		if(ppOldElement != nullptr)
+			*ppOldElement = pElement2;
+
+		if(pElement == pElement2)
+			return FALSE;
+
+		DWORD dwSlot = INDEX_SLOT(dwIndex);
+		TSlot& slot	 = m_pSlots[dwSlot];
+
+		if(pElement == E_EMPTY)
+		{
+			// 先推进代数使旧索引失效，只有一个线程能够成功回收
+			if(::InterlockedCompareExchangePointer((volatile PVOID*)&slot.index, (PVOID)NEXT_INDEX(dwIndex), (PVOID)dwIndex) != (PVOID)dwIndex)
+				return FALSE;
+
+			slot.value = E_EMPTY;
+
+			if(pElement2 != E_LOCKED)
+				::InterlockedDecrement(&m_dwElements);
+
+			::InterlockedDecrement(&m_dwCount);
+
+			PushSlot(dwSlot);
+		}
+		else
+		{
+			slot.value = pElement;
+
+			if(pElement2 == E_LOCKED && pElement != E_LOCKED)
+				::InterlockedIncrement(&m_dwElements);
+			else if(pElement2 != E_LOCKED && pElement == E_LOCKED)
+				::InterlockedDecrement(&m_dwElements);
+		}
+
+		return TRUE;
+	}
+
+	BOOL Remove(index_type dwIndex, TPTR* ppElement = nullptr)
+	{
+		return Set(dwIndex, E_EMPTY, ppElement);
+	}
+
+	BOOL AcquireLock(index_type& dwIndex)
+	{
+		return Put(E_LOCKED, dwIndex);
+	}
+
+	BOOL ReleaseLock(index_type dwIndex, TPTR pElement)
+	{
+		ASSERT(pElement == nullptr || IsValidElement(pElement));
+
+		TPTR pElement2 = nullptr;
+		Get(dwIndex, &pElement2);
+
+		ASSERT(pElement2 == E_LOCKED);
+
+		if(pElement2 != E_LOCKED)
+			return FALSE;
+
+		return Set(dwIndex, pElement);
+	}
+
+public:
+
+	void Reset(DWORD dwSize = 0)
+	{
+		if(IsValid())
+			Destroy();
+		if(dwSize > 0)
+			Create(dwSize);
+	}
+
+	BOOL GetAllElementIndexes(index_type ids[], DWORD& dwCount, BOOL bCopy = TRUE)
+	{
+		if(ids == nullptr || dwCount == 0)
+		{
+			dwCount = Elements();
+			return FALSE;
+		}
+
+		vector<index_type> indexes;
+		CopyIndexes(indexes);
+
+		BOOL isOK	 = FALSE;
+		DWORD dwSize = (DWORD)indexes.size();
+
+		if(dwSize > 0 && dwSize <= dwCount)
+		{
+			for(DWORD i = 0; i < dwSize; i++)
+				ids[i] = indexes[i];
+
+			isOK = TRUE;
+		}
+
+		dwCount = dwSize;
+
+		return isOK;
+	}
+
+	unique_ptr<index_type[]> GetAllElementIndexes(DWORD& dwCount, BOOL bCopy = TRUE)
+	{
+		vector<index_type> indexes;
+		CopyIndexes(indexes);
+
+		unique_ptr<index_type[]> ids;
+		dwCount = (DWORD)indexes.size();
+
+		if(dwCount > 0)
+		{
+			ids.reset(new index_type[dwCount]);
+
+			for(DWORD i = 0; i < dwCount; i++)
+				ids[i] = indexes[i];
+		}
+
+		return ids;
+	}
+
+	static BOOL IsValidElement(TPTR pElement) {return pElement > E_MAX_STATUS;}
+
+	DWORD Size		()	{return m_dwSize;}
+	DWORD Elements	()	{return m_dwElements;}
+	DWORD Spaces	()	{return m_dwSize - m_dwCount;}
+	BOOL HasSpace	()	{return m_dwCount < m_dwSize;}
+	BOOL IsEmpty	()	{return m_dwCount == 0;}
+	BOOL IsValid	()	{return m_pSlots != nullptr;}
+
+private:
+
+	BOOL PopSlot(DWORD& dwSlot)
+	{
+		DWORD dwCurrent = m_shSlots.GetCurrentIndex();
+
+		for(DWORD i = 0, dwCount = m_shSlots.GetCount(); i < dwCount; i++)
+		{
+			TShard& shard = m_shSlots[m_shSlots.GetIndex(dwCurrent + i)];
+
+			if(shard.slots.empty())
+				continue;
+
+			CSpinLock locallock(shard.cs);
+
+			if(!shard.slots.empty())
+			{
+				dwSlot = shard.slots.front();
+				shard.slots.pop_front();
+
+				return TRUE;
+			}
+		}
+
+		return FALSE;
+	}
+
+	void PushSlot(DWORD dwSlot)
+	{
+		TShard& shard = m_shSlots.Current();
+
+		CSpinLock locallock(shard.cs);
+		shard.slots.push_back(dwSlot);
+	}
+
+	void CopyIndexes(vector<index_type>& indexes)
+	{
+		indexes.reserve(m_dwElements);
+
+		for(DWORD i = 0; i < m_dwSize; i++)
+		{
+			index_type dwIndex	= m_pSlots[i].index;
+			TPTR pElement		= nullptr;
+
+			if(Get(dwIndex, &pElement) == GR_VALID)
+				indexes.push_back(dwIndex);
+		}
+	}
+
+	void Create(DWORD dwSize)
+	{
+		ASSERT(!IsValid() && dwSize > 0 && dwSize <= MAX_SIZE);
+
+		m_dwShift = 0;
+
+		while(((DWORD)1 << m_dwShift) < dwSize)
+			++m_dwShift;
+
+		m_dwSize		= dwSize;
+		m_dwMask		= ((DWORD)1 << m_dwShift) - 1;
+		m_dwCount		= 0;
+		m_dwElements	= 0;
+		m_pSlots		= (TSlot*)malloc(m_dwSize * sizeof(TSlot));
+
+		m_shSlots.Create();
+
+		for(DWORD dwSlot = 0; dwSlot < m_dwSize; dwSlot++)
+		{
+			m_pSlots[dwSlot].value = E_EMPTY;
+			m_pSlots[dwSlot].index = MAKE_INDEX(0, dwSlot);
+
+			m_shSlots[m_shSlots.GetIndex(dwSlot)].slots.push_back(dwSlot);
+		}
+	}
+
+	void Destroy()
+	{
+		ASSERT(IsValid());
+
+		free((void*)m_pSlots);
+		m_shSlots.Destroy();
+
+		m_pSlots		= nullptr;
+		m_dwSize		= 0;
+		m_dwMask		= 0;
+		m_dwShift		= 0;
+		m_dwCount		= 0;
+		m_dwElements	= 0;
+	}
+
+public:
+	CSlotMap	(DWORD dwSize = 0)
+	: m_pSlots		(nullptr)
+	, m_dwSize		(0)
+	, m_dwMask		(0)
+	, m_dwShift		(0)
+	, m_dwCount		(0)
+	, m_dwElements	(0)
+	{
+		Reset(dwSize);
+	}
+
+	~CSlotMap()
+	{
+		Reset(0);
+	}
+
+private:
+	CSlotMap(const CSlotMap&);
+	CSlotMap operator = (const CSlotMap&);
+
+private:
+	TSlot*				m_pSlots;
+	CCpuShards<TShard>	m_shSlots;
+	DWORD				m_dwSize;
+	DWORD				m_dwMask;
+	DWORD				m_dwShift;
+	char				pack1[PACK_SIZE_OF(DWORD)];
+	volatile DWORD		m_dwCount;
+	char				pack2[PACK_SIZE_OF(DWORD)];
+	volatile DWORD		m_dwElements;
+	char				pack3[PACK_SIZE_OF(DWORD)];
+};
+
+template <class T, class index_type> T* const CSlotMap<T, index_type>::E_EMPTY		= (T*)0x00;
+template <class T, class index_type> T* const CSlotMap<T, index_type>::E_LOCKED		= (T*)0x01;
+template <class T, class index_type> T* const CSlotMap<T, index_type>::E_MAX_STATUS	= (T*)0x0F;
+
+/* 32 位平台的索引至少保留 12 位代数，避免槽位频繁重用时索引过快重复 */
+template <class T, class index_type> DWORD const CSlotMap<T, index_type>::MAX_SIZE		= 
+#if !defined(_WIN64)
+																						  0x000FFFFF
+#else
+																						  0x7FFFFFFF
+#endif
+																									;
+
+// ------------------------------------------------------------------------------------------------------------- //
+
 template <class T> class CRingPool
 {
 private:
@@ -62,3 +62,19 @@ DWORD SysGetPageSize()
 
 	return si.dwPageSize;
 }
+
+DWORD SysGetCpuShardCount(DWORD dwMaxShards)
+{
+	static const DWORD s_dwCPUs = ::SysGetNumberOfProcessors();
+
+	DWORD dwShards = 1;
+	DWORD dwCPUs   = (dwMaxShards > 0) ? min(s_dwCPUs, dwMaxShards) : s_dwCPUs;
+
+	while(dwShards < dwCPUs)
+		dwShards <<= 1;
+
+	while(dwMaxShards > 0 && dwShards > dwMaxShards)
+		dwShards >>= 1;
+
+	return dwShards;
+}
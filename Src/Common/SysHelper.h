@@ -39,6 +39,10 @@ typedef DWORD							TID, THR_ID, NTHR_ID, PID, PRO_ID;
 #define DEFAULT_BUFFER_CACHE_POOL_SIZE	1024
 /* 默认内存块缓存池回收阀值 */
 #define DEFAULT_BUFFER_CACHE_POOL_HOLD	1024
+/* 默认内存块本地缓存高水位 */
+#define DEFAULT_BUFFER_CACHE_LOCAL_HIGH	64
+/* 默认内存块本地缓存低水位 */
+#define DEFAULT_BUFFER_CACHE_LOCAL_LOW	16
 
 #define SYS_PAGE_SIZE					(GetSysPageSize())
 #define DEFAULT_WORKER_THREAD_COUNT		(GetDefaultWorkerThreadCount())
@@ -58,3 +62,58 @@ VOID SysGetSystemInfo(LPSYSTEM_INFO pInfo);
 DWORD SysGetNumberOfProcessors();
 // 获取页面大小
 DWORD SysGetPageSize();
+// 获取按 CPU 分片的分片数量（CPU 核数向上取整为 2 的幂，dwMaxShards 不为 0 时不超过 dwMaxShards）
+DWORD SysGetCpuShardCount(DWORD dwMaxShards = 0);
+
+/************************************************************************
+名称：CPU 分片数组
+描述：分片数量由 SysGetCpuShardCount() 决定，按当前处理器编号选择分片。
+	  分片对象以值初始化方式创建，分片内的同步由调用者负责
+************************************************************************/
+template<class T> class CCpuShards
+{
+public:
+	void Create(DWORD dwMaxShards = 0)
+	{
+		ASSERT(!IsValid());
+
+		DWORD dwCount = ::SysGetCpuShardCount(dwMaxShards);
+
+		m_pShards	= new T[dwCount]();
+		m_dwMask	= dwCount - 1;
+	}
+
+	void Destroy()
+	{
+		delete[] m_pShards;
+
+		m_pShards	= nullptr;
+		m_dwMask	= 0;
+	}
+
+	T& Current()						{return m_pShards[GetCurrentIndex()];}
+	T& operator [] (DWORD dwIndex)		{ASSERT(dwIndex <= m_dwMask); return m_pShards[dwIndex];}
+
+	DWORD GetCurrentIndex()		const	{return ::GetCurrentProcessorNumber() & m_dwMask;}
+	DWORD GetIndex(DWORD dwKey)	const	{return dwKey & m_dwMask;}
+	DWORD GetCount()			const	{return IsValid() ? m_dwMask + 1 : 0;}
+	BOOL IsValid()				const	{return m_pShards != nullptr;}
+
+public:
+	CCpuShards(BOOL bCreate = FALSE, DWORD dwMaxShards = 0)
+	: m_pShards	(nullptr)
+	, m_dwMask	(0)
+	{
+		if(bCreate) Create(dwMaxShards);
+	}
+
+	~CCpuShards() {Destroy();}
+
+private:
+	CCpuShards(const CCpuShards&);
+	CCpuShards operator = (const CCpuShards&);
+
+private:
+	T*		m_pShards;
+	DWORD	m_dwMask;
+};
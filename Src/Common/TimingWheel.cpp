@@ -0,0 +1,236 @@
+﻿/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+/******************************************************************************
+Module:  TimingWheel.cpp
+Notices: Copyright (c) 2013 Bruce Liang
+Purpose: 分层时间轮
+Desc:
+******************************************************************************/
+
+#include "stdafx.h"
+#include "TimingWheel.h"
+#include "WaitFor.h"
+
+const DWORD CTimingWheel::DEFAULT_TICK = 100;
+
+CTimingWheel::CTimingWheel(DWORD dwTick)
+: m_dwTick		(dwTick)
+, m_dwTickTime	(::TimeGetTime())
+, m_dwCurTick	(0)
+, m_dwSize		(0)
+{
+	ASSERT(m_dwTick > 0);
+
+	for(int i = 0; i < LEVEL_COUNT; i++)
+	{
+		for(int j = 0; j < LEVEL_SIZE; j++)
+			m_slots[i][j].prev = m_slots[i][j].next = &m_slots[i][j];
+	}
+}
+
+CTimingWheel::~CTimingWheel()
+{
+	Clear();
+}
+
+void CTimingWheel::Schedule(TTimerNode* pNode, DWORD dwDelay)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(pNode->IsPending())
+		Unlink(pNode);
+	else
+		++m_dwSize;
+
+	pNode->expire = m_dwCurTick + (dwDelay + m_dwTick - 1) / m_dwTick;
+
+	Insert(pNode);
+}
+
+BOOL CTimingWheel::Cancel(TTimerNode* pNode)
+{
+	CCriSecLock locallock(m_cs);
+
+	if(!pNode->IsPending())
+		return FALSE;
+
+	Unlink(pNode);
+	--m_dwSize;
+
+	return TRUE;
+}
+
+DWORD CTimingWheel::Advance(Fn_ExpireProc fnExpire, PVOID pv, DWORD dwCurrent)
+{
+	if(dwCurrent == 0)
+		dwCurrent = ::TimeGetTime();
+
+	DWORD dwExpired = 0;
+
+	CCriSecLock locallock(m_cs);
+
+	DWORD dwTicks = ::GetTimeGap32(m_dwTickTime, dwCurrent) / m_dwTick;
+	m_dwTickTime += dwTicks * m_dwTick;
+
+	for(; dwTicks > 0; --dwTicks)
+	{
+		int idx = (int)(m_dwCurTick & LEVEL_MASK);
+
+		if(idx == 0)
+			Cascade();
+
+		TTimerNode lsExpired;
+		Splice(&m_slots[0][idx], &lsExpired);
+
+		/* 先推进当前刻度，回调中重新挂载的节点不会落回正在处理的槽 */
+		++m_dwCurTick;
+
+		while(lsExpired.next != &lsExpired)
+		{
+			TTimerNode* pNode = lsExpired.next;
+
+			Unlink(pNode);
+			--m_dwSize;
+			++dwExpired;
+
+			DWORD dwDelay = fnExpire(pNode, pv);
+
+			if(dwDelay != 0 && !pNode->IsPending())
+			{
+				pNode->expire = m_dwCurTick + (dwDelay + m_dwTick - 1) / m_dwTick - 1;
+
+				Insert(pNode);
+				++m_dwSize;
+			}
+		}
+	}
+
+	return dwExpired;
+}
+
+void CTimingWheel::Reset(DWORD dwTick)
+{
+	CCriSecLock locallock(m_cs);
+
+	Clear();
+
+	if(dwTick != 0)
+		m_dwTick = dwTick;
+
+	m_dwTickTime	= ::TimeGetTime();
+	m_dwCurTick		= 0;
+}
+
+void CTimingWheel::Insert(TTimerNode* pNode)
+{
+	DWORD dwGap = pNode->expire - m_dwCurTick;
+
+	if((int)dwGap < 0)
+	{
+		Link(&m_slots[0][m_dwCurTick & LEVEL_MASK], pNode);
+		return;
+	}
+
+	if(dwGap > MAX_TICKS)
+	{
+		dwGap			= MAX_TICKS;
+		pNode->expire	= m_dwCurTick + MAX_TICKS;
+	}
+
+	int iLevel = 0;
+
+	while(dwGap >= (1UL << (LEVEL_BITS * (iLevel + 1))))
+		++iLevel;
+
+	Link(&m_slots[iLevel][(pNode->expire >> (LEVEL_BITS * iLevel)) & LEVEL_MASK], pNode);
+}
+
+void CTimingWheel::Cascade()
+{
+	for(int i = 1; i < LEVEL_COUNT; i++)
+	{
+		int idx = (int)((m_dwCurTick >> (LEVEL_BITS * i)) & LEVEL_MASK);
+
+		TTimerNode lsCascade;
+		Splice(&m_slots[i][idx], &lsCascade);
+
+		while(lsCascade.next != &lsCascade)
+		{
+			TTimerNode* pNode = lsCascade.next;
+
+			Unlink(pNode);
+			Insert(pNode);
+		}
+
+		if(idx != 0)
+			break;
+	}
+}
+
+void CTimingWheel::Clear()
+{
+	for(int i = 0; i < LEVEL_COUNT; i++)
+	{
+		for(int j = 0; j < LEVEL_SIZE; j++)
+		{
+			TTimerNode* pHead = &m_slots[i][j];
+
+			while(pHead->next != pHead)
+				Unlink(pHead->next);
+		}
+	}
+
+	m_dwSize = 0;
+}
+
+void CTimingWheel::Link(TTimerNode* pHead, TTimerNode* pNode)
+{
+	pNode->prev			= pHead->prev;
+	pNode->next			= pHead;
+	pHead->prev->next	= pNode;
+	pHead->prev			= pNode;
+}
+
+void CTimingWheel::Unlink(TTimerNode* pNode)
+{
+	pNode->prev->next	= pNode->next;
+	pNode->next->prev	= pNode->prev;
+	pNode->prev			= nullptr;
+	pNode->next			= nullptr;
+}
+
+void CTimingWheel::Splice(TTimerNode* pHead, TTimerNode* pList)
+{
+	if(pHead->next == pHead)
+	{
+		pList->prev = pList->next = pList;
+		return;
+	}
+
+	pList->next			= pHead->next;
+	pList->prev			= pHead->prev;
+	pList->next->prev	= pList;
+	pList->prev->next	= pList;
+	pHead->prev			= pHead->next = pHead;
+}
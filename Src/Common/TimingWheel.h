@@ -0,0 +1,101 @@
+﻿/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+/******************************************************************************
+Module:  TimingWheel.h
+Notices: Copyright (c) 2013 Bruce Liang
+Purpose: 分层时间轮
+Desc:
+		1. 定时节点以侵入方式嵌入宿主对象，挂载 / 取消均为 O(1)
+		2. 每次推进只处理到期节点及需要下沉的节点，与节点总数无关
+		3. 到期回调在时间轮锁内执行，可在回调中调用 Schedule() / Cancel()
+******************************************************************************/
+
+#pragma once
+
+#include "CriticalSection.h"
+
+/* 时间轮定时节点 */
+struct TTimerNode
+{
+	TTimerNode*	prev;
+	TTimerNode*	next;
+	DWORD		expire;
+
+	BOOL IsPending() const	{return next != nullptr;}
+	void Reset()			{prev = next = nullptr; expire = 0;}
+
+	TTimerNode() {Reset();}
+};
+
+class CTimingWheel
+{
+public:
+	/* 到期回调：返回下一次到期的延迟时间（毫秒），返回 0 则不再重新挂载 */
+	typedef DWORD (*Fn_ExpireProc)(TTimerNode* pNode, PVOID pv);
+
+public:
+	void Schedule	(TTimerNode* pNode, DWORD dwDelay);
+	BOOL Cancel		(TTimerNode* pNode);
+	DWORD Advance	(Fn_ExpireProc fnExpire, PVOID pv, DWORD dwCurrent = 0);
+	void Reset		(DWORD dwTick = 0);
+
+	DWORD GetTick	()	const	{return m_dwTick;}
+	DWORD GetSize	()	const	{return m_dwSize;}
+	BOOL IsEmpty	()	const	{return m_dwSize == 0;}
+
+private:
+	void Insert		(TTimerNode* pNode);
+	void Cascade	();
+	void Clear		();
+
+	static void Link	(TTimerNode* pHead, TTimerNode* pNode);
+	static void Unlink	(TTimerNode* pNode);
+	static void Splice	(TTimerNode* pHead, TTimerNode* pList);
+
+public:
+	CTimingWheel(DWORD dwTick = DEFAULT_TICK);
+	~CTimingWheel();
+
+	DECLARE_NO_COPY_CLASS(CTimingWheel)
+
+public:
+	static const DWORD DEFAULT_TICK;
+
+private:
+	static const int	LEVEL_BITS	= 6;
+	static const int	LEVEL_SIZE	= 1 << LEVEL_BITS;
+	static const int	LEVEL_MASK	= LEVEL_SIZE - 1;
+	static const int	LEVEL_COUNT	= 4;
+	static const DWORD	MAX_TICKS	= (1UL << (LEVEL_BITS * LEVEL_COUNT)) - 1;
+
+private:
+	CCriSec		m_cs;
+
+	DWORD		m_dwTick;
+	DWORD		m_dwTickTime;
+	DWORD		m_dwCurTick;
+	DWORD		m_dwSize;
+
+	TTimerNode	m_slots[LEVEL_COUNT][LEVEL_SIZE];
+};
@@ -173,16 +173,31 @@ void ikcp_allocator(void* (*new_malloc)(size_t), void (*new_free)(void*))
 	ikcp_free_hook = new_free;
 }
 
+// redefine segment allocator of a kcp
+void ikcp_segment_allocator(ikcpcb *kcp, IKCPSEG* (*new_segment)(ikcpcb*, int, void*),
+	void (*delete_segment)(ikcpcb*, IKCPSEG*, void*), void *pool)
+{
+	kcp->segment_new = new_segment;
+	kcp->segment_delete = delete_segment;
+	kcp->segment_pool = pool;
+}
+
 // allocate a new kcp segment
 static IKCPSEG* ikcp_segment_new(ikcpcb *kcp, int size)
 {
+	if (kcp->segment_new)
+		return kcp->segment_new(kcp, size, kcp->segment_pool);
 	return (IKCPSEG*)ikcp_malloc(sizeof(IKCPSEG) + size);
 }
 
 // delete a segment
 static void ikcp_segment_delete(ikcpcb *kcp, IKCPSEG *seg)
 {
-	ikcp_free(seg);
+	if (kcp->segment_delete) {
+		kcp->segment_delete(kcp, seg, kcp->segment_pool);
+	} else {
+		ikcp_free(seg);
+	}
 }
 
 // write log
@@ -294,6 +309,9 @@ ikcpcb* ikcp_create(IUINT32 conv, void *user)
 	kcp->dead_link = IKCP_DEADLINK;
 	kcp->output = NULL;
 	kcp->writelog = NULL;
+	kcp->segment_new = NULL;
+	kcp->segment_delete = NULL;
+	kcp->segment_pool = NULL;
 
 	return kcp;
 }
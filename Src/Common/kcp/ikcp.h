@@ -314,6 +314,9 @@ struct IKCPCB
 	int logmask;
 	int (*output)(const char *buf, int len, struct IKCPCB *kcp, void *user);
 	void (*writelog)(const char *log, struct IKCPCB *kcp, void *user);
+	struct IKCPSEG* (*segment_new)(struct IKCPCB *kcp, int size, void *pool);
+	void (*segment_delete)(struct IKCPCB *kcp, struct IKCPSEG *seg, void *pool);
+	void *segment_pool;
 };
 
 
@@ -403,6 +406,10 @@ void ikcp_log(ikcpcb *kcp, int mask, const char *fmt, ...);
 // setup allocator
 void ikcp_allocator(void* (*new_malloc)(size_t), void (*new_free)(void*));
 
+// setup per-kcp segment allocator, 'pool' is passed back to the hooks
+void ikcp_segment_allocator(ikcpcb *kcp, struct IKCPSEG* (*new_segment)(ikcpcb*, int, void*),
+	void (*delete_segment)(ikcpcb*, struct IKCPSEG*, void*), void *pool);
+
 // read conv
 IUINT32 ikcp_getconv(const void *ptr);
 
@@ -32,6 +32,9 @@
 #include "TcpPackServer.h"
 #include "TcpPackClient.h"
 #include "TcpPackAgent.h"
+#include "TcpFramedServer.h"
+#include "TcpFramedClient.h"
+#include "TcpFramedAgent.h"
 #include "HPThreadPool.h"
 
 #ifdef _UDP_SUPPORT
@@ -98,6 +101,21 @@ HPSOCKET_API ITcpPackClient* HP_Create_TcpPackClient(ITcpClientListener* pListen
 	return (ITcpPackClient*)(new CTcpPackClient(pListener));
 }
 
+HPSOCKET_API ITcpFramedServer* HP_Create_TcpFramedServer(ITcpServerListener* pListener)
+{
+	return (ITcpFramedServer*)(new CTcpFramedServer(pListener));
+}
+
+HPSOCKET_API ITcpFramedAgent* HP_Create_TcpFramedAgent(ITcpAgentListener* pListener)
+{
+	return (ITcpFramedAgent*)(new CTcpFramedAgent(pListener));
+}
+
+HPSOCKET_API ITcpFramedClient* HP_Create_TcpFramedClient(ITcpClientListener* pListener)
+{
+	return (ITcpFramedClient*)(new CTcpFramedClient(pListener));
+}
+
 HPSOCKET_API void HP_Destroy_TcpServer(ITcpServer* pServer)
 {
 	delete pServer;
@@ -143,6 +161,21 @@ HPSOCKET_API void HP_Destroy_TcpPackClient(ITcpPackClient* pClient)
 	delete pClient;
 }
 
+HPSOCKET_API void HP_Destroy_TcpFramedServer(ITcpFramedServer* pServer)
+{
+	delete pServer;
+}
+
+HPSOCKET_API void HP_Destroy_TcpFramedAgent(ITcpFramedAgent* pAgent)
+{
+	delete pAgent;
+}
+
+HPSOCKET_API void HP_Destroy_TcpFramedClient(ITcpFramedClient* pClient)
+{
+	delete pClient;
+}
+
 #ifdef _UDP_SUPPORT
 
 HPSOCKET_API IUdpServer* HP_Create_UdpServer(IUdpServerListener* pListener)
@@ -32,6 +32,9 @@
 #include "TcpPackServer.h"
 #include "TcpPackClient.h"
 #include "TcpPackAgent.h"
+#include "TcpFramedServer.h"
+#include "TcpFramedClient.h"
+#include "TcpFramedAgent.h"
 
 #ifdef _UDP_SUPPORT
 #include "UdpServer.h"
@@ -56,6 +59,12 @@
 	#pragma comment(linker, "/EXPORT:Create_HP_TcpAgentListener=_Create_HP_TcpAgentListener@0")
 	#pragma comment(linker, "/EXPORT:Create_HP_TcpClient=_Create_HP_TcpClient@4")
 	#pragma comment(linker, "/EXPORT:Create_HP_TcpClientListener=_Create_HP_TcpClientListener@0")
+	#pragma comment(linker, "/EXPORT:Create_HP_TcpFramedAgent=_Create_HP_TcpFramedAgent@4")
+	#pragma comment(linker, "/EXPORT:Create_HP_TcpFramedAgentListener=_Create_HP_TcpFramedAgentListener@0")
+	#pragma comment(linker, "/EXPORT:Create_HP_TcpFramedClient=_Create_HP_TcpFramedClient@4")
+	#pragma comment(linker, "/EXPORT:Create_HP_TcpFramedClientListener=_Create_HP_TcpFramedClientListener@0")
+	#pragma comment(linker, "/EXPORT:Create_HP_TcpFramedServer=_Create_HP_TcpFramedServer@4")
+	#pragma comment(linker, "/EXPORT:Create_HP_TcpFramedServerListener=_Create_HP_TcpFramedServerListener@0")
 	#pragma comment(linker, "/EXPORT:Create_HP_TcpPackAgent=_Create_HP_TcpPackAgent@4")
 	#pragma comment(linker, "/EXPORT:Create_HP_TcpPackAgentListener=_Create_HP_TcpPackAgentListener@0")
 	#pragma comment(linker, "/EXPORT:Create_HP_TcpPackClient=_Create_HP_TcpPackClient@4")
@@ -74,6 +83,12 @@
 	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpAgentListener=_Destroy_HP_TcpAgentListener@4")
 	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpClient=_Destroy_HP_TcpClient@4")
 	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpClientListener=_Destroy_HP_TcpClientListener@4")
+	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpFramedAgent=_Destroy_HP_TcpFramedAgent@4")
+	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpFramedAgentListener=_Destroy_HP_TcpFramedAgentListener@4")
+	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpFramedClient=_Destroy_HP_TcpFramedClient@4")
+	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpFramedClientListener=_Destroy_HP_TcpFramedClientListener@4")
+	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpFramedServer=_Destroy_HP_TcpFramedServer@4")
+	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpFramedServerListener=_Destroy_HP_TcpFramedServerListener@4")
 	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpPackAgent=_Destroy_HP_TcpPackAgent@4")
 	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpPackAgentListener=_Destroy_HP_TcpPackAgentListener@4")
 	#pragma comment(linker, "/EXPORT:Destroy_HP_TcpPackClient=_Destroy_HP_TcpPackClient@4")
@@ -244,14 +259,17 @@
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_Server_OnPullReceive=_HP_Set_FN_Server_OnPullReceive@8")
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_Server_OnReceive=_HP_Set_FN_Server_OnReceive@8")
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_Server_OnSend=_HP_Set_FN_Server_OnSend@8")
+	#pragma comment(linker, "/EXPORT:HP_Set_FN_Server_OnSendWatermark=_HP_Set_FN_Server_OnSendWatermark@8")
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_Server_OnShutdown=_HP_Set_FN_Server_OnShutdown@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpAgent_GetKeepAliveInterval=_HP_TcpAgent_GetKeepAliveInterval@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpAgent_GetKeepAliveTime=_HP_TcpAgent_GetKeepAliveTime@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpAgent_GetSocketBufferSize=_HP_TcpAgent_GetSocketBufferSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpAgent_IsZeroByteReceive=_HP_TcpAgent_IsZeroByteReceive@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpAgent_SendSmallFile=_HP_TcpAgent_SendSmallFile@20")
 	#pragma comment(linker, "/EXPORT:HP_TcpAgent_SetKeepAliveInterval=_HP_TcpAgent_SetKeepAliveInterval@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpAgent_SetKeepAliveTime=_HP_TcpAgent_SetKeepAliveTime@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpAgent_SetSocketBufferSize=_HP_TcpAgent_SetSocketBufferSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpAgent_SetZeroByteReceive=_HP_TcpAgent_SetZeroByteReceive@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpClient_GetKeepAliveInterval=_HP_TcpClient_GetKeepAliveInterval@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpClient_GetKeepAliveTime=_HP_TcpClient_GetKeepAliveTime@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpClient_GetSocketBufferSize=_HP_TcpClient_GetSocketBufferSize@4")
@@ -259,6 +277,48 @@
 	#pragma comment(linker, "/EXPORT:HP_TcpClient_SetKeepAliveInterval=_HP_TcpClient_SetKeepAliveInterval@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpClient_SetKeepAliveTime=_HP_TcpClient_SetKeepAliveTime@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpClient_SetSocketBufferSize=_HP_TcpClient_SetSocketBufferSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_GetFrameHeaderSize=_HP_TcpFramedAgent_GetFrameHeaderSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_GetLengthAdjustment=_HP_TcpFramedAgent_GetLengthAdjustment@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_GetLengthFieldOffset=_HP_TcpFramedAgent_GetLengthFieldOffset@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_GetLengthFieldSize=_HP_TcpFramedAgent_GetLengthFieldSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_GetMaxFrameSize=_HP_TcpFramedAgent_GetMaxFrameSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_IsLengthFieldBigEndian=_HP_TcpFramedAgent_IsLengthFieldBigEndian@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_IsLengthIncludeHeader=_HP_TcpFramedAgent_IsLengthIncludeHeader@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_SetFrameHeaderSize=_HP_TcpFramedAgent_SetFrameHeaderSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_SetLengthAdjustment=_HP_TcpFramedAgent_SetLengthAdjustment@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_SetLengthFieldBigEndian=_HP_TcpFramedAgent_SetLengthFieldBigEndian@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_SetLengthFieldOffset=_HP_TcpFramedAgent_SetLengthFieldOffset@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_SetLengthFieldSize=_HP_TcpFramedAgent_SetLengthFieldSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_SetLengthIncludeHeader=_HP_TcpFramedAgent_SetLengthIncludeHeader@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedAgent_SetMaxFrameSize=_HP_TcpFramedAgent_SetMaxFrameSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_GetFrameHeaderSize=_HP_TcpFramedClient_GetFrameHeaderSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_GetLengthAdjustment=_HP_TcpFramedClient_GetLengthAdjustment@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_GetLengthFieldOffset=_HP_TcpFramedClient_GetLengthFieldOffset@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_GetLengthFieldSize=_HP_TcpFramedClient_GetLengthFieldSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_GetMaxFrameSize=_HP_TcpFramedClient_GetMaxFrameSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_IsLengthFieldBigEndian=_HP_TcpFramedClient_IsLengthFieldBigEndian@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_IsLengthIncludeHeader=_HP_TcpFramedClient_IsLengthIncludeHeader@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_SetFrameHeaderSize=_HP_TcpFramedClient_SetFrameHeaderSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_SetLengthAdjustment=_HP_TcpFramedClient_SetLengthAdjustment@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_SetLengthFieldBigEndian=_HP_TcpFramedClient_SetLengthFieldBigEndian@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_SetLengthFieldOffset=_HP_TcpFramedClient_SetLengthFieldOffset@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_SetLengthFieldSize=_HP_TcpFramedClient_SetLengthFieldSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_SetLengthIncludeHeader=_HP_TcpFramedClient_SetLengthIncludeHeader@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedClient_SetMaxFrameSize=_HP_TcpFramedClient_SetMaxFrameSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_GetFrameHeaderSize=_HP_TcpFramedServer_GetFrameHeaderSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_GetLengthAdjustment=_HP_TcpFramedServer_GetLengthAdjustment@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_GetLengthFieldOffset=_HP_TcpFramedServer_GetLengthFieldOffset@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_GetLengthFieldSize=_HP_TcpFramedServer_GetLengthFieldSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_GetMaxFrameSize=_HP_TcpFramedServer_GetMaxFrameSize@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_IsLengthFieldBigEndian=_HP_TcpFramedServer_IsLengthFieldBigEndian@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_IsLengthIncludeHeader=_HP_TcpFramedServer_IsLengthIncludeHeader@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_SetFrameHeaderSize=_HP_TcpFramedServer_SetFrameHeaderSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_SetLengthAdjustment=_HP_TcpFramedServer_SetLengthAdjustment@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_SetLengthFieldBigEndian=_HP_TcpFramedServer_SetLengthFieldBigEndian@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_SetLengthFieldOffset=_HP_TcpFramedServer_SetLengthFieldOffset@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_SetLengthFieldSize=_HP_TcpFramedServer_SetLengthFieldSize@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_SetLengthIncludeHeader=_HP_TcpFramedServer_SetLengthIncludeHeader@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpFramedServer_SetMaxFrameSize=_HP_TcpFramedServer_SetMaxFrameSize@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpPackAgent_GetMaxPackSize=_HP_TcpPackAgent_GetMaxPackSize@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpPackAgent_GetPackHeaderFlag=_HP_TcpPackAgent_GetPackHeaderFlag@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpPackAgent_SetMaxPackSize=_HP_TcpPackAgent_SetMaxPackSize@8")
@@ -277,17 +337,46 @@
 	#pragma comment(linker, "/EXPORT:HP_TcpPullClient_Peek=_HP_TcpPullClient_Peek@12")
 	#pragma comment(linker, "/EXPORT:HP_TcpPullServer_Fetch=_HP_TcpPullServer_Fetch@16")
 	#pragma comment(linker, "/EXPORT:HP_TcpPullServer_Peek=_HP_TcpPullServer_Peek@16")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_CreateGroup=_HP_TcpServer_CreateGroup@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_DestroyGroup=_HP_TcpServer_DestroyGroup@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetAcceptSocketCount=_HP_TcpServer_GetAcceptSocketCount@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetFreeBufferObjLocalHigh=_HP_TcpServer_GetFreeBufferObjLocalHigh@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetFreeBufferObjLocalLow=_HP_TcpServer_GetFreeBufferObjLocalLow@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetFreeBufferObjLocalStat=_HP_TcpServer_GetFreeBufferObjLocalStat@12")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetGroupMemberCount=_HP_TcpServer_GetGroupMemberCount@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetGroupMemberIDs=_HP_TcpServer_GetGroupMemberIDs@16")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetHeapClassStat=_HP_TcpServer_GetHeapClassStat@12")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetHeapLargeStat=_HP_TcpServer_GetHeapLargeStat@12")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetKeepAliveInterval=_HP_TcpServer_GetKeepAliveInterval@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetKeepAliveTime=_HP_TcpServer_GetKeepAliveTime@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetMaxLifetime=_HP_TcpServer_GetMaxLifetime@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetSendHighWatermark=_HP_TcpServer_GetSendHighWatermark@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetSendLowWatermark=_HP_TcpServer_GetSendLowWatermark@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetSilenceTimeout=_HP_TcpServer_GetSilenceTimeout@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetSocketBufferSize=_HP_TcpServer_GetSocketBufferSize@4")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_GetSocketListenQueue=_HP_TcpServer_GetSocketListenQueue@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_IsWorkerAffinity=_HP_TcpServer_IsWorkerAffinity@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_IsZeroByteReceive=_HP_TcpServer_IsZeroByteReceive@4")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_JoinGroup=_HP_TcpServer_JoinGroup@12")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_LeaveGroup=_HP_TcpServer_LeaveGroup@12")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SendFile=_HP_TcpServer_SendFile@36")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_SendSmallFile=_HP_TcpServer_SendSmallFile@20")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SendToGroup=_HP_TcpServer_SendToGroup@16")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SendToMany=_HP_TcpServer_SendToMany@20")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SendZeroCopy=_HP_TcpServer_SendZeroCopy@24")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetAcceptSocketCount=_HP_TcpServer_SetAcceptSocketCount@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetFreeBufferObjLocalHigh=_HP_TcpServer_SetFreeBufferObjLocalHigh@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetFreeBufferObjLocalLow=_HP_TcpServer_SetFreeBufferObjLocalLow@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetKeepAliveInterval=_HP_TcpServer_SetKeepAliveInterval@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetKeepAliveTime=_HP_TcpServer_SetKeepAliveTime@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetMaxLifetime=_HP_TcpServer_SetMaxLifetime@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetSendHighWatermark=_HP_TcpServer_SetSendHighWatermark@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetSendLowWatermark=_HP_TcpServer_SetSendLowWatermark@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetSilenceTimeout=_HP_TcpServer_SetSilenceTimeout@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetSocketBufferSize=_HP_TcpServer_SetSocketBufferSize@8")
 	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetSocketListenQueue=_HP_TcpServer_SetSocketListenQueue@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetWorkerAffinity=_HP_TcpServer_SetWorkerAffinity@8")
+	#pragma comment(linker, "/EXPORT:HP_TcpServer_SetZeroByteReceive=_HP_TcpServer_SetZeroByteReceive@8")
 
 #ifdef _UDP_SUPPORT
 	#pragma comment(linker, "/EXPORT:Create_HP_UdpCast=_Create_HP_UdpCast@4")
@@ -345,6 +434,9 @@
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_SetMaxTransUnit=_HP_UdpArqServer_SetMaxTransUnit@8")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_SetMaxMessageSize=_HP_UdpArqServer_SetMaxMessageSize@8")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_SetHandShakeTimeout=_HP_UdpArqServer_SetHandShakeTimeout@8")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_SetSegmentOffload=_HP_UdpArqServer_SetSegmentOffload@8")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_SetFecDataShards=_HP_UdpArqServer_SetFecDataShards@8")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_SetFecParityShards=_HP_UdpArqServer_SetFecParityShards@8")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_IsNoDelay=_HP_UdpArqServer_IsNoDelay@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_IsTurnoffCongestCtrl=_HP_UdpArqServer_IsTurnoffCongestCtrl@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetFlushInterval=_HP_UdpArqServer_GetFlushInterval@4")
@@ -356,6 +448,12 @@
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetMaxTransUnit=_HP_UdpArqServer_GetMaxTransUnit@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetMaxMessageSize=_HP_UdpArqServer_GetMaxMessageSize@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetHandShakeTimeout=_HP_UdpArqServer_GetHandShakeTimeout@4")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_IsSegmentOffload=_HP_UdpArqServer_IsSegmentOffload@4")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetFecDataShards=_HP_UdpArqServer_GetFecDataShards@4")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetFecParityShards=_HP_UdpArqServer_GetFecParityShards@4")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetSegmentPoolHitCount=_HP_UdpArqServer_GetSegmentPoolHitCount@4")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetSegmentPoolMissCount=_HP_UdpArqServer_GetSegmentPoolMissCount@4")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetSegmentPoolOversizeCount=_HP_UdpArqServer_GetSegmentPoolOversizeCount@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqServer_GetWaitingSendMessageCount=_HP_UdpArqServer_GetWaitingSendMessageCount@12")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_SetNoDelay=_HP_UdpArqClient_SetNoDelay@8")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_SetTurnoffCongestCtrl=_HP_UdpArqClient_SetTurnoffCongestCtrl@8")
@@ -368,6 +466,8 @@
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_SetMaxTransUnit=_HP_UdpArqClient_SetMaxTransUnit@8")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_SetMaxMessageSize=_HP_UdpArqClient_SetMaxMessageSize@8")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_SetHandShakeTimeout=_HP_UdpArqClient_SetHandShakeTimeout@8")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_SetFecDataShards=_HP_UdpArqClient_SetFecDataShards@8")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_SetFecParityShards=_HP_UdpArqClient_SetFecParityShards@8")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_IsNoDelay=_HP_UdpArqClient_IsNoDelay@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_IsTurnoffCongestCtrl=_HP_UdpArqClient_IsTurnoffCongestCtrl@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_GetFlushInterval=_HP_UdpArqClient_GetFlushInterval@4")
@@ -379,6 +479,8 @@
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_GetMaxTransUnit=_HP_UdpArqClient_GetMaxTransUnit@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_GetMaxMessageSize=_HP_UdpArqClient_GetMaxMessageSize@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_GetHandShakeTimeout=_HP_UdpArqClient_GetHandShakeTimeout@4")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_GetFecDataShards=_HP_UdpArqClient_GetFecDataShards@4")
+	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_GetFecParityShards=_HP_UdpArqClient_GetFecParityShards@4")
 	#pragma comment(linker, "/EXPORT:HP_UdpArqClient_GetWaitingSendMessageCount=_HP_UdpArqClient_GetWaitingSendMessageCount@8")
 
 	#pragma comment(linker, "/EXPORT:Create_HP_UdpNode=_Create_HP_UdpNode@4")
@@ -688,6 +790,7 @@
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_HttpServer_OnReceive=_HP_Set_FN_HttpServer_OnReceive@8")
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_HttpServer_OnRequestLine=_HP_Set_FN_HttpServer_OnRequestLine@8")
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_HttpServer_OnSend=_HP_Set_FN_HttpServer_OnSend@8")
+	#pragma comment(linker, "/EXPORT:HP_Set_FN_HttpServer_OnSendWatermark=_HP_Set_FN_HttpServer_OnSendWatermark@8")
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_HttpServer_OnShutdown=_HP_Set_FN_HttpServer_OnShutdown@8")
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_HttpServer_OnUpgrade=_HP_Set_FN_HttpServer_OnUpgrade@8")
 	#pragma comment(linker, "/EXPORT:HP_Set_FN_HttpServer_OnWSMessageBody=_HP_Set_FN_HttpServer_OnWSMessageBody@8")
@@ -703,6 +806,7 @@
 	#pragma comment(linker, "/EXPORT:HP_ThreadPool_Stop=_HP_ThreadPool_Stop@8")
 	#pragma comment(linker, "/EXPORT:HP_ThreadPool_Submit=_HP_ThreadPool_Submit@16")
 	#pragma comment(linker, "/EXPORT:HP_ThreadPool_Submit_Task=_HP_ThreadPool_Submit_Task@12")
+	#pragma comment(linker, "/EXPORT:HP_ThreadPool_Submit_SerialTask=_HP_ThreadPool_Submit_SerialTask@12")
 	#pragma comment(linker, "/EXPORT:HP_ThreadPool_AdjustThreadCount=_HP_ThreadPool_AdjustThreadCount@8")
 	#pragma comment(linker, "/EXPORT:HP_ThreadPool_Wait=_HP_ThreadPool_Wait@8")
 	#pragma comment(linker, "/EXPORT:HP_ThreadPool_HasStarted=_HP_ThreadPool_HasStarted@4")
@@ -722,14 +826,17 @@
 typedef C_HP_ObjectT<CTcpServer, ITcpServerListener>							C_HP_TcpServer;
 typedef C_HP_ObjectT<CTcpPullServer, ITcpServerListener, sizeof(IPullSocket)>	C_HP_TcpPullServer;
 typedef C_HP_ObjectT<CTcpPackServer, ITcpServerListener, sizeof(IPackSocket)>	C_HP_TcpPackServer;
+typedef C_HP_ObjectT<CTcpFramedServer, ITcpServerListener, sizeof(IFramedSocket)>	C_HP_TcpFramedServer;
 
 typedef C_HP_ObjectT<CTcpAgent, ITcpAgentListener>								C_HP_TcpAgent;
 typedef C_HP_ObjectT<CTcpPullAgent, ITcpAgentListener, sizeof(IPullSocket)>		C_HP_TcpPullAgent;
 typedef C_HP_ObjectT<CTcpPackAgent, ITcpAgentListener, sizeof(IPackSocket)>		C_HP_TcpPackAgent;
+typedef C_HP_ObjectT<CTcpFramedAgent, ITcpAgentListener, sizeof(IFramedSocket)>	C_HP_TcpFramedAgent;
 
 typedef C_HP_ObjectT<CTcpClient, ITcpClientListener>							C_HP_TcpClient;
 typedef C_HP_ObjectT<CTcpPullClient, ITcpClientListener, sizeof(IPullClient)>	C_HP_TcpPullClient;
 typedef C_HP_ObjectT<CTcpPackClient, ITcpClientListener, sizeof(IPackClient)>	C_HP_TcpPackClient;
+typedef C_HP_ObjectT<CTcpFramedClient, ITcpClientListener, sizeof(IFramedClient)>	C_HP_TcpFramedClient;
 
 #ifdef _UDP_SUPPORT
 
@@ -791,6 +898,21 @@ HPSOCKET_API HP_TcpPackClient __HP_CALL Create_HP_TcpPackClient(HP_TcpClientList
 	return (HP_TcpPackClient)(new C_HP_TcpPackClient((ITcpClientListener*)pListener));
 }
 
+HPSOCKET_API HP_TcpFramedServer __HP_CALL Create_HP_TcpFramedServer(HP_TcpServerListener pListener)
+{
+	return (HP_TcpFramedServer)(new C_HP_TcpFramedServer((ITcpServerListener*)pListener));
+}
+
+HPSOCKET_API HP_TcpFramedAgent __HP_CALL Create_HP_TcpFramedAgent(HP_TcpAgentListener pListener)
+{
+	return (HP_TcpFramedAgent)(new C_HP_TcpFramedAgent((ITcpAgentListener*)pListener));
+}
+
+HPSOCKET_API HP_TcpFramedClient __HP_CALL Create_HP_TcpFramedClient(HP_TcpClientListener pListener)
+{
+	return (HP_TcpFramedClient)(new C_HP_TcpFramedClient((ITcpClientListener*)pListener));
+}
+
 HPSOCKET_API void __HP_CALL Destroy_HP_TcpServer(HP_TcpServer pServer)
 {
 	delete (C_HP_TcpServer*)pServer;
@@ -836,6 +958,21 @@ HPSOCKET_API void __HP_CALL Destroy_HP_TcpPackClient(HP_TcpPackClient pClient)
 	delete (C_HP_TcpPackClient*)pClient;
 }
 
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedServer(HP_TcpFramedServer pServer)
+{
+	delete (C_HP_TcpFramedServer*)pServer;
+}
+
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedAgent(HP_TcpFramedAgent pAgent)
+{
+	delete (C_HP_TcpFramedAgent*)pAgent;
+}
+
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedClient(HP_TcpFramedClient pClient)
+{
+	delete (C_HP_TcpFramedClient*)pClient;
+}
+
 HPSOCKET_API HP_TcpServerListener __HP_CALL Create_HP_TcpServerListener()
 {
 	return (HP_TcpServerListener)(new C_HP_TcpServerListener);
@@ -881,6 +1018,21 @@ HPSOCKET_API HP_TcpPackClientListener __HP_CALL Create_HP_TcpPackClientListener(
 	return (HP_TcpPackClientListener)(new C_HP_TcpPackClientListener);
 }
 
+HPSOCKET_API HP_TcpFramedServerListener __HP_CALL Create_HP_TcpFramedServerListener()
+{
+	return (HP_TcpFramedServerListener)(new C_HP_TcpFramedServerListener);
+}
+
+HPSOCKET_API HP_TcpFramedAgentListener __HP_CALL Create_HP_TcpFramedAgentListener()
+{
+	return (HP_TcpFramedAgentListener)(new C_HP_TcpFramedAgentListener);
+}
+
+HPSOCKET_API HP_TcpFramedClientListener __HP_CALL Create_HP_TcpFramedClientListener()
+{
+	return (HP_TcpFramedClientListener)(new C_HP_TcpFramedClientListener);
+}
+
 HPSOCKET_API void __HP_CALL Destroy_HP_TcpServerListener(HP_TcpServerListener pListener)
 {
 	delete (C_HP_TcpServerListener*)pListener;
@@ -926,6 +1078,21 @@ HPSOCKET_API void __HP_CALL Destroy_HP_TcpPackClientListener(HP_TcpPackClientLis
 	delete (C_HP_TcpPackClientListener*)pListener;
 }
 
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedServerListener(HP_TcpFramedServerListener pListener)
+{
+	delete (C_HP_TcpFramedServerListener*)pListener;
+}
+
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedAgentListener(HP_TcpFramedAgentListener pListener)
+{
+	delete (C_HP_TcpFramedAgentListener*)pListener;
+}
+
+HPSOCKET_API void __HP_CALL Destroy_HP_TcpFramedClientListener(HP_TcpFramedClientListener pListener)
+{
+	delete (C_HP_TcpFramedClientListener*)pListener;
+}
+
 #ifdef _UDP_SUPPORT
 
 HPSOCKET_API HP_UdpServer __HP_CALL Create_HP_UdpServer(HP_UdpServerListener pListener)
@@ -1093,6 +1260,11 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnShutdown(HP_ServerListener pListe
 	((C_HP_TcpServerListener*)pListener)->m_fnOnShutdown = fn;
 }
 
+HPSOCKET_API void __HP_CALL HP_Set_FN_Server_OnSendWatermark(HP_ServerListener pListener, HP_FN_Server_OnSendWatermark fn)
+{
+	((C_HP_TcpServerListener*)pListener)->m_fnOnSendWatermark = fn;
+}
+
 /**********************************************************************************/
 /***************************** Agent 回调函数设置方法 *****************************/
 
@@ -1466,6 +1638,56 @@ HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendSmallFile(HP_Server pServer, HP_CON
 	return C_HP_Object::ToSecond<ITcpServer>(pServer)->SendSmallFile(dwConnID, lpszFileName, pHead, pTail);
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendZeroCopy(HP_Server pServer, HP_CONNID dwConnID, const BYTE* pBuffer, int iLength, HP_Fn_SendBufferRelease fnRelease, PVOID pvArg)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->SendZeroCopy(dwConnID, pBuffer, iLength, fnRelease, pvArg);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendToMany(HP_Server pServer, const HP_CONNID pConnIDs[], int iConnCount, const WSABUF pBuffers[], int iCount)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->SendToMany(pConnIDs, iConnCount, pBuffers, iCount);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_CreateGroup(HP_Server pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->CreateGroup();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_DestroyGroup(HP_Server pServer, DWORD dwGroupID)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->DestroyGroup(dwGroupID);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_JoinGroup(HP_Server pServer, DWORD dwGroupID, HP_CONNID dwConnID)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->JoinGroup(dwGroupID, dwConnID);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_LeaveGroup(HP_Server pServer, DWORD dwGroupID, HP_CONNID dwConnID)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->LeaveGroup(dwGroupID, dwConnID);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendToGroup(HP_Server pServer, DWORD dwGroupID, const WSABUF pBuffers[], int iCount)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->SendToGroup(dwGroupID, pBuffers, iCount);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetGroupMemberCount(HP_Server pServer, DWORD dwGroupID)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetGroupMemberCount(dwGroupID);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_GetGroupMemberIDs(HP_Server pServer, DWORD dwGroupID, HP_CONNID pIDs[], DWORD* pdwCount)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetGroupMemberIDs(dwGroupID, pIDs, *pdwCount);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_SendFile(HP_Server pServer, HP_CONNID dwConnID, LPCTSTR lpszFileName, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->SendFile(dwConnID, lpszFileName, ullOffset, ullLength, pHead, pTail);
+}
+
 /**********************************************************************************/
 /***************************** TCP Server 属性访问方法 *****************************/
 
@@ -1494,6 +1716,46 @@ HPSOCKET_API void __HP_CALL HP_TcpServer_SetKeepAliveInterval(HP_TcpServer pServ
 	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetKeepAliveInterval(dwKeepAliveInterval);
 }
 
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetZeroByteReceive(HP_TcpServer pServer, BOOL bZeroByteReceive)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetZeroByteReceive(bZeroByteReceive);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetWorkerAffinity(HP_TcpServer pServer, BOOL bWorkerAffinity)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetWorkerAffinity(bWorkerAffinity);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetSilenceTimeout(HP_TcpServer pServer, DWORD dwSilenceTimeout)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetSilenceTimeout(dwSilenceTimeout);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetMaxLifetime(HP_TcpServer pServer, DWORD dwMaxLifetime)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetMaxLifetime(dwMaxLifetime);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetSendHighWatermark(HP_TcpServer pServer, DWORD dwSendHighWatermark)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetSendHighWatermark(dwSendHighWatermark);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetSendLowWatermark(HP_TcpServer pServer, DWORD dwSendLowWatermark)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetSendLowWatermark(dwSendLowWatermark);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetFreeBufferObjLocalHigh(HP_TcpServer pServer, DWORD dwFreeBufferObjLocalHigh)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetFreeBufferObjLocalHigh(dwFreeBufferObjLocalHigh);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_SetFreeBufferObjLocalLow(HP_TcpServer pServer, DWORD dwFreeBufferObjLocalLow)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->SetFreeBufferObjLocalLow(dwFreeBufferObjLocalLow);
+}
+
 HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetAcceptSocketCount(HP_TcpServer pServer)
 {
 	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetAcceptSocketCount();
@@ -1519,6 +1781,61 @@ HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetKeepAliveInterval(HP_TcpServer pSer
 	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetKeepAliveInterval();
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_IsZeroByteReceive(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->IsZeroByteReceive();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_IsWorkerAffinity(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->IsWorkerAffinity();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSilenceTimeout(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetSilenceTimeout();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetMaxLifetime(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetMaxLifetime();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSendHighWatermark(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetSendHighWatermark();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetSendLowWatermark(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetSendLowWatermark();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetFreeBufferObjLocalHigh(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetFreeBufferObjLocalHigh();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpServer_GetFreeBufferObjLocalLow(HP_TcpServer pServer)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetFreeBufferObjLocalLow();
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpServer_GetFreeBufferObjLocalStat(HP_TcpServer pServer, ULONGLONG* pullHits, ULONGLONG* pullMisses)
+{
+	C_HP_Object::ToSecond<ITcpServer>(pServer)->GetFreeBufferObjLocalStat(*pullHits, *pullMisses);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_GetHeapClassStat(HP_TcpServer pServer, DWORD dwClass, HP_THeapClassStat* pStat)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetHeapClassStat(dwClass, *pStat);
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpServer_GetHeapLargeStat(HP_TcpServer pServer, SIZE_T* pdwCount, SIZE_T* pdwBytes)
+{
+	return C_HP_Object::ToSecond<ITcpServer>(pServer)->GetHeapLargeStat(*pdwCount, *pdwBytes);
+}
+
 #ifdef _UDP_SUPPORT
 
 /**********************************************************************************/
@@ -1622,6 +1939,21 @@ HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetHandShakeTimeout(HP_UdpArqServer
 	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetHandShakeTimeout(dwHandShakeTimeout);
 }
 
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetSegmentOffload(HP_UdpArqServer pServer, BOOL bSegmentOffload)
+{
+	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetSegmentOffload(bSegmentOffload);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFecDataShards(HP_UdpArqServer pServer, DWORD dwDataShards)
+{
+	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetFecDataShards(dwDataShards);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqServer_SetFecParityShards(HP_UdpArqServer pServer, DWORD dwParityShards)
+{
+	C_HP_Object::ToFirst<IArqSocket>(pServer)->SetFecParityShards(dwParityShards);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_IsNoDelay(HP_UdpArqServer pServer)
 {
 	return C_HP_Object::ToFirst<IArqSocket>(pServer)->IsNoDelay();
@@ -1677,6 +2009,36 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetHandShakeTimeout(HP_UdpArqServer
 	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetHandShakeTimeout();
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_IsSegmentOffload(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->IsSegmentOffload();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFecDataShards(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetFecDataShards();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqServer_GetFecParityShards(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetFecParityShards();
+}
+
+HPSOCKET_API ULONGLONG __HP_CALL HP_UdpArqServer_GetSegmentPoolHitCount(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetSegmentPoolHitCount();
+}
+
+HPSOCKET_API ULONGLONG __HP_CALL HP_UdpArqServer_GetSegmentPoolMissCount(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetSegmentPoolMissCount();
+}
+
+HPSOCKET_API ULONGLONG __HP_CALL HP_UdpArqServer_GetSegmentPoolOversizeCount(HP_UdpArqServer pServer)
+{
+	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetSegmentPoolOversizeCount();
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqServer_GetWaitingSendMessageCount(HP_UdpArqServer pServer, HP_CONNID dwConnID, int* piCount)
 {
 	return C_HP_Object::ToFirst<IArqSocket>(pServer)->GetWaitingSendMessageCount(dwConnID, *piCount);
@@ -1991,6 +2353,11 @@ HPSOCKET_API void __HP_CALL HP_TcpAgent_SetKeepAliveInterval(HP_TcpAgent pAgent,
 	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetKeepAliveInterval(dwKeepAliveInterval);
 }
 
+HPSOCKET_API void __HP_CALL HP_TcpAgent_SetZeroByteReceive(HP_TcpAgent pAgent, BOOL bZeroByteReceive)
+{
+	C_HP_Object::ToSecond<ITcpAgent>(pAgent)->SetZeroByteReceive(bZeroByteReceive);
+}
+
 HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetSocketBufferSize(HP_TcpAgent pAgent)
 {
 	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->GetSocketBufferSize();
@@ -2006,6 +2373,11 @@ HPSOCKET_API DWORD __HP_CALL HP_TcpAgent_GetKeepAliveInterval(HP_TcpAgent pAgent
 	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->GetKeepAliveInterval();
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_TcpAgent_IsZeroByteReceive(HP_TcpAgent pAgent)
+{
+	return C_HP_Object::ToSecond<ITcpAgent>(pAgent)->IsZeroByteReceive();
+}
+
 /******************************************************************************/
 /***************************** Client 组件操作方法 *****************************/
 
@@ -2286,6 +2658,16 @@ HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetHandShakeTimeout(HP_UdpArqClient
 	C_HP_Object::ToFirst<IArqClient>(pClient)->SetHandShakeTimeout(dwHandShakeTimeout);
 }
 
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFecDataShards(HP_UdpArqClient pClient, DWORD dwDataShards)
+{
+	C_HP_Object::ToFirst<IArqClient>(pClient)->SetFecDataShards(dwDataShards);
+}
+
+HPSOCKET_API void __HP_CALL HP_UdpArqClient_SetFecParityShards(HP_UdpArqClient pClient, DWORD dwParityShards)
+{
+	C_HP_Object::ToFirst<IArqClient>(pClient)->SetFecParityShards(dwParityShards);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_IsNoDelay(HP_UdpArqClient pClient)
 {
 	return C_HP_Object::ToFirst<IArqClient>(pClient)->IsNoDelay();
@@ -2341,6 +2723,16 @@ HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetHandShakeTimeout(HP_UdpArqClient
 	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetHandShakeTimeout();
 }
 
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFecDataShards(HP_UdpArqClient pClient)
+{
+	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetFecDataShards();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_UdpArqClient_GetFecParityShards(HP_UdpArqClient pClient)
+{
+	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetFecParityShards();
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_UdpArqClient_GetWaitingSendMessageCount(HP_UdpArqClient pClient, int* piCount)
 {
 	return C_HP_Object::ToFirst<IArqClient>(pClient)->GetWaitingSendMessageCount(*piCount);
@@ -2708,6 +3100,234 @@ HPSOCKET_API USHORT __HP_CALL HP_TcpPackClient_GetPackHeaderFlag(HP_TcpPackClien
 	return C_HP_Object::ToFirst<IPackClient>(pClient)->GetPackHeaderFlag();
 }
 
+/***************************************************************************************/
+/***************************** TCP Framed Server 组件操作方法 *****************************/
+
+/***************************************************************************************/
+/***************************** TCP Framed Server 属性访问方法 *****************************/
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetFrameHeaderSize(HP_TcpFramedServer pServer, DWORD dwHeaderSize)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pServer)->SetFrameHeaderSize(dwHeaderSize);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthFieldOffset(HP_TcpFramedServer pServer, DWORD dwOffset)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pServer)->SetLengthFieldOffset(dwOffset);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthFieldSize(HP_TcpFramedServer pServer, DWORD dwSize)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pServer)->SetLengthFieldSize(dwSize);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthFieldBigEndian(HP_TcpFramedServer pServer, BOOL bBigEndian)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pServer)->SetLengthFieldBigEndian(bBigEndian);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthIncludeHeader(HP_TcpFramedServer pServer, BOOL bIncludeHeader)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pServer)->SetLengthIncludeHeader(bIncludeHeader);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetLengthAdjustment(HP_TcpFramedServer pServer, int iAdjustment)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pServer)->SetLengthAdjustment(iAdjustment);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedServer_SetMaxFrameSize(HP_TcpFramedServer pServer, DWORD dwMaxFrameSize)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pServer)->SetMaxFrameSize(dwMaxFrameSize);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedServer_GetFrameHeaderSize(HP_TcpFramedServer pServer)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pServer)->GetFrameHeaderSize();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedServer_GetLengthFieldOffset(HP_TcpFramedServer pServer)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pServer)->GetLengthFieldOffset();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedServer_GetLengthFieldSize(HP_TcpFramedServer pServer)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pServer)->GetLengthFieldSize();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedServer_IsLengthFieldBigEndian(HP_TcpFramedServer pServer)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pServer)->IsLengthFieldBigEndian();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedServer_IsLengthIncludeHeader(HP_TcpFramedServer pServer)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pServer)->IsLengthIncludeHeader();
+}
+
+HPSOCKET_API int __HP_CALL HP_TcpFramedServer_GetLengthAdjustment(HP_TcpFramedServer pServer)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pServer)->GetLengthAdjustment();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedServer_GetMaxFrameSize(HP_TcpFramedServer pServer)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pServer)->GetMaxFrameSize();
+}
+
+/***************************************************************************************/
+/***************************** TCP Framed Agent 组件操作方法 *****************************/
+
+/***************************************************************************************/
+/***************************** TCP Framed Agent 属性访问方法 *****************************/
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetFrameHeaderSize(HP_TcpFramedAgent pAgent, DWORD dwHeaderSize)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pAgent)->SetFrameHeaderSize(dwHeaderSize);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthFieldOffset(HP_TcpFramedAgent pAgent, DWORD dwOffset)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pAgent)->SetLengthFieldOffset(dwOffset);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthFieldSize(HP_TcpFramedAgent pAgent, DWORD dwSize)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pAgent)->SetLengthFieldSize(dwSize);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthFieldBigEndian(HP_TcpFramedAgent pAgent, BOOL bBigEndian)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pAgent)->SetLengthFieldBigEndian(bBigEndian);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthIncludeHeader(HP_TcpFramedAgent pAgent, BOOL bIncludeHeader)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pAgent)->SetLengthIncludeHeader(bIncludeHeader);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetLengthAdjustment(HP_TcpFramedAgent pAgent, int iAdjustment)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pAgent)->SetLengthAdjustment(iAdjustment);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedAgent_SetMaxFrameSize(HP_TcpFramedAgent pAgent, DWORD dwMaxFrameSize)
+{
+	C_HP_Object::ToFirst<IFramedSocket>(pAgent)->SetMaxFrameSize(dwMaxFrameSize);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedAgent_GetFrameHeaderSize(HP_TcpFramedAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pAgent)->GetFrameHeaderSize();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedAgent_GetLengthFieldOffset(HP_TcpFramedAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pAgent)->GetLengthFieldOffset();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedAgent_GetLengthFieldSize(HP_TcpFramedAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pAgent)->GetLengthFieldSize();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedAgent_IsLengthFieldBigEndian(HP_TcpFramedAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pAgent)->IsLengthFieldBigEndian();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedAgent_IsLengthIncludeHeader(HP_TcpFramedAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pAgent)->IsLengthIncludeHeader();
+}
+
+HPSOCKET_API int __HP_CALL HP_TcpFramedAgent_GetLengthAdjustment(HP_TcpFramedAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pAgent)->GetLengthAdjustment();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedAgent_GetMaxFrameSize(HP_TcpFramedAgent pAgent)
+{
+	return C_HP_Object::ToFirst<IFramedSocket>(pAgent)->GetMaxFrameSize();
+}
+
+/***************************************************************************************/
+/***************************** TCP Framed Client 组件操作方法 *****************************/
+
+/***************************************************************************************/
+/***************************** TCP Framed Client 属性访问方法 *****************************/
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetFrameHeaderSize(HP_TcpFramedClient pClient, DWORD dwHeaderSize)
+{
+	C_HP_Object::ToFirst<IFramedClient>(pClient)->SetFrameHeaderSize(dwHeaderSize);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthFieldOffset(HP_TcpFramedClient pClient, DWORD dwOffset)
+{
+	C_HP_Object::ToFirst<IFramedClient>(pClient)->SetLengthFieldOffset(dwOffset);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthFieldSize(HP_TcpFramedClient pClient, DWORD dwSize)
+{
+	C_HP_Object::ToFirst<IFramedClient>(pClient)->SetLengthFieldSize(dwSize);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthFieldBigEndian(HP_TcpFramedClient pClient, BOOL bBigEndian)
+{
+	C_HP_Object::ToFirst<IFramedClient>(pClient)->SetLengthFieldBigEndian(bBigEndian);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthIncludeHeader(HP_TcpFramedClient pClient, BOOL bIncludeHeader)
+{
+	C_HP_Object::ToFirst<IFramedClient>(pClient)->SetLengthIncludeHeader(bIncludeHeader);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetLengthAdjustment(HP_TcpFramedClient pClient, int iAdjustment)
+{
+	C_HP_Object::ToFirst<IFramedClient>(pClient)->SetLengthAdjustment(iAdjustment);
+}
+
+HPSOCKET_API void __HP_CALL HP_TcpFramedClient_SetMaxFrameSize(HP_TcpFramedClient pClient, DWORD dwMaxFrameSize)
+{
+	C_HP_Object::ToFirst<IFramedClient>(pClient)->SetMaxFrameSize(dwMaxFrameSize);
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedClient_GetFrameHeaderSize(HP_TcpFramedClient pClient)
+{
+	return C_HP_Object::ToFirst<IFramedClient>(pClient)->GetFrameHeaderSize();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedClient_GetLengthFieldOffset(HP_TcpFramedClient pClient)
+{
+	return C_HP_Object::ToFirst<IFramedClient>(pClient)->GetLengthFieldOffset();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedClient_GetLengthFieldSize(HP_TcpFramedClient pClient)
+{
+	return C_HP_Object::ToFirst<IFramedClient>(pClient)->GetLengthFieldSize();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedClient_IsLengthFieldBigEndian(HP_TcpFramedClient pClient)
+{
+	return C_HP_Object::ToFirst<IFramedClient>(pClient)->IsLengthFieldBigEndian();
+}
+
+HPSOCKET_API BOOL __HP_CALL HP_TcpFramedClient_IsLengthIncludeHeader(HP_TcpFramedClient pClient)
+{
+	return C_HP_Object::ToFirst<IFramedClient>(pClient)->IsLengthIncludeHeader();
+}
+
+HPSOCKET_API int __HP_CALL HP_TcpFramedClient_GetLengthAdjustment(HP_TcpFramedClient pClient)
+{
+	return C_HP_Object::ToFirst<IFramedClient>(pClient)->GetLengthAdjustment();
+}
+
+HPSOCKET_API DWORD __HP_CALL HP_TcpFramedClient_GetMaxFrameSize(HP_TcpFramedClient pClient)
+{
+	return C_HP_Object::ToFirst<IFramedClient>(pClient)->GetMaxFrameSize();
+}
+
 /*****************************************************************************************************************************************************/
 /*************************************************************** Global Function Exports *************************************************************/
 /*****************************************************************************************************************************************************/
@@ -3202,6 +3822,11 @@ HPSOCKET_API void __HP_CALL HP_Set_FN_HttpServer_OnShutdown(HP_HttpServerListene
 	((C_HP_HttpServerListener*)pListener)->m_lsnServer.m_fnOnShutdown = fn;
 }
 
+HPSOCKET_API void __HP_CALL HP_Set_FN_HttpServer_OnSendWatermark(HP_HttpServerListener pListener, HP_FN_HttpServer_OnSendWatermark fn)
+{
+	((C_HP_HttpServerListener*)pListener)->m_lsnServer.m_fnOnSendWatermark = fn;
+}
+
 /**********************************************************************************/
 /**************************** HTTP Agent 回调函数设置方法 **************************/
 
@@ -4122,6 +4747,11 @@ HPSOCKET_API BOOL __HP_CALL HP_ThreadPool_Submit_Task(HP_ThreadPool pThreadPool,
 	return ((IHPThreadPool*)pThreadPool)->Submit(pTask, dwMaxWait);
 }
 
+HPSOCKET_API BOOL __HP_CALL HP_ThreadPool_Submit_SerialTask(HP_ThreadPool pThreadPool, HP_LPTSocketTask pTask, DWORD dwMaxWait)
+{
+	return ((IHPThreadPool*)pThreadPool)->SubmitSerial(pTask, dwMaxWait);
+}
+
 HPSOCKET_API BOOL __HP_CALL HP_ThreadPool_AdjustThreadCount(HP_ThreadPool pThreadPool, DWORD dwNewThreadCount)
 {
 	return ((IHPThreadPool*)pThreadPool)->AdjustThreadCount(dwNewThreadCount);
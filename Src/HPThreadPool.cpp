@@ -24,6 +24,8 @@
 #include "stdafx.h"
 #include "HPThreadPool.h"
 
+#include <process.h>
+
 #include "Common/WaitFor.h"
 #include "Common/FuncHelper.h"
 
@@ -67,39 +69,100 @@ void DestroySocketTaskObj(LPTSocketTask pTask)
 	}
 }
 
-BOOL CHPThreadPool::CWorker::Initialize(PVOID pvWorkerParam)
+thread_local CHPThreadPool::TWorker* CHPThreadPool::sm_pCurrentWorker = nullptr;
+
+BOOL CHPThreadPool::CWorkDeque::Push(TTask* pTask)
 {
-	ASSERT(pvWorkerParam != nullptr);
+	ULONG ulBottom	= m_ulBottom;
+	ULONG ulTop		= m_ulTop;
+
+	if((LONG)(ulBottom - ulTop) >= (LONG)DEQUE_SIZE)
+		return FALSE;
 
-	m_pthPool = (CHPThreadPool*)pvWorkerParam;
+	m_pTasks[ulBottom & DEQUE_MASK]	= pTask;
+	m_ulBottom						= ulBottom + 1;
 
 	return TRUE;
 }
 
-void CHPThreadPool::CWorker::Execute(TTask* pTask, PVOID pvWorkerParam, OVERLAPPED* pOverlapped)
+CHPThreadPool::TTask* CHPThreadPool::CWorkDeque::Pop()
 {
-	ASSERT(pvWorkerParam == m_pthPool);
+	ULONG ulBottom = m_ulBottom - 1;
+	::InterlockedExchange(&m_ulBottom, ulBottom);
+
+	ULONG ulTop	= m_ulTop;
+	LONG lSize	= (LONG)(ulBottom - ulTop);
+
+	if(lSize < 0)
+	{
+		m_ulBottom = ulTop;
+		return nullptr;
+	}
 
-	::InterlockedDecrement(&m_pthPool->m_dwQueueSize);
+	TTask* pTask = m_pTasks[ulBottom & DEQUE_MASK];
 
-#if _WIN32_WINNT >= _WIN32_WINNT_WS08
-	if(m_pthPool->m_enRejectedPolicy == TRP_WAIT_FOR && m_pthPool->m_dwMaxQueueSize != 0)
-		m_pthPool->m_cvQueue.WakeUp();
-#endif
+	if(lSize > 0)
+		return pTask;
 
-	::InterlockedIncrement(&m_pthPool->m_dwTaskCount);
-	pTask->fn(pTask->arg);
-	::InterlockedDecrement(&m_pthPool->m_dwTaskCount);
+	if(::InterlockedCompareExchange(&m_ulTop, ulTop + 1, ulTop) != ulTop)
+		pTask = nullptr;
 
-	if(pTask->freeArg)
-		::DestroySocketTaskObj((LPTSocketTask)pTask->arg);
+	m_ulBottom = ulTop + 1;
 
-	TTask::Destruct(pTask);
+	return pTask;
+}
+
+CHPThreadPool::TTask* CHPThreadPool::CWorkDeque::Steal()
+{
+	ULONG ulTop = m_ulTop;
+	::MemoryBarrier();
+	ULONG ulBottom = m_ulBottom;
+
+	if((LONG)(ulBottom - ulTop) <= 0)
+		return nullptr;
+
+	TTask* pTask = m_pTasks[ulTop & DEQUE_MASK];
+
+	if(::InterlockedCompareExchange(&m_ulTop, ulTop + 1, ulTop) != ulTop)
+		return nullptr;
+
+	return pTask;
+}
+
+void CHPThreadPool::CInbox::Push(TTask* pTask)
+{
+	CSpinLock locallock(m_cs);
+
+	if(m_pTail != nullptr)
+		m_pTail->next = pTask;
+	else
+		m_pHead = pTask;
+
+	m_pTail = pTask;
+	++m_dwSize;
 }
 
-void CHPThreadPool::CWorker::Terminate(PVOID pvWorkerParam)
+CHPThreadPool::TTask* CHPThreadPool::CInbox::Pop()
 {
-	ASSERT(pvWorkerParam == m_pthPool);
+	if(IsEmpty())
+		return nullptr;
+
+	CSpinLock locallock(m_cs);
+
+	TTask* pTask = m_pHead;
+
+	if(pTask != nullptr)
+	{
+		m_pHead = pTask->next;
+
+		if(m_pHead == nullptr)
+			m_pTail = nullptr;
+
+		pTask->next = nullptr;
+		--m_dwSize;
+	}
+
+	return pTask;
 }
 
 BOOL CHPThreadPool::Start(DWORD dwThreadCount, DWORD dwMaxQueueSize, EnRejectedPolicy enRejectedPolicy, DWORD dwStackSize)
@@ -107,26 +170,35 @@ BOOL CHPThreadPool::Start(DWORD dwThreadCount, DWORD dwMaxQueueSize, EnRejectedP
 	if(!CheckStarting())
 		return FALSE;
 
+	if((int)dwThreadCount < 0)
+		dwThreadCount = ::SysGetNumberOfProcessors() * (DWORD)(-(int)dwThreadCount);
+	else if(dwThreadCount == 0)
+		dwThreadCount = ::GetDefaultWorkerThreadCount();
+
+	if(dwThreadCount > MAX_WORKER_THREAD_COUNT)
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		EXECUTE_RESTORE_ERROR(Stop());
+
+		return FALSE;
+	}
+
 	m_dwMaxQueueSize	= dwMaxQueueSize;
 	m_enRejectedPolicy	= enRejectedPolicy;
+	m_dwStackSize		= dwStackSize;
 
-	if(dwThreadCount == 0)
-		dwThreadCount = ::GetDefaultWorkerThreadCount();
-
-	HRESULT hr = m_thPool.Initialize(this, (int)dwThreadCount, dwStackSize);
+	m_lsFreeTask.Reset(DEFAULT_TASK_POOL_SIZE);
 
-	if(FAILED(hr))
+	if(!CreateWorkers(dwThreadCount))
 	{
-		::SetLastError(HRESULT_CODE(hr));
 		EXECUTE_RESTORE_ERROR(Stop());
-
 		return FALSE;
 	}
 
 	m_enState = SS_STARTED;
 	m_evWait.Reset();
 
-	return TRUE;;
+	return TRUE;
 }
 
 BOOL CHPThreadPool::Stop(DWORD dwMaxWait)
@@ -136,21 +208,24 @@ BOOL CHPThreadPool::Stop(DWORD dwMaxWait)
 
 	::WaitWithMessageLoop(15);
 
-#if _WIN32_WINNT >= _WIN32_WINNT_WS08
-	if(m_enRejectedPolicy == TRP_WAIT_FOR && m_dwMaxQueueSize != 0)
 	{
-		CCriSecLock locallock(m_csQueue);
-		m_cvQueue.WakeUpAll();
+		CCriSecLock locallock(m_csWorkers);
+		m_bQuit = TRUE;
 	}
-#endif
+
+	LONG lWaitSubmits = m_lWaitSubmits;
+
+	if(lWaitSubmits > 0)
+		m_semSpace.Release(lWaitSubmits);
 
 	if(dwMaxWait == 0)
 		dwMaxWait = INFINITE;
 
-	m_thPool.Shutdown(dwMaxWait);
+	WaitForWorkers(dwMaxWait);
+	DestroyWorkers();
+	DestroyStrands();
 
-	ASSERT(GetQueueSize()	== 0);
-	ASSERT(GetThreadCount()	== 0);
+	m_lsFreeTask.Clear();
 
 	Reset();
 
@@ -167,6 +242,120 @@ BOOL CHPThreadPool::Submit(LPTSocketTask pTask, DWORD dwMaxWait)
 	return DoSubmit((Fn_TaskProc)pTask->fn, (PVOID)pTask, TRUE, dwMaxWait);
 }
 
+BOOL CHPThreadPool::SubmitSerial(LPTSocketTask pTask, DWORD dwMaxWait)
+{
+	if(!CheckStarted())
+		return FALSE;
+
+	/* 串行队列中的任务同样占用任务队列空位（直到被取出执行），队列已满时按拒绝策略处理 */
+	if(m_dwMaxQueueSize != 0 && !AcquireQueueSlot())
+	{
+		if(m_enRejectedPolicy == TRP_CALL_FAIL)
+		{
+			::SetLastError(ERROR_DESTINATION_ELEMENT_FULL);
+			return FALSE;
+		}
+		else if(m_enRejectedPolicy == TRP_CALLER_RUN)
+		{
+			/* 串行队列空闲时由调用线程直接执行，否则为保证执行顺序只能等待队列空位 */
+			if(CallerRunStrand(pTask))
+				return TRUE;
+		}
+		else if(m_enRejectedPolicy != TRP_WAIT_FOR)
+		{
+			ENSURE(FALSE);
+
+			::SetLastError(ERROR_INVALID_PARAMETER);
+			return FALSE;
+		}
+
+		if(!WaitQueueSlot(dwMaxWait))
+			return FALSE;
+	}
+
+	PVOID pSender		 = pTask->sender;
+	CONNID dwConnID		 = pTask->connID;
+	TStrandShard& shard	 = GetStrandShard(dwConnID);
+	TStrand* pStrand	 = nullptr;
+
+	{
+		CSpinLock locallock(shard.cs);
+
+		TStrandMap::iterator it = FindStrand(shard, pSender, dwConnID);
+
+		if(it != shard.strands.end())
+		{
+			it->second->tasks.push_back(pTask);
+			return TRUE;
+		}
+
+		pStrand = new TStrand(this, pSender, dwConnID);
+		pStrand->tasks.push_back(pTask);
+
+		shard.strands.emplace(TStrandMap::value_type(dwConnID, pStrand));
+	}
+
+	/* 执行串行队列的线程池任务不再占用任务队列空位（队列中的每个任务已各自占用） */
+	if(CheckStarted())
+	{
+		PushTask(StrandProc, (PVOID)pStrand, FALSE, FALSE);
+		return TRUE;
+	}
+
+	/* 线程池已停止时若其它线程已向该串行队列追加了任务，则由当前线程执行整个队列，以免丢失已被接受的任务 */
+	BOOL bAppended = FALSE;
+
+	{
+		CSpinLock locallock(shard.cs);
+
+		bAppended = (pStrand->tasks.size() > 1);
+
+		if(!bAppended)
+			shard.strands.erase(FindStrand(shard, pSender, dwConnID));
+	}
+
+	if(!bAppended)
+	{
+		delete pStrand;
+		ReleaseQueueSlot();
+
+		return FALSE;
+	}
+
+	ExecuteStrand(pStrand);
+
+	return TRUE;
+}
+
+BOOL CHPThreadPool::CallerRunStrand(LPTSocketTask pTask)
+{
+	PVOID pSender		 = pTask->sender;
+	CONNID dwConnID		 = pTask->connID;
+	TStrandShard& shard	 = GetStrandShard(dwConnID);
+	TStrand* pStrand	 = nullptr;
+
+	{
+		CSpinLock locallock(shard.cs);
+
+		if(FindStrand(shard, pSender, dwConnID) != shard.strands.end())
+			return FALSE;
+
+		/* 登记空的串行队列，使其它线程随后提交的任务排在当前任务之后 */
+		pStrand = new TStrand(this, pSender, dwConnID);
+		shard.strands.emplace(TStrandMap::value_type(dwConnID, pStrand));
+	}
+
+	::InterlockedIncrement(&m_dwTaskCount);
+	pTask->fn(pTask);
+	::InterlockedDecrement(&m_dwTaskCount);
+
+	::DestroySocketTaskObj(pTask);
+
+	ExecuteStrand(pStrand);
+
+	return TRUE;
+}
+
 BOOL CHPThreadPool::DoSubmit(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg, DWORD dwMaxWait)
 {
 	EnSubmitResult sr = DirectSubmit(fnTaskProc, pvArg, bFreeArg);
@@ -181,7 +370,7 @@ BOOL CHPThreadPool::DoSubmit(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg,
 	}
 	else if(m_enRejectedPolicy == TRP_WAIT_FOR)
 	{
-		return CycleWaitSubmit(fnTaskProc, pvArg, dwMaxWait, bFreeArg);
+		return WaitSubmit(fnTaskProc, pvArg, dwMaxWait, bFreeArg);
 	}
 	else if(m_enRejectedPolicy == TRP_CALLER_RUN)
 	{
@@ -205,99 +394,123 @@ CHPThreadPool::EnSubmitResult CHPThreadPool::DirectSubmit(Fn_TaskProc fnTaskProc
 	if(!CheckStarted())
 		return SUBMIT_ERROR;
 
-	if(m_dwMaxQueueSize == 0)
-		::InterlockedIncrement(&m_dwQueueSize);
-	else
-	{
-		for(UINT i = 0; ; i++)
-		{
-			DWORD dwQueueSize = m_dwQueueSize;
+	if(m_dwMaxQueueSize != 0 && !AcquireQueueSlot())
+		return SUBMIT_FULL;
 
-			if(dwQueueSize >= m_dwMaxQueueSize)
-				return SUBMIT_FULL;
+	PushTask(fnTaskProc, pvArg, bFreeArg, TRUE);
 
-			DWORD dwInitialQueueSize = ::InterlockedCompareExchange(&m_dwQueueSize, dwQueueSize + 1, dwQueueSize);
+	return SUBMIT_OK;
+}
 
-			if(dwInitialQueueSize == dwQueueSize)
-				break;
-			else if(dwInitialQueueSize == m_dwMaxQueueSize)
-				return SUBMIT_FULL;
+void CHPThreadPool::PushTask(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg, BOOL bHoldSlot, BOOL bYield)
+{
+	TWorker* pWorker	= FindCurrentWorker();
+	TTask* pTask		= AllocTask(pWorker);
 
-			::YieldThread(i);
+	pTask->Reset(fnTaskProc, pvArg, bFreeArg, bHoldSlot);
 
-			if(!CheckStarted())
-				return SUBMIT_ERROR;
+	/* 工作线程提交的任务直接压入自身队列，外部线程提交的任务按当前处理器分散到各收件箱（bYield 为真时工作线程也进入收件箱，排在已有任务之后）*/
+	if(pWorker == nullptr || bYield || !pWorker->deque.Push(pTask))
+	{
+		if(pWorker == nullptr)
+		{
+			DWORD dwThreadCount = m_dwThreadCount;
+			pWorker = m_pWorkers[::GetCurrentProcessorNumber() % dwThreadCount];
 		}
-	}
 
-	TTask* pTask = TTask::Construct(fnTaskProc, pvArg, bFreeArg);
+		pWorker->inbox.Push(pTask);
+	}
 
-	if(!m_thPool.QueueRequest(pTask))
-	{
-		::InterlockedDecrement(&m_dwQueueSize);
+	WakeUpWorker();
+}
 
-		TTask::Destruct(pTask);
+BOOL CHPThreadPool::WaitSubmit(Fn_TaskProc fnTaskProc, PVOID pvArg, DWORD dwMaxWait, BOOL bFreeArg)
+{
+	if(!WaitQueueSlot(dwMaxWait))
+		return FALSE;
 
-		return SUBMIT_ERROR;
-	}
+	PushTask(fnTaskProc, pvArg, bFreeArg, TRUE);
 
-	return SUBMIT_OK;
+	return TRUE;
 }
 
-BOOL CHPThreadPool::CycleWaitSubmit(Fn_TaskProc fnTaskProc, PVOID pvArg, DWORD dwMaxWait, BOOL bFreeArg)
+BOOL CHPThreadPool::WaitQueueSlot(DWORD dwMaxWait)
 {
 	ASSERT(m_dwMaxQueueSize != 0);
 
 	DWORD dwTime	= ::TimeGetTime();
 	BOOL bInfinite	= (dwMaxWait == INFINITE || dwMaxWait == 0);
+	BOOL isOK		= FALSE;
 
-#if _WIN32_WINNT >= _WIN32_WINNT_WS08
+	::InterlockedIncrement(&m_lWaitSubmits);
 
-	while(CheckStarted()) 
+	while(TRUE)
 	{
-		CCriSecLock locallock(m_csQueue);
+		if(!CheckStarted())
+			break;
 
-		EnSubmitResult sr = DirectSubmit(fnTaskProc, pvArg, bFreeArg);
+		if(AcquireQueueSlot())
+		{
+			isOK = TRUE;
+			break;
+		}
 
-		if(sr == SUBMIT_OK)
-			return TRUE;
-		else if(sr == SUBMIT_ERROR)
-			return FALSE;
+		DWORD dwWait = INFINITE;
+
+		if(!bInfinite)
 		{
-			if(bInfinite)
-				m_cvQueue.Wait(m_csQueue.GetObject());
-			else
-			{
-				DWORD dwNow = ::GetTimeGap32(dwTime);
+			DWORD dwNow = ::GetTimeGap32(dwTime);
 
-				if(dwNow > dwMaxWait || !m_cvQueue.Wait(m_csQueue.GetObject(), dwMaxWait - dwNow))
-				{
-					::SetLastError(ERROR_TIMEOUT);
-					break;
-				}
+			if(dwNow >= dwMaxWait)
+			{
+				::SetLastError(ERROR_TIMEOUT);
+				break;
 			}
+
+			dwWait = dwMaxWait - dwNow;
+		}
+
+		if(::WaitForSingleObject(m_semSpace, dwWait) == WAIT_TIMEOUT)
+		{
+			::SetLastError(ERROR_TIMEOUT);
+			break;
 		}
 	}
 
-#else
+	::InterlockedDecrement(&m_lWaitSubmits);
+
+	return isOK;
+}
 
-	for(DWORD i = 0; bInfinite || ::GetTimeGap32(dwTime) <= dwMaxWait; i++)
+BOOL CHPThreadPool::AcquireQueueSlot()
+{
+	for(UINT i = 0; ; i++)
 	{
-		((i & 8191) == 8191) ? ::WaitFor(1) : ::SwitchToThread();
+		DWORD dwQueueSize = m_dwQueueSize;
+
+		if(dwQueueSize >= m_dwMaxQueueSize)
+			return FALSE;
 
-		EnSubmitResult sr = DirectSubmit(fnTaskProc, pvArg, bFreeArg);
+		DWORD dwInitialQueueSize = ::InterlockedCompareExchange(&m_dwQueueSize, dwQueueSize + 1, dwQueueSize);
 
-		if(sr == SUBMIT_OK)
+		if(dwInitialQueueSize == dwQueueSize)
 			return TRUE;
-		else if(sr == SUBMIT_ERROR)
+		else if(dwInitialQueueSize == m_dwMaxQueueSize)
 			return FALSE;
+
+		::YieldThread(i);
 	}
+}
 
-	::SetLastError(ERROR_TIMEOUT);
+void CHPThreadPool::ReleaseQueueSlot()
+{
+	if(m_dwMaxQueueSize == 0)
+		return;
 
-#endif
+	::InterlockedDecrement(&m_dwQueueSize);
 
-	return FALSE;
+	if(m_lWaitSubmits > 0)
+		m_semSpace.Release();
 }
 
 BOOL CHPThreadPool::AdjustThreadCount(DWORD dwNewThreadCount)
@@ -305,20 +518,417 @@ BOOL CHPThreadPool::AdjustThreadCount(DWORD dwNewThreadCount)
 	if(!CheckStarted())
 		return FALSE;
 
-	if(dwNewThreadCount == 0)
+	if((int)dwNewThreadCount < 0)
+		dwNewThreadCount = ::SysGetNumberOfProcessors() * (DWORD)(-(int)dwNewThreadCount);
+	else if(dwNewThreadCount == 0)
 		dwNewThreadCount = ::GetDefaultWorkerThreadCount();
 
-	HRESULT hr = m_thPool.SetSize(dwNewThreadCount);
+	if(dwNewThreadCount > MAX_WORKER_THREAD_COUNT)
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
 
-	if(!SUCCEEDED(hr))
+	return CreateWorkers(dwNewThreadCount);
+}
+
+DWORD CHPThreadPool::GetQueueSize()
+{
+	if(m_dwMaxQueueSize != 0)
+		return m_dwQueueSize;
+
+	DWORD dwSize	= 0;
+	DWORD dwSlots	= m_dwWorkerSlots;
+
+	for(DWORD i = 0; i < dwSlots; i++)
 	{
-		::SetLastError(HRESULT_CODE(hr));
+		TWorker* pWorker = m_pWorkers[i];
+		dwSize += pWorker->deque.Size() + pWorker->inbox.Size();
+	}
+
+	return dwSize;
+}
+
+BOOL CHPThreadPool::CreateWorkers(DWORD dwThreadCount)
+{
+	CCriSecLock locallock(m_csWorkers);
+
+	if(m_bQuit)
+	{
+		::SetLastError(ERROR_INVALID_STATE);
 		return FALSE;
 	}
 
+	DWORD dwOldCount = m_dwThreadCount;
+
+	if(dwThreadCount < dwOldCount)
+		m_dwThreadCount = dwThreadCount;
+
+	for(DWORD i = 0; i < dwThreadCount; i++)
+	{
+		if(i >= m_dwWorkerSlots)
+		{
+			m_pWorkers[i]	= new TWorker(this, i);
+			m_dwWorkerSlots	= i + 1;
+		}
+
+		TWorker* pWorker = m_pWorkers[i];
+
+		if(!pWorker->running && !StartWorker(pWorker))
+		{
+			m_dwThreadCount = i;
+			return FALSE;
+		}
+	}
+
+	/* 唤醒所有空闲线程，使序号超出新线程数的工作线程得以退出 */
+	if(dwThreadCount < dwOldCount)
+		m_semWork.Release((LONG)m_dwWorkerSlots);
+	else
+		m_dwThreadCount = dwThreadCount;
+
 	return TRUE;
 }
 
+BOOL CHPThreadPool::StartWorker(TWorker* pWorker)
+{
+	if(pWorker->thread != nullptr)
+	{
+		::WaitForSingleObject(pWorker->thread, INFINITE);
+		::CloseHandle(pWorker->thread);
+
+		pWorker->thread = nullptr;
+	}
+
+	pWorker->running	= TRUE;
+	pWorker->thread		= (HANDLE)_beginthreadex(nullptr, m_dwStackSize, WorkerThreadProc, (LPVOID)pWorker, 0, nullptr);
+
+	if(pWorker->thread == nullptr)
+	{
+		pWorker->running = FALSE;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL CHPThreadPool::WaitForWorkers(DWORD dwMaxWait)
+{
+	DWORD dwSlots	= m_dwWorkerSlots;
+	DWORD dwTime	= ::TimeGetTime();
+	BOOL isOK		= TRUE;
+
+	if(dwSlots > 0)
+		m_semWork.Release((LONG)dwSlots);
+
+	for(DWORD i = 0; i < dwSlots; i++)
+	{
+		TWorker* pWorker = m_pWorkers[i];
+
+		if(pWorker->thread == nullptr)
+			continue;
+
+		DWORD dwWait = INFINITE;
+
+		if(dwMaxWait != INFINITE)
+		{
+			DWORD dwNow = ::GetTimeGap32(dwTime);
+			dwWait		= (dwNow < dwMaxWait) ? (dwMaxWait - dwNow) : 0;
+		}
+
+		if(::WaitForSingleObject(pWorker->thread, dwWait) == WAIT_TIMEOUT)
+		{
+			::TerminateThread(pWorker->thread, 1);
+			isOK = FALSE;
+		}
+
+		::CloseHandle(pWorker->thread);
+
+		pWorker->thread		= nullptr;
+		pWorker->threadID	= 0;
+		pWorker->running	= FALSE;
+	}
+
+	return isOK;
+}
+
+void CHPThreadPool::DestroyWorkers()
+{
+	DWORD dwSlots = m_dwWorkerSlots;
+
+	for(DWORD i = 0; i < dwSlots; i++)
+	{
+		TWorker* pWorker	= m_pWorkers[i];
+		TTask* pTask		= nullptr;
+
+		while((pTask = pWorker->deque.Pop()) != nullptr)
+			DiscardTask(pTask);
+
+		while((pTask = pWorker->inbox.Pop()) != nullptr)
+			DiscardTask(pTask);
+
+		while((pTask = pWorker->freeTasks) != nullptr)
+		{
+			pWorker->freeTasks = pTask->next;
+			TTask::Destruct(pTask);
+		}
+
+		delete pWorker;
+		m_pWorkers[i] = nullptr;
+	}
+
+	m_dwWorkerSlots = 0;
+}
+
+BOOL CHPThreadPool::CheckWorkerExit(TWorker* pWorker)
+{
+	if(!m_bQuit && pWorker->index < m_dwThreadCount)
+		return FALSE;
+
+	CCriSecLock locallock(m_csWorkers);
+
+	if(!m_bQuit && pWorker->index < m_dwThreadCount)
+		return FALSE;
+
+	pWorker->threadID	= 0;
+	pWorker->running	= FALSE;
+
+	return TRUE;
+}
+
+CHPThreadPool::TWorker* CHPThreadPool::FindCurrentWorker()
+{
+	TWorker* pWorker = sm_pCurrentWorker;
+
+	// 其它线程池的工作线程向本线程池提交任务时按外部线程处理
+	if(pWorker != nullptr && pWorker->pool != this)
+		return nullptr;
+
+	return pWorker;
+}
+
+CHPThreadPool::TTask* CHPThreadPool::FindTask(TWorker* pWorker)
+{
+	TTask* pTask = pWorker->deque.Pop();
+
+	if(pTask == nullptr)
+		pTask = pWorker->inbox.Pop();
+
+	/* 即将退出的工作线程只清空自身队列，不再窃取其它线程的任务 */
+	if(pTask == nullptr && (m_bQuit || pWorker->index < m_dwThreadCount))
+		pTask = StealTask(pWorker);
+
+	return pTask;
+}
+
+CHPThreadPool::TTask* CHPThreadPool::StealTask(TWorker* pWorker)
+{
+	DWORD dwSlots = m_dwWorkerSlots;
+
+	for(DWORD i = 0; i < dwSlots; i++)
+	{
+		DWORD dwIndex		= (pWorker->victim + i) % dwSlots;
+		TWorker* pVictim	= m_pWorkers[dwIndex];
+
+		if(pVictim == pWorker)
+			continue;
+
+		TTask* pTask = pVictim->inbox.Pop();
+
+		if(pTask == nullptr)
+			pTask = pVictim->deque.Steal();
+
+		if(pTask != nullptr)
+		{
+			pWorker->victim = dwIndex;
+			return pTask;
+		}
+	}
+
+	return nullptr;
+}
+
+void CHPThreadPool::ExecuteTask(TWorker* pWorker, TTask* pTask)
+{
+	if(pTask->holdSlot)
+		ReleaseQueueSlot();
+
+	::InterlockedIncrement(&m_dwTaskCount);
+	pTask->fn(pTask->arg);
+	::InterlockedDecrement(&m_dwTaskCount);
+
+	if(pTask->freeArg)
+		::DestroySocketTaskObj((LPTSocketTask)pTask->arg);
+
+	FreeTask(pWorker, pTask);
+}
+
+void CHPThreadPool::WakeUpWorker()
+{
+	::MemoryBarrier();
+
+	if(m_lIdleWorkers > 0)
+		m_semWork.Release();
+}
+
+CHPThreadPool::TTask* CHPThreadPool::AllocTask(TWorker* pWorker)
+{
+	TTask* pTask = nullptr;
+
+	if(pWorker != nullptr && pWorker->freeTasks != nullptr)
+	{
+		pTask				= pWorker->freeTasks;
+		pWorker->freeTasks	= pTask->next;
+
+		--pWorker->freeCount;
+	}
+	else if(!m_lsFreeTask.TryGet(&pTask))
+		pTask = TTask::Construct();
+
+	return pTask;
+}
+
+void CHPThreadPool::FreeTask(TWorker* pWorker, TTask* pTask)
+{
+	if(pWorker != nullptr && pWorker->freeCount < LOCAL_FREE_TASK_COUNT)
+	{
+		pTask->next			= pWorker->freeTasks;
+		pWorker->freeTasks	= pTask;
+
+		++pWorker->freeCount;
+	}
+	else if(!m_lsFreeTask.TryPut(pTask))
+		TTask::Destruct(pTask);
+}
+
+void CHPThreadPool::DiscardTask(TTask* pTask)
+{
+	if(pTask->freeArg)
+		::DestroySocketTaskObj((LPTSocketTask)pTask->arg);
+
+	TTask::Destruct(pTask);
+}
+
+void CHPThreadPool::ExecuteStrand(TStrand* pStrand)
+{
+	TStrandShard& shard = GetStrandShard(pStrand->connID);
+
+	for(DWORD i = 0; ; i++)
+	{
+		LPTSocketTask pTask = nullptr;
+
+		/* 每执行一批任务后把串行队列重新排入线程池，避免繁忙连接长期占用工作线程 */
+		if(i == STRAND_BATCH_SIZE)
+		{
+			if(CheckStarted())
+			{
+				PushTask(StrandProc, (PVOID)pStrand, FALSE, FALSE, TRUE);
+				return;
+			}
+
+			i = 0;
+		}
+
+		{
+			CSpinLock locallock(shard.cs);
+
+			if(pStrand->tasks.empty())
+			{
+				shard.strands.erase(FindStrand(shard, pStrand->sender, pStrand->connID));
+				break;
+			}
+
+			pTask = pStrand->tasks.front();
+			pStrand->tasks.pop_front();
+		}
+
+		ReleaseQueueSlot();
+
+		pTask->fn(pTask);
+		::DestroySocketTaskObj(pTask);
+	}
+
+	delete pStrand;
+}
+
+void CHPThreadPool::DestroyStrands()
+{
+	for(DWORD i = 0; i < STRAND_SHARD_COUNT; i++)
+	{
+		TStrandShard& shard = m_shStrands[i];
+		CSpinLock locallock(shard.cs);
+
+		for(TStrandMap::iterator it = shard.strands.begin(), end = shard.strands.end(); it != end; ++it)
+		{
+			TStrand* pStrand = it->second;
+
+			for(size_t j = 0; j < pStrand->tasks.size(); j++)
+				::DestroySocketTaskObj(pStrand->tasks[j]);
+
+			delete pStrand;
+		}
+
+		shard.strands.clear();
+	}
+}
+
+CHPThreadPool::TStrandMap::iterator CHPThreadPool::FindStrand(TStrandShard& shard, PVOID pSender, CONNID dwConnID)
+{
+	pair<TStrandMap::iterator, TStrandMap::iterator> range = shard.strands.equal_range(dwConnID);
+
+	for(TStrandMap::iterator it = range.first; it != range.second; ++it)
+	{
+		if(it->second->sender == pSender)
+			return it;
+	}
+
+	return shard.strands.end();
+}
+
+void __HP_CALL CHPThreadPool::StrandProc(PVOID pv)
+{
+	TStrand* pStrand = (TStrand*)pv;
+	pStrand->pool->ExecuteStrand(pStrand);
+}
+
+UINT WINAPI CHPThreadPool::WorkerThreadProc(LPVOID pv)
+{
+	TWorker* pWorker		= (TWorker*)pv;
+	CHPThreadPool* pPool	= pWorker->pool;
+
+	pWorker->threadID	= SELF_THREAD_ID;
+	sm_pCurrentWorker	= pWorker;
+
+	while(TRUE)
+	{
+		TTask* pTask = pPool->FindTask(pWorker);
+
+		if(pTask == nullptr)
+		{
+			if(pPool->CheckWorkerExit(pWorker))
+				break;
+
+			::InterlockedIncrement(&pPool->m_lIdleWorkers);
+
+			pTask = pPool->FindTask(pWorker);
+
+			if(pTask == nullptr)
+				pPool->m_semWork.Wait();
+
+			::InterlockedDecrement(&pPool->m_lIdleWorkers);
+
+			if(pTask == nullptr)
+				continue;
+		}
+
+		pPool->ExecuteTask(pWorker, pTask);
+	}
+
+	sm_pCurrentWorker = nullptr;
+
+	return 0;
+}
+
 BOOL CHPThreadPool::CheckStarting()
 {
 	if(::InterlockedCompareExchange((volatile LONG*)&m_enState, SS_STARTING, SS_STOPPED) != SS_STOPPED)
@@ -358,9 +968,17 @@ BOOL CHPThreadPool::CheckStoping()
 
 void CHPThreadPool::Reset(BOOL bSetWaitEvent)
 {
+	while(::WaitForSingleObject(m_semWork, 0) == WAIT_OBJECT_0);
+	while(::WaitForSingleObject(m_semSpace, 0) == WAIT_OBJECT_0);
+
 	m_dwQueueSize		= 0;
 	m_dwTaskCount		= 0;
+	m_dwThreadCount		= 0;
 	m_dwMaxQueueSize	= 0;
+	m_dwStackSize		= 0;
+	m_lIdleWorkers		= 0;
+	m_lWaitSubmits		= 0;
+	m_bQuit				= FALSE;
 	m_enRejectedPolicy	= TRP_CALL_FAIL;
 	m_enState			= SS_STOPPED;
 
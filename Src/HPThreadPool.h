@@ -23,18 +23,10 @@
 
 #pragma once
 
-#pragma push_macro("_ATL_NO_DEFAULT_LIBS")
-
-#ifndef _ATL_NO_DEFAULT_LIBS
-	#define _ATL_NO_DEFAULT_LIBS
-#endif
-
-#include <atlutil.h>
-
-#pragma pop_macro("_ATL_NO_DEFAULT_LIBS")
-
 #include "../Include/HPSocket/SocketInterface.h"
 #include "Common/SysHelper.h"
+#include "Common/RingBuffer.h"
+#include "Common/Semaphore.h"
 
 LPTSocketTask CreateSocketTaskObj(	Fn_SocketTaskProc fnTaskProc,
 									PVOID pSender, CONNID dwConnID,
@@ -50,11 +42,13 @@ class CHPThreadPool : public IHPThreadPool
 		Fn_TaskProc	fn;
 		PVOID		arg;
 		BOOL		freeArg;
+		BOOL		holdSlot;
+		TTask*		next;
 
 	public:
-		static TTask* Construct(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg)
+		static TTask* Construct()
 		{
-			return new TTask(fnTaskProc, pvArg, bFreeArg);
+			return new TTask;
 		}
 
 		static void Destruct(TTask* pTask)
@@ -62,42 +56,142 @@ class CHPThreadPool : public IHPThreadPool
 			delete pTask;
 		}
 
+		void Reset(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg, BOOL bHoldSlot)
+		{
+			ASSERT(fnTaskProc != nullptr);
+
+			fn			= fnTaskProc;
+			arg			= pvArg;
+			freeArg		= bFreeArg;
+			holdSlot	= bHoldSlot;
+			next		= nullptr;
+		}
+
 	private:
-		TTask(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg)
-		: fn(fnTaskProc), arg(pvArg), freeArg(bFreeArg)
+		TTask()
+		: fn(nullptr), arg(nullptr), freeArg(FALSE), holdSlot(FALSE), next(nullptr)
 		{
-			ASSERT(fn != nullptr);
+
 		}
 	};
 
-	class CWorker
+	/* Chase-Lev 工作窃取队列：所有者线程在 bottom 端 Push / Pop，其它线程在 top 端 Steal */
+	class CWorkDeque
 	{
 	public:
-		typedef TTask* RequestType;
+		BOOL Push(TTask* pTask);
+		TTask* Pop();
+		TTask* Steal();
+
+		DWORD Size()	{LONG lSize = (LONG)(m_ulBottom - m_ulTop); return (DWORD)(lSize > 0 ? lSize : 0);}
+		BOOL IsEmpty()	{return (LONG)(m_ulBottom - m_ulTop) <= 0;}
+
+	public:
+		CWorkDeque()
+		: m_ulTop(0), m_ulBottom(0)
+		{
+
+		}
+
+	public:
+		static const DWORD DEQUE_SIZE = 4096;
+		static const DWORD DEQUE_MASK = DEQUE_SIZE - 1;
+
+	private:
+		volatile ULONG	m_ulTop;
+		char			pack1[CACHE_LINE - sizeof(ULONG)];
+		volatile ULONG	m_ulBottom;
+		char			pack2[CACHE_LINE - sizeof(ULONG)];
+		TTask* volatile	m_pTasks[DEQUE_SIZE];
 
+		DECLARE_NO_COPY_CLASS(CWorkDeque)
+	};
+
+	/* 外部线程提交的任务先进入目标工作线程的收件箱（FIFO），由该线程或窃取线程取出 */
+	class CInbox
+	{
 	public:
-		BOOL Initialize(PVOID pvWorkerParam);
-		void Execute(TTask* pTask, PVOID pvWorkerParam, OVERLAPPED* pOverlapped);
-		void Terminate(PVOID pvWorkerParam);
+		void Push(TTask* pTask);
+		TTask* Pop();
+
+		DWORD Size()	{return m_dwSize;}
+		BOOL IsEmpty()	{return m_dwSize == 0;}
 
 	public:
-		CWorker() 
-		: m_pthPool(nullptr)
+		CInbox()
+		: m_pHead(nullptr), m_pTail(nullptr), m_dwSize(0)
 		{
 
 		}
 
 	private:
-		CHPThreadPool* m_pthPool;
+		CSpinGuard		m_cs;
+		TTask*			m_pHead;
+		TTask*			m_pTail;
+		volatile DWORD	m_dwSize;
+
+		DECLARE_NO_COPY_CLASS(CInbox)
 	};
 
-	typedef CThreadPool<CWorker> CInnerThreadPool;
+	struct TWorker
+	{
+		CHPThreadPool*	pool;
+		DWORD			index;
+		HANDLE			thread;
+		volatile DWORD	threadID;
+		volatile BOOL	running;
+		DWORD			victim;
+
+		TTask*			freeTasks;
+		DWORD			freeCount;
 
-	friend class CWorker;
+		char			pack1[CACHE_LINE];
+		CInbox			inbox;
+		char			pack2[CACHE_LINE];
+		CWorkDeque		deque;
+
+	public:
+		TWorker(CHPThreadPool* pPool, DWORD dwIndex)
+		: pool(pPool), index(dwIndex), thread(nullptr), threadID(0), running(FALSE)
+		, victim(dwIndex + 1), freeTasks(nullptr), freeCount(0)
+		{
+
+		}
+	};
+
+	/* 以 (sender, CONNID) 为键的串行执行队列：同一时刻最多只有一个线程池任务在执行其中的任务 */
+	struct TStrand
+	{
+		CHPThreadPool*			pool;
+		PVOID					sender;
+		CONNID					connID;
+		deque<LPTSocketTask>	tasks;
+
+	public:
+		TStrand(CHPThreadPool* pPool, PVOID pSender, CONNID dwConnID)
+		: pool(pPool), sender(pSender), connID(dwConnID)
+		{
+
+		}
+	};
+
+	typedef unordered_multimap<CONNID, TStrand*>	TStrandMap;
+
+	struct TStrandShard
+	{
+		CSpinGuard	cs;
+		TStrandMap	strands;
+	};
 
 private:
 	enum EnSubmitResult{SUBMIT_OK, SUBMIT_FULL, SUBMIT_ERROR};
 
+	static const DWORD LOCAL_FREE_TASK_COUNT	= 256;
+	static const DWORD DEFAULT_TASK_POOL_SIZE	= 4096;
+	static const DWORD STRAND_SHARD_COUNT		= 64;
+	static const DWORD STRAND_SHARD_MASK		= STRAND_SHARD_COUNT - 1;
+	static const DWORD STRAND_BATCH_SIZE		= 64;
+
 public:
 	virtual BOOL Start(DWORD dwThreadCount = 0, DWORD dwMaxQueueSize = 0, EnRejectedPolicy enRejectedPolicy = TRP_CALL_FAIL, DWORD dwStackSize = 0);
 	virtual BOOL Stop(DWORD dwMaxWait = INFINITE);
@@ -105,15 +199,16 @@ public:
 
 	virtual BOOL Submit(Fn_TaskProc fnTaskProc, PVOID pvArg, DWORD dwMaxWait = INFINITE);
 	virtual BOOL Submit(LPTSocketTask pTask, DWORD dwMaxWait = INFINITE);
+	virtual BOOL SubmitSerial(LPTSocketTask pTask, DWORD dwMaxWait = INFINITE);
 	virtual BOOL AdjustThreadCount(DWORD dwNewThreadCount);
 
 public:
 	virtual BOOL HasStarted()						{return m_enState == SS_STARTED || m_enState == SS_STARTING;}
 	virtual EnServiceState GetState()				{return m_enState;}
 
-	virtual DWORD GetQueueSize()					{return m_dwQueueSize;}
+	virtual DWORD GetQueueSize();
 	virtual DWORD GetTaskCount()					{return m_dwTaskCount;}
-	virtual DWORD GetThreadCount()					{return (DWORD)m_thPool.GetNumThreads();}
+	virtual DWORD GetThreadCount()					{return m_dwThreadCount;}
 	virtual DWORD GetMaxQueueSize()					{return m_dwMaxQueueSize;}
 	virtual EnRejectedPolicy GetRejectedPolicy()	{return m_enRejectedPolicy;}
 
@@ -123,13 +218,50 @@ private:
 	BOOL CheckStoping();
 
 	EnSubmitResult DirectSubmit(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg);
-	BOOL CycleWaitSubmit(Fn_TaskProc fnTaskProc, PVOID pvArg, DWORD dwMaxWait, BOOL bFreeArg);
+	BOOL WaitSubmit(Fn_TaskProc fnTaskProc, PVOID pvArg, DWORD dwMaxWait, BOOL bFreeArg);
 	BOOL DoSubmit(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg, DWORD dwMaxWait);
+	void PushTask(Fn_TaskProc fnTaskProc, PVOID pvArg, BOOL bFreeArg, BOOL bHoldSlot, BOOL bYield = FALSE);
+
+	BOOL AcquireQueueSlot();
+	BOOL WaitQueueSlot(DWORD dwMaxWait);
+	void ReleaseQueueSlot();
+
+	BOOL CreateWorkers(DWORD dwThreadCount);
+	BOOL StartWorker(TWorker* pWorker);
+	BOOL WaitForWorkers(DWORD dwMaxWait);
+	void DestroyWorkers();
+	BOOL CheckWorkerExit(TWorker* pWorker);
+
+	TWorker* FindCurrentWorker();
+	TTask* FindTask(TWorker* pWorker);
+	TTask* StealTask(TWorker* pWorker);
+	void ExecuteTask(TWorker* pWorker, TTask* pTask);
+	void WakeUpWorker();
+
+	TTask* AllocTask(TWorker* pWorker);
+	void FreeTask(TWorker* pWorker, TTask* pTask);
+	void DiscardTask(TTask* pTask);
+
+	BOOL CallerRunStrand(LPTSocketTask pTask);
+	void ExecuteStrand(TStrand* pStrand);
+	void DestroyStrands();
+
+	TStrandMap::iterator FindStrand(TStrandShard& shard, PVOID pSender, CONNID dwConnID);
+
+	TStrandShard& GetStrandShard(CONNID dwConnID) {return m_shStrands[dwConnID & STRAND_SHARD_MASK];}
+
+	static UINT WINAPI WorkerThreadProc(LPVOID pv);
+	static void __HP_CALL StrandProc(PVOID pv);
 
 public:
 	CHPThreadPool()
 	: m_evWait(TRUE, TRUE)
+	, m_semWork(MAXLONG)
+	, m_semSpace(MAXLONG)
+	, m_dwWorkerSlots(0)
 	{
+		::ZeroMemory(m_pWorkers, sizeof(m_pWorkers));
+
 		Reset(FALSE);
 	}
 
@@ -143,20 +275,30 @@ private:
 
 private:
 	CEvt					m_evWait;
-
-#if _WIN32_WINNT >= _WIN32_WINNT_WS08
-	CCriSec					m_csQueue;
-	CConVar					m_cvQueue;
-#endif
+	CSEM					m_semWork;
+	CSEM					m_semSpace;
+	CCriSec					m_csWorkers;
 
 	DWORD					m_dwMaxQueueSize;
+	DWORD					m_dwStackSize;
 	EnRejectedPolicy		m_enRejectedPolicy;
 
+	volatile DWORD			m_dwThreadCount;
+	volatile DWORD			m_dwWorkerSlots;
+	volatile BOOL			m_bQuit;
+	volatile EnServiceState	m_enState;
+
 	volatile DWORD			m_dwQueueSize;
 	volatile DWORD			m_dwTaskCount;
-	volatile EnServiceState	m_enState;
+	volatile LONG			m_lIdleWorkers;
+	volatile LONG			m_lWaitSubmits;
+
+	CRingPool<TTask>		m_lsFreeTask;
+	TWorker*				m_pWorkers[MAX_WORKER_THREAD_COUNT];
+	TStrandShard			m_shStrands[STRAND_SHARD_COUNT];
 
-	CInnerThreadPool		m_thPool;
+	/* 当前线程所属的工作线程对象（非工作线程为 nullptr） */
+	static thread_local TWorker* sm_pCurrentWorker;
 
 	DECLARE_NO_COPY_CLASS(CHPThreadPool)
 };
@@ -73,9 +73,20 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendR
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendLocalFile(CONNID dwConnID, LPCSTR lpszFileName, USHORT usStatusCode, LPCSTR lpszDesc, const THeader lpHeaders[], int iHeaderCount)
 {
 	CAtlFile file;
-	CAtlFileMapping<> fmap;
+	ULONGLONG ullLen = 0;
 
-	HRESULT hr = ::ReadSmallFile(CA2T(lpszFileName), file, fmap);
+	HRESULT hr = file.Create(CA2T(lpszFileName), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN);
+
+	if(SUCCEEDED(hr))
+		hr = file.GetSize(ullLen);
+
+	if(SUCCEEDED(hr))
+	{
+		if(ullLen == 0)
+			hr = HRESULT_FROM_WIN32(ERROR_FILE_INVALID);
+		else if(ullLen > MAXLONG)
+			hr = HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+	}
 
 	if(FAILED(hr))
 	{
@@ -83,7 +94,16 @@ template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendL
 		return FALSE;
 	}
 
-	return SendResponse(dwConnID, usStatusCode, lpszDesc, lpHeaders, iHeaderCount, (BYTE*)(char*)fmap, (int)fmap.GetMappingSize());
+	CStringA strHeader;
+
+	::MakeStatusLine(m_enLocalVersion, usStatusCode, lpszDesc, strHeader);
+	::MakeHeaderLines(lpHeaders, iHeaderCount, nullptr, (int)ullLen, FALSE, IsKeepAlive(dwConnID), nullptr, 0, strHeader);
+
+	WSABUF bufHead;
+	bufHead.buf = (LPSTR)(LPCSTR)strHeader;
+	bufHead.len = strHeader.GetLength();
+
+	return DoSendFile(dwConnID, file, 0, ullLen, &bufHead, nullptr);
 }
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::SendChunkData(CONNID dwConnID, const BYTE* pData, int iLength, LPCSTR lpszExtensions)
@@ -512,6 +532,8 @@ template<class T, USHORT default_port> inline typename CHttpServerT<T, default_p
 
 template<class T, USHORT default_port> BOOL CHttpServerT<T, default_port>::StartHttp(CONNID dwConnID)
 {
+	CEpochLock epochlock(GetSocketEpoch());
+
 	if(IsHttpAutoStart())
 	{
 		::SetLastError(ERROR_INVALID_OPERATION);
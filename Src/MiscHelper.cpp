@@ -50,3 +50,69 @@ BOOL AddPackHeader(const WSABUF * pBuffers, int iCount, unique_ptr<WSABUF[]>& bu
 
 	return TRUE;
 }
+
+BOOL ParsePackHeader(DWORD dwHeader, DWORD dwMaxPackSize, USHORT usPackHeaderFlag, DWORD& dwLength)
+{
+	dwHeader = ::HToLE32(dwHeader);
+
+	if(usPackHeaderFlag != 0)
+	{
+		USHORT flag = (USHORT)(dwHeader >> TCP_PACK_LENGTH_BITS);
+
+		if(flag != usPackHeaderFlag)
+		{
+			::SetLastError(ERROR_INVALID_DATA);
+			return FALSE;
+		}
+	}
+
+	dwLength = dwHeader & TCP_PACK_LENGTH_MASK;
+
+	if(dwLength == 0 || dwLength > dwMaxPackSize)
+	{
+		::SetLastError(ERROR_BAD_LENGTH);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+BOOL TFrameSpec::IsValid() const
+{
+	return	(headerSize > 0 && headerSize <= TCP_FRAMED_MAX_HEADER_SIZE)	&&
+			(lengthSize >= 1 && lengthSize <= sizeof(DWORD))				&&
+			(lengthOffset + lengthSize <= headerSize)						&&
+			(maxFrameSize >= headerSize && maxFrameSize <= TCP_FRAMED_MAX_SIZE_LIMIT);
+}
+
+BOOL TFrameSpec::ParseHeader(const BYTE* pHeader, DWORD& dwFrameSize) const
+{
+	const BYTE* pField	= pHeader + lengthOffset;
+	ULONGLONG ullValue	= 0;
+
+	if(bigEndian)
+	{
+		for(DWORD i = 0; i < lengthSize; i++)
+			ullValue = (ullValue << 8) | pField[i];
+	}
+	else
+	{
+		for(DWORD i = lengthSize; i > 0; i--)
+			ullValue = (ullValue << 8) | pField[i - 1];
+	}
+
+	LONGLONG llFrameSize = (LONGLONG)ullValue + adjustment;
+
+	if(!includeHeader)
+		llFrameSize += headerSize;
+
+	if(llFrameSize < (LONGLONG)headerSize || llFrameSize > (LONGLONG)maxFrameSize)
+	{
+		::SetLastError(ERROR_BAD_LENGTH);
+		return FALSE;
+	}
+
+	dwFrameSize = (DWORD)llFrameSize;
+
+	return TRUE;
+}
@@ -28,9 +28,10 @@
 /* Pack Data Info */
 template<typename B = void> struct TPackInfo
 {
-	bool	header;
-	DWORD	length;
-	B*		pBuffer;
+	bool		header;
+	DWORD		length;
+	B*			pBuffer;
+	CBufferPtr	scratch;
 
 	static TPackInfo* Construct(B* pbuf = nullptr, bool head = true, DWORD len = sizeof(DWORD))
 	{
@@ -53,11 +54,98 @@ template<typename B = void> struct TPackInfo
 		header	= true;
 		length	= sizeof(DWORD);
 		pBuffer	= nullptr;
+
+		scratch.Free();
+	}
+
+	/* 获取包体重组缓冲区（容量不足时才重新分配） */
+	BYTE* GetScratch(int iLength)
+	{
+		if((int)scratch.Size() < iLength)
+			scratch.Malloc(iLength);
+
+		return scratch;
 	}
 };
 
 typedef TPackInfo<TBuffer>	TBufferPackInfo;
 
+inline TItem* GetFrontItem(TBuffer* pBuffer)		{return pBuffer->ItemList().Front();}
+inline TItem* GetFrontItem(TItemListEx* pBuffer)	{return pBuffer->Front();}
+
+BOOL ParsePackHeader(DWORD dwHeader, DWORD dwMaxPackSize, USHORT usPackHeaderFlag, DWORD& dwLength);
+
+/* Length Field Frame Spec */
+struct TFrameSpec
+{
+	DWORD	headerSize;
+	DWORD	lengthOffset;
+	DWORD	lengthSize;
+	BOOL	bigEndian;
+	BOOL	includeHeader;
+	int		adjustment;
+	DWORD	maxFrameSize;
+
+	/* 检查帧格式参数是否合法 */
+	BOOL IsValid() const;
+	/* 从帧头解析帧总长度（包含帧头） */
+	BOOL ParseHeader(const BYTE* pHeader, DWORD& dwFrameSize) const;
+
+	TFrameSpec()
+	: headerSize	(TCP_FRAMED_DEFAULT_HEADER_SIZE)
+	, lengthOffset	(TCP_FRAMED_DEFAULT_LENGTH_OFFSET)
+	, lengthSize	(TCP_FRAMED_DEFAULT_LENGTH_SIZE)
+	, bigEndian		(FALSE)
+	, includeHeader	(FALSE)
+	, adjustment	(0)
+	, maxFrameSize	(TCP_FRAMED_DEFAULT_MAX_SIZE)
+	{
+	}
+};
+
+/* Framed Data Info */
+template<typename B = void> struct TFramedInfo
+{
+	DWORD		length;
+	B*			pBuffer;
+	CBufferPtr	scratch;
+
+	static TFramedInfo* Construct(B* pbuf = nullptr)
+	{
+		return new TFramedInfo(pbuf);
+	}
+
+	static void Destruct(TFramedInfo* pFramedInfo)
+	{
+		if(pFramedInfo)
+			delete pFramedInfo;
+	}
+
+	TFramedInfo(B* pbuf = nullptr)
+	: length(0), pBuffer(pbuf)
+	{
+	}
+
+	void Reset()
+	{
+		length	= 0;
+		pBuffer	= nullptr;
+
+		scratch.Free();
+	}
+
+	/* 获取帧重组缓冲区（容量不足时才重新分配） */
+	BYTE* GetScratch(int iLength)
+	{
+		if((int)scratch.Size() < iLength)
+			scratch.Malloc(iLength);
+
+		return scratch;
+	}
+};
+
+typedef TFramedInfo<TBuffer>	TBufferFramedInfo;
+
 BOOL AddPackHeader(const WSABUF * pBuffers, int iCount, unique_ptr<WSABUF[]>& buffers, DWORD dwMaxPackSize, USHORT usPackHeaderFlag, DWORD& dwHeader);
 
 template<class B> EnFetchResult FetchBuffer(B* pBuffer, BYTE* pData, int iLength)
@@ -103,57 +191,248 @@ template<class T, class B, class S> EnHandleResult ParsePack(T* pThis, TPackInfo
 			break;
 
 		remain -= required;
-		CBufferPtr buffer(required);
-
-		pBuffer->Fetch(buffer, (int)buffer.Size());
 
 		if(pInfo->header)
 		{
-			DWORD header = ::HToLE32(*((DWORD*)(byte*)buffer));
+			DWORD header;
+			pBuffer->Fetch((BYTE*)&header, sizeof(DWORD));
 
-			if(usPackHeaderFlag != 0)
+			DWORD len;
+			if(!::ParsePackHeader(header, dwMaxPackSize, usPackHeaderFlag, len))
+				return HR_ERROR;
+
+			required = len;
+		}
+		else
+		{
+			TItem* pItem = GetFrontItem(pBuffer);
+
+			// 包体位于同一个 TItem 中时直接从缓存触发，否则重组到 scratch 缓冲区
+			if(pItem->Size() >= required)
 			{
-				USHORT flag = (USHORT)(header >> TCP_PACK_LENGTH_BITS);
+				rs = pThis->DoFireSuperReceive(pSocket, pItem->Ptr(), required);
+
+				if(rs == HR_ERROR)
+					return rs;
 
-				if(flag != usPackHeaderFlag)
-				{
-					::SetLastError(ERROR_INVALID_DATA);
-					return HR_ERROR;
-				}
+				pBuffer->Reduce(required);
 			}
+			else
+			{
+				BYTE* pScratch = pInfo->GetScratch(required);
+				pBuffer->Fetch(pScratch, required);
 
-			DWORD len = header & TCP_PACK_LENGTH_MASK;
+				rs = pThis->DoFireSuperReceive(pSocket, pScratch, required);
 
-			if(len == 0 || len > dwMaxPackSize)
-			{
-				::SetLastError(ERROR_BAD_LENGTH);
-				return HR_ERROR;
+				if(rs == HR_ERROR)
+					return rs;
 			}
 
-			required = len;
+			required = sizeof(DWORD);
+		}
+
+		pInfo->header = !pInfo->header;
+		pInfo->length = required;
+	}
+
+	return rs;
+}
+
+template<class T, class B, class S> EnHandleResult ParsePack(T* pThis, TPackInfo<B>* pInfo, B* pBuffer, S* pSocket, DWORD dwMaxPackSize, USHORT usPackHeaderFlag, const BYTE* pData, int iLength)
+{
+	EnHandleResult rs = HR_OK;
+
+	if(pBuffer->Length() > 0)
+	{
+		int iFill = (int)pInfo->length - pBuffer->Length();
+
+		if(iFill <= 0 || iFill >= iLength)
+		{
+			pBuffer->Cat(pData, iLength);
+			return ParsePack(pThis, pInfo, pBuffer, pSocket, dwMaxPackSize, usPackHeaderFlag);
+		}
+
+		// 只补齐缓存中不完整的包头或包体，剩余数据走零拷贝路径
+		pBuffer->Cat(pData, iFill);
+
+		pData	+= iFill;
+		iLength	-= iFill;
+
+		rs = ParsePack(pThis, pInfo, pBuffer, pSocket, dwMaxPackSize, usPackHeaderFlag);
+
+		if(rs == HR_ERROR)
+			return rs;
+
+		if(pBuffer->Length() > 0)
+		{
+			pBuffer->Cat(pData, iLength);
+			return rs;
+		}
+	}
+
+	while(iLength >= (int)pInfo->length)
+	{
+		if(pSocket->IsPaused())
+			break;
+
+		int required = pInfo->length;
+
+		if(pInfo->header)
+		{
+			DWORD header;
+			memcpy(&header, pData, sizeof(DWORD));
+
+			DWORD len;
+			if(!::ParsePackHeader(header, dwMaxPackSize, usPackHeaderFlag, len))
+				return HR_ERROR;
+
+			pInfo->length = len;
 		}
 		else
 		{
-			rs = pThis->DoFireSuperReceive(pSocket, (const BYTE*)buffer, (int)buffer.Size());
+			rs = pThis->DoFireSuperReceive(pSocket, pData, required);
 
 			if(rs == HR_ERROR)
 				return rs;
 
-			required = sizeof(DWORD);
+			pInfo->length = sizeof(DWORD);
 		}
 
 		pInfo->header = !pInfo->header;
-		pInfo->length = required;
+
+		pData	+= required;
+		iLength	-= required;
 	}
 
+	if(iLength > 0)
+		pBuffer->Cat(pData, iLength);
+
 	return rs;
 }
 
-template<class T, class B, class S> EnHandleResult ParsePack(T* pThis, TPackInfo<B>* pInfo, B* pBuffer, S* pSocket, DWORD dwMaxPackSize, USHORT usPackHeaderFlag, const BYTE* pData, int iLength)
+template<class T, class B, class S> EnHandleResult ParseFrame(T* pThis, TFramedInfo<B>* pInfo, B* pBuffer, S* pSocket, const TFrameSpec& spec)
 {
-	pBuffer->Cat(pData, iLength);
+	EnHandleResult rs = HR_OK;
 
-	return ParsePack(pThis, pInfo, pBuffer, pSocket, dwMaxPackSize, usPackHeaderFlag);
+	while(TRUE)
+	{
+		if(pSocket->IsPaused())
+			break;
+
+		int remain = pBuffer->Length();
+
+		if(pInfo->length == 0)
+		{
+			if(remain < (int)spec.headerSize)
+				break;
+
+			BYTE header[TCP_FRAMED_MAX_HEADER_SIZE];
+			pBuffer->Peek(header, (int)(spec.lengthOffset + spec.lengthSize));
+
+			if(!spec.ParseHeader(header, pInfo->length))
+				return HR_ERROR;
+		}
+
+		int required = (int)pInfo->length;
+
+		if(remain < required)
+			break;
+
+		TItem* pItem = GetFrontItem(pBuffer);
+
+		// 数据帧位于同一个 TItem 中时直接从缓存触发，否则重组到 scratch 缓冲区
+		if(pItem->Size() >= required)
+		{
+			rs = pThis->DoFireSuperReceive(pSocket, pItem->Ptr(), required);
+
+			if(rs == HR_ERROR)
+				return rs;
+
+			pBuffer->Reduce(required);
+		}
+		else
+		{
+			BYTE* pScratch = pInfo->GetScratch(required);
+			pBuffer->Fetch(pScratch, required);
+
+			rs = pThis->DoFireSuperReceive(pSocket, pScratch, required);
+
+			if(rs == HR_ERROR)
+				return rs;
+		}
+
+		pInfo->length = 0;
+	}
+
+	return rs;
+}
+
+template<class T, class B, class S> EnHandleResult ParseFrame(T* pThis, TFramedInfo<B>* pInfo, B* pBuffer, S* pSocket, const TFrameSpec& spec, const BYTE* pData, int iLength)
+{
+	EnHandleResult rs = HR_OK;
+
+	while(pBuffer->Length() > 0)
+	{
+		int iFill = (int)(pInfo->length == 0 ? spec.headerSize : pInfo->length) - pBuffer->Length();
+
+		if(iFill <= 0 || iFill >= iLength)
+		{
+			pBuffer->Cat(pData, iLength);
+			return ParseFrame(pThis, pInfo, pBuffer, pSocket, spec);
+		}
+
+		// 只补齐缓存中不完整的帧头或数据帧，剩余数据走零拷贝路径
+		pBuffer->Cat(pData, iFill);
+
+		pData	+= iFill;
+		iLength	-= iFill;
+
+		rs = ParseFrame(pThis, pInfo, pBuffer, pSocket, spec);
+
+		if(rs == HR_ERROR)
+			return rs;
+
+		if(pSocket->IsPaused())
+		{
+			pBuffer->Cat(pData, iLength);
+			return rs;
+		}
+	}
+
+	while(iLength > 0)
+	{
+		if(pSocket->IsPaused())
+			break;
+
+		if(pInfo->length == 0)
+		{
+			if(iLength < (int)spec.headerSize)
+				break;
+
+			if(!spec.ParseHeader(pData, pInfo->length))
+				return HR_ERROR;
+		}
+
+		int required = (int)pInfo->length;
+
+		if(iLength < required)
+			break;
+
+		rs = pThis->DoFireSuperReceive(pSocket, pData, required);
+
+		if(rs == HR_ERROR)
+			return rs;
+
+		pInfo->length = 0;
+
+		pData	+= required;
+		iLength	-= required;
+	}
+
+	if(iLength > 0)
+		pBuffer->Cat(pData, iLength);
+
+	return rs;
 }
 
 template<class T> BOOL ContinueReceive(T* pThis, TSocketObj* pSocketObj, TBufferObj* pBufferObj, EnHandleResult& hr)
@@ -68,6 +68,8 @@ void CSSLServer::OnWorkerThreadEnd(THR_ID dwThreadID)
 
 BOOL CSSLServer::SendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock(GetSocketEpoch());
+
 	ASSERT(pBuffers && iCount > 0);
 
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -123,6 +125,8 @@ EnHandleResult CSSLServer::FireClose(TSocketObj* pSocketObj, EnSocketOperation e
 
 BOOL CSSLServer::StartSSLHandShake(CONNID dwConnID)
 {
+	CEpochLock epochlock(GetSocketEpoch());
+
 	if(IsSSLAutoHandShake())
 	{
 		::SetLastError(ERROR_INVALID_OPERATION);
@@ -186,6 +190,8 @@ void CSSLServer::DoSSLHandShake(TSocketObj* pSocketObj)
 
 BOOL CSSLServer::GetSSLSessionInfo(CONNID dwConnID, EnSSLSessionInfo enInfo, LPVOID* lppInfo)
 {
+	CEpochLock epochlock(GetSocketEpoch());
+
 	ASSERT(lppInfo != nullptr);
 
 	*lppInfo				= nullptr;
@@ -73,6 +73,10 @@ protected:
 
 	virtual void OnWorkerThreadEnd(THR_ID dwThreadID);
 
+	virtual BOOL IsZeroCopySendable() {return FALSE;}
+	virtual BOOL IsSharedSendable	() {return FALSE;}
+	virtual BOOL IsTransmitSendable	() {return FALSE;}
+
 protected:
 	virtual BOOL StartSSLHandShake(TSocketObj* pSocketObj);
 
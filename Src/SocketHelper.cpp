@@ -571,11 +571,30 @@ BOOL PostIocpTimeout(HANDLE hIOCP, CONNID dwConnID)
 	return PostIocpCommand(hIOCP, IOCP_CMD_TIMEOUT, dwConnID);
 }
 
+BOOL PostIocpWatermark(HANDLE hIOCP, CONNID dwConnID)
+{
+	return PostIocpCommand(hIOCP, IOCP_CMD_WATERMARK, dwConnID);
+}
+
 BOOL PostIocpClose(HANDLE hIOCP, CONNID dwConnID, int iErrorCode)
 {
 	return PostIocpCommand(hIOCP, (EnIocpCommand)iErrorCode, dwConnID);
 }
 
+BOOL PostIocpMail(HANDLE hIOCP, CONNID dwConnID, TBufferObj* pBufferObj)
+{
+	pBufferObj->operation = (EnSocketOperation)SO_MAIL;
+
+	return ::PostQueuedCompletionStatus(hIOCP, 0, dwConnID, &pBufferObj->ov);
+}
+
+BOOL PostIocpAccepted(HANDLE hIOCP, CONNID dwConnID, TBufferObj* pBufferObj)
+{
+	pBufferObj->operation = (EnSocketOperation)SO_ACCEPTED;
+
+	return ::PostQueuedCompletionStatus(hIOCP, 0, dwConnID, &pBufferObj->ov);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 
 int SSO_SetSocketOption(SOCKET sock, int level, int name, LPVOID val, int len)
@@ -740,6 +759,16 @@ int SSO_UDP_ConnReset(SOCKET sock, BOOL bNewBehavior)
 	return result;
 }
 
+int SSO_UDP_SendMsgSize(SOCKET sock, DWORD dwMsgSize)
+{
+#ifdef UDP_SEND_MSG_SIZE
+	return setsockopt(sock, IPPROTO_UDP, UDP_SEND_MSG_SIZE, (CHAR*)&dwMsgSize, sizeof(DWORD));
+#else
+	::WSASetLastError(WSAENOPROTOOPT);
+	return SOCKET_ERROR;
+#endif
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 
 CONNID GenerateConnectionID()
@@ -884,6 +913,48 @@ int PostSendNotCheck(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
 	return result;
 }
 
+int PostTransmitFile(LPFN_TRANSMITFILE pfnTransmitFile, TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	int result = PostTransmitFileNotCheck(pfnTransmitFile, pSocketObj, pBufferObj);
+
+	if(result == WSA_IO_PENDING)
+		result = NO_ERROR;
+
+	return result;
+}
+
+int PostTransmitFileNotCheck(LPFN_TRANSMITFILE pfnTransmitFile, TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	TFileTransfer* pTransfer = pBufferObj->transfer;
+	ASSERT(pTransfer != nullptr);
+
+	int result				= NO_ERROR;
+	pBufferObj->client		= pSocketObj->socket;
+	pBufferObj->operation	= SO_SEND;
+
+	pBufferObj->ResetOV();
+	pBufferObj->ov.Offset		= (DWORD)(pTransfer->offset);
+	pBufferObj->ov.OffsetHigh	= (DWORD)(pTransfer->offset >> 32);
+
+	HANDLE hFile = (pTransfer->sending > 0) ? (HANDLE)pTransfer->file : nullptr;
+	LPTRANSMIT_FILE_BUFFERS lpBuffers = (pTransfer->buffers.HeadLength > 0 || pTransfer->buffers.TailLength > 0) ? &pTransfer->buffers : nullptr;
+
+	if(!pfnTransmitFile	(
+							pBufferObj->client,
+							hFile,
+							pTransfer->sending,
+							0,
+							&pBufferObj->ov,
+							lpBuffers,
+							0
+						))
+	{
+		result = ::WSAGetLastError();
+	}
+
+	return result;
+}
+
 int PostReceive(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
 {
 	int result = PostReceiveNotCheck(pSocketObj, pBufferObj);
@@ -35,6 +35,8 @@
 #include "Common/FuncHelper.h"
 #include "Common/BufferPool.h"
 #include "Common/RingBuffer.h"
+#include "Common/TimingWheel.h"
+#include "Common/Epoch.h"
 
 #ifdef _ZLIB_SUPPORT
 #include <zutil.h>
@@ -57,13 +59,23 @@
 #define MIN_SOCKET_BUFFER_SIZE					88
 /* 小文件最大字节数 */
 #define MAX_SMALL_FILE_SIZE						0x3FFFFF
+/* 流式发送文件时每次 TransmitFile() 投递的最大文件字节数 */
+#define TRANSMIT_FILE_CHUNK_SIZE				0x100000
 /* 最大连接时长 */
 #define MAX_CONNECTION_PERIOD					(MAXLONG / 2)
 /* IOCP 处理接收事件时最大额外读取次数 */
 #define MAX_IOCP_CONTINUE_RECEIVE				30
-
-/* Server/Agent 最大连接数 */
-#define MAX_CONNECTION_COUNT					(5 * 1000 * 1000)
+/* IOCP 工作线程每次批量获取的最大完成通知数 */
+#define MAX_IOCP_BATCH_ENTRIES					32
+/* 零字节接收模式下接收通知对象的缓冲区大小 */
+#define RECV_NOTIFY_BUFFER_SIZE					16
+
+/* Server/Agent 最大连接数（32 位平台受连接 ID 代数位数限制） */
+#if !defined(_WIN64)
+	#define MAX_CONNECTION_COUNT				(1000 * 1000)
+#else
+	#define MAX_CONNECTION_COUNT				(5 * 1000 * 1000)
+#endif
 /* Server/Agent 默认最大连接数 */
 #define DEFAULT_CONNECTION_COUNT				10000
 /* Server/Agent 默认 Socket 缓存对象锁定时间 */
@@ -125,6 +137,19 @@
 /* TCP Pack 包头默认标识值 */
 #define TCP_PACK_DEFAULT_HEADER_FLAG			0x000000
 
+/* TCP Framed 帧头最大长度 */
+#define TCP_FRAMED_MAX_HEADER_SIZE				256
+/* TCP Framed 帧头默认长度 */
+#define TCP_FRAMED_DEFAULT_HEADER_SIZE			4
+/* TCP Framed 长度字段默认偏移量 */
+#define TCP_FRAMED_DEFAULT_LENGTH_OFFSET		0
+/* TCP Framed 长度字段默认字节数 */
+#define TCP_FRAMED_DEFAULT_LENGTH_SIZE			4
+/* TCP Framed 帧最大长度硬限制 */
+#define TCP_FRAMED_MAX_SIZE_LIMIT				0xFFFFFFF
+/* TCP Framed 帧默认最大长度 */
+#define TCP_FRAMED_DEFAULT_MAX_SIZE				0x040000
+
 #define PORT_SEPARATOR_CHAR						':'
 #define IPV6_ADDR_BEGIN_CHAR					'['
 #define IPV6_ADDR_END_CHAR						']'
@@ -334,6 +359,13 @@ typedef struct hp_sockaddr
 // 连接已关闭
 #define HR_CLOSED	0xFF
 
+/* Server 组件内部使用的 Socket 操作类型常量 */
+
+// 跨线程发送数据（转交连接所属工作线程）
+#define SO_MAIL		0xFF
+// 已接受的连接（转交连接所属工作线程）
+#define SO_ACCEPTED	0xFE
+
 /* 关闭连接标识 */
 enum EnSocketCloseFlag
 {
@@ -342,6 +374,48 @@ enum EnSocketCloseFlag
 	SCF_ERROR		= 2		// 触发 异常关闭 OnClose 事件
 };
 
+/* 共享发送缓冲区结构（数据只读，由调用者提供，引用计数归零时归还调用者） */
+struct TSharedBuffer
+{
+	const BYTE*				data;
+	int						length;
+	Fn_SendBufferRelease	fnRelease;
+	PVOID					pvArg;
+	volatile LONG			refCount;
+
+	static TSharedBuffer* Construct(const BYTE* pData, int iLength, Fn_SendBufferRelease fnRelease, PVOID pvArg)
+	{
+		return new TSharedBuffer(pData, iLength, fnRelease, pvArg);
+	}
+
+	void AddRef()
+	{
+		::InterlockedIncrement(&refCount);
+	}
+
+	void Release()
+	{
+		if(::InterlockedDecrement(&refCount) == 0)
+		{
+			if(fnRelease != nullptr)
+				fnRelease(data, length, pvArg);
+
+			delete this;
+		}
+	}
+
+private:
+	TSharedBuffer(const BYTE* pData, int iLength, Fn_SendBufferRelease fn, PVOID pv)
+	: data		(pData)
+	, length	(iLength)
+	, fnRelease	(fn)
+	, pvArg		(pv)
+	, refCount	(1)
+	{
+		ASSERT(data != nullptr && length > 0);
+	}
+};
+
 /* 数据缓冲区基础结构 */
 template<class T> struct TBufferObjBase
 {
@@ -354,6 +428,8 @@ template<class T> struct TBufferObjBase
 	int					capacity;
 	volatile LONG		sndCounter;
 
+	TSharedBuffer*		shared;
+
 	T* next;
 	T* last;
 
@@ -387,10 +463,37 @@ template<class T> struct TBufferObjBase
 	TBufferObjBase(CPrivateHeap& hp, DWORD dwCapacity)
 	: heap(hp)
 	, capacity((int)dwCapacity)
+	, sndCounter(0)
+	, shared(nullptr)
 	{
 		ASSERT(capacity > 0);
 	}
 
+	void AttachShared(TSharedBuffer* pShared, int iOffset, int iLength)
+	{
+		ASSERT(shared == nullptr && iOffset >= 0 && iLength > 0 && iOffset + iLength <= pShared->length);
+
+		pShared->AddRef();
+
+		shared		= pShared;
+		buff.buf	= (char*)pShared->data + iOffset;
+		buff.len	= iLength;
+	}
+
+	void DetachShared()
+	{
+		if(shared == nullptr)
+			return;
+
+		buff.buf = ((char*)(T*)this) + sizeof(T);
+
+		shared->Release();
+		shared = nullptr;
+	}
+
+	void Detach()		{DetachShared();}
+	BOOL IsAttached()	{return shared != nullptr;}
+
 	int Cat(const BYTE* pData, int length)
 	{
 		ASSERT(pData != nullptr && length >= 0);
@@ -407,15 +510,96 @@ template<class T> struct TBufferObjBase
 	}
 
 	void ResetOV()	{::ZeroMemory(&ov, sizeof(ov));}
-	void Reset()	{ResetOV(); buff.len = 0;}
-	int Remain()	{return capacity - buff.len;}
+	void Reset()	{ResetOV(); buff.len = 0; sndCounter = 0;}
+	int Remain()	{return shared ? 0 : capacity - buff.len;}
 	BOOL IsFull()	{return Remain() == 0;}
 };
 
+/* 文件传输结构（流式发送文件时附属于投递 TransmitFile() 的数据缓冲区） */
+struct TFileTransfer
+{
+	CAtlFile				file;
+	ULONGLONG				offset;
+	ULONGLONG				remain;
+	DWORD					sending;
+	CBufferPtr				head;
+	CBufferPtr				tail;
+	TRANSMIT_FILE_BUFFERS	buffers;
+
+	static TFileTransfer* Construct(CAtlFile& f, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail)
+	{
+		return new TFileTransfer(f, ullOffset, ullLength, pHead, pTail);
+	}
+
+	static void Destruct(TFileTransfer* pTransfer)
+	{
+		delete pTransfer;
+	}
+
+	/* 准备下一次投递：头部数据随首次投递发送，尾部数据随最后一次投递发送，返回本次投递的总字节数 */
+	int Prepare()
+	{
+		sending		= (DWORD)min(remain, (ULONGLONG)TRANSMIT_FILE_CHUNK_SIZE);
+		BOOL bLast	= (sending == remain);
+
+		buffers.Head		= head.Ptr();
+		buffers.HeadLength	= (DWORD)head.Size();
+		buffers.Tail		= bLast ? tail.Ptr() : nullptr;
+		buffers.TailLength	= bLast ? (DWORD)tail.Size() : 0;
+
+		return (int)(buffers.HeadLength + sending + buffers.TailLength);
+	}
+
+	/* 本次投递完成，返回文件是否已全部发送 */
+	BOOL Advance()
+	{
+		offset	+= sending;
+		remain	-= sending;
+		sending	 = 0;
+
+		head.Free();
+
+		return (remain == 0);
+	}
+
+private:
+	TFileTransfer(CAtlFile& f, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail)
+	: offset	(ullOffset)
+	, remain	(ullLength)
+	, sending	(0)
+	{
+		file.Attach(f.Detach());
+
+		if(pHead && pHead->len > 0) head.Copy((const BYTE*)pHead->buf, pHead->len);
+		if(pTail && pTail->len > 0) tail.Copy((const BYTE*)pTail->buf, pTail->len);
+
+		::ZeroMemory(&buffers, sizeof(buffers));
+	}
+};
+
 /* 数据缓冲区结构 */
 struct TBufferObj : public TBufferObjBase<TBufferObj>
 {
-	SOCKET client;
+	SOCKET			client;
+	TFileTransfer*	transfer;
+
+	void Reset()
+	{
+		__super::Reset();
+		transfer = nullptr;
+	}
+
+	void ReleaseTransfer()
+	{
+		if(transfer == nullptr)
+			return;
+
+		TFileTransfer::Destruct(transfer);
+		transfer = nullptr;
+	}
+
+	void Detach()		{__super::Detach(); ReleaseTransfer();}
+	BOOL IsAttached()	{return transfer != nullptr || __super::IsAttached();}
 };
 
 /* UDP 数据缓冲区结构 */
@@ -463,7 +647,13 @@ public:
 
 	void Release()
 	{
-		bfPool.PutFreeItem(*this);
+		T* pItem;
+
+		while((pItem = PopFront()) != nullptr)
+		{
+			pItem->Detach();
+			bfPool.PutFreeItem(pItem);
+		}
 	}
 
 public:
@@ -475,6 +665,154 @@ private:
 	CNodePoolT<T>& bfPool;
 };
 
+/* 数据缓冲区无锁队列模板（多生产者单消费者：生产者只通过 CAS 入队，消费者一次取出全部数据块） */
+template<class T> struct TBufferObjQueueT
+{
+public:
+	/* 把多个数据块作为一个整体入队（可由多个线程并发调用），返回入队的字节数 */
+	int Cat(const WSABUF pBuffers[], int iCount)
+	{
+		T* pHead	= nullptr;
+		T* pTail	= nullptr;
+		int length	= 0;
+
+		for(int i = 0; i < iCount; i++)
+		{
+			const BYTE* pData	= (const BYTE*)pBuffers[i].buf;
+			int remain			= (int)pBuffers[i].len;
+
+			while(remain > 0)
+			{
+				// 局部链表按逆序链接，与队列内部顺序一致
+				if(pHead == nullptr || pHead->IsFull())
+				{
+					T* pItem	= bfPool.PickFreeItem();
+					pItem->next	= pHead;
+					pHead		= pItem;
+
+					if(pTail == nullptr)
+						pTail = pItem;
+				}
+
+				int cat  = pHead->Cat(pData, remain);
+
+				pData	+= cat;
+				remain	-= cat;
+				length	+= cat;
+			}
+		}
+
+		if(pHead != nullptr)
+			Push(pHead, pTail);
+
+		return length;
+	}
+
+	/* 把共享数据缓冲区按 iMaxSize 分段引用入队（不复制数据），返回入队的字节数 */
+	int Cat(TSharedBuffer* pShared, int iMaxSize)
+	{
+		T* pHead	= nullptr;
+		T* pTail	= nullptr;
+		int length	= 0;
+
+		while(length < pShared->length)
+		{
+			T* pItem	= bfPool.PickFreeItem();
+			int attach	= min(pShared->length - length, iMaxSize);
+
+			pItem->AttachShared(pShared, length, attach);
+
+			pItem->next	= pHead;
+			pHead		= pItem;
+
+			if(pTail == nullptr)
+				pTail = pItem;
+
+			length += attach;
+		}
+
+		if(pHead != nullptr)
+			Push(pHead, pTail);
+
+		return length;
+	}
+
+	/* 把单个数据块入队（如共享数据块或文件传输数据块，可由多个线程并发调用） */
+	void Push(T* pItem)
+	{
+		Push(pItem, pItem);
+	}
+
+	/* 按入队顺序取出全部数据块追加到 lsItem 尾部，并把小数据块合并到相邻数据块（只能由消费者调用） */
+	void PopAll(TBufferObjListT<T>& lsItem)
+	{
+		T* pItem  = (T*)::InterlockedExchangePointer((PVOID volatile*)&top, nullptr);
+		T* pFront = nullptr;
+
+		while(pItem != nullptr)
+		{
+			T* pNext	= pItem->next;
+			pItem->next	= pFront;
+			pFront		= pItem;
+			pItem		= pNext;
+		}
+
+		while((pItem = pFront) != nullptr)
+		{
+			pFront		= pItem->next;
+			pItem->next	= nullptr;
+
+			T* pBack = lsItem.Back();
+
+			if(pBack != nullptr && !pItem->IsAttached() && !pBack->IsAttached() && pBack->Remain() >= (int)pItem->buff.len)
+			{
+				pBack->Cat((const BYTE*)pItem->buff.buf, (int)pItem->buff.len);
+				bfPool.PutFreeItem(pItem);
+			}
+			else
+				lsItem.PushBack(pItem);
+		}
+	}
+
+	void Release()
+	{
+		T* pItem = (T*)::InterlockedExchangePointer((PVOID volatile*)&top, nullptr);
+
+		while(pItem != nullptr)
+		{
+			T* pNext = pItem->next;
+
+			pItem->Detach();
+			bfPool.PutFreeItem(pItem);
+
+			pItem = pNext;
+		}
+	}
+
+	BOOL IsEmpty() const {return top == nullptr;}
+
+public:
+	TBufferObjQueueT(CNodePoolT<T>& pool) : bfPool(pool), top(nullptr)
+	{
+	}
+
+private:
+	void Push(T* pHead, T* pTail)
+	{
+		T* pTop;
+
+		do
+		{
+			pTop		= top;
+			pTail->next	= pTop;
+		} while(::InterlockedCompareExchangePointer((PVOID volatile*)&top, pHead, pTop) != pTop);
+	}
+
+private:
+	CNodePoolT<T>&	bfPool;
+	T* volatile		top;
+};
+
 /* 数据缓冲区对象池 */
 typedef CNodePoolT<TBufferObj>			CBufferObjPool;
 /* UDP 数据缓冲区对象池 */
@@ -483,6 +821,8 @@ typedef CNodePoolT<TUdpBufferObj>		CUdpBufferObjPool;
 typedef TBufferObjListT<TBufferObj>		TBufferObjList;
 /* UDP 数据缓冲区链表模板 */
 typedef TBufferObjListT<TUdpBufferObj>	TUdpBufferObjList;
+/* 数据缓冲区无锁队列 */
+typedef TBufferObjQueueT<TBufferObj>	TBufferObjQueue;
 
 /* TBufferObj 智能指针 */
 typedef TItemPtrT<TBufferObj>			TBufferObjPtr;
@@ -490,6 +830,13 @@ typedef TItemPtrT<TBufferObj>			TBufferObjPtr;
 typedef TItemPtrT<TUdpBufferObj>		TUdpBufferObjPtr;
 
 /* Socket 缓冲区基础结构 */
+/*
+	Socket 对象内存布局按访问频度分区，各区之间以一个完整缓存行隔开：
+		1. 冷数据：连接建立后基本只读
+		2. 接收热数据：工作线程频繁写入，派生类紧接着追加各自的接收区字段
+		3. 发送热数据：发送线程频繁写入，由派生类定义（包括 smooth / pending / sndCount）
+	私有堆不保证按缓存行对齐，故以填充字段代替 alignas，每个 Socket 对象因此增加 3 * CACHE_LINE（192）字节
+*/
 struct TSocketObjBase
 {
 	CPrivateHeap& heap;
@@ -507,13 +854,13 @@ struct TSocketObjBase
 		DWORD	connTime;
 	};
 
-	DWORD		activeTime;
-
-	volatile BOOL	smooth;
-	volatile long	pending;
-	volatile long	sndCount;
+	TTimerNode	timer;
 
 	volatile BOOL	connected;
+
+	char			pack1[CACHE_LINE];
+
+	DWORD			activeTime;
 	volatile BOOL	paused;
 	volatile BOOL	recving;
 
@@ -536,14 +883,6 @@ struct TSocketObjBase
 	DWORD GetActiveTime	()	const	{return activeTime;}
 	BOOL IsPaused		()	const	{return paused;}
 
-	long Pending()		{return pending;}
-	BOOL IsPending()	{return pending > 0;}
-	BOOL IsSmooth()		{return smooth;}
-	void TurnOnSmooth()	{smooth = TRUE;}
-
-	BOOL TurnOffSmooth()
-		{return ::InterlockedCompareExchange((volatile long*)&smooth, FALSE, TRUE) == TRUE;}
-	
 	BOOL HasConnected()							{return connected;}
 	void SetConnected(BOOL bConnected = TRUE)	{connected = bConnected;}
 
@@ -552,11 +891,8 @@ struct TSocketObjBase
 		connID		= dwConnID;
 		connected	= FALSE;
 		valid		= TRUE;
-		smooth		= TRUE;
 		paused		= FALSE;
 		recving		= FALSE;
-		pending		= 0;
-		sndCount	= 0;
 		extra		= nullptr;
 		reserved	= nullptr;
 		reserved2	= nullptr;
@@ -567,16 +903,67 @@ struct TSocketObjBase
 struct TSocketObj : public TSocketObjBase
 {
 	CCriSec			csRecv;
-	CCriSec			csSend;
 	CSpinGuard		sgPause;
 
+	char			pack2[CACHE_LINE];
+
+	volatile BOOL	smooth;
+	volatile long	pending;
+	volatile long	sndCount;
+
+	CCriSec			csSend;
+	TBufferObjList	sndBuff;
+	TBufferObjQueue	sndQueue;
+
+	volatile long	mails;
+	volatile long	flush;
+	volatile long	ios;
+	volatile long	sndHigh;
+	volatile long	sndMarks;
+	volatile BOOL	transmit;
+	long			sndBuffSize;
+
+	char			pack3[CACHE_LINE];
+
 	SOCKET			socket;
 	CStringA		host;
-	TBufferObjList	sndBuff;
+	vector<DWORD>	groups;
+
+	long Pending()		{return pending;}
+	BOOL IsPending()	{return pending > 0;}
+	BOOL IsSmooth()		{return smooth;}
+	void TurnOnSmooth()	{::InterlockedExchange((volatile long*)&smooth, TRUE);}
+
+	BOOL TurnOffSmooth()
+		{return ::InterlockedCompareExchange((volatile long*)&smooth, FALSE, TRUE) == TRUE;}
+
+	BOOL MarkFlush()	{return ::InterlockedCompareExchange(&flush, TRUE, FALSE) == FALSE;}
+	void UnmarkFlush()	{::InterlockedExchange(&flush, FALSE);}
+
+	void BeginIo()		{::InterlockedIncrement(&ios);}
+	void EndIo()		{::InterlockedDecrement(&ios);}
+
+	static BOOL IsReclaimable(TSocketObj* pSocketObj)
+		{return pSocketObj->ios == 0;}
 
 	BOOL IsCanSend() {return sndCount <= GetSendBufferSize();}
 
+	/* 内核发送缓冲区大小在首次发送时读取并缓存（此时 OnAccept 中对 SO_SNDBUF 的修改已生效） */
 	long GetSendBufferSize()
+	{
+		if(sndBuffSize <= 0)
+			sndBuffSize = QuerySendBufferSize();
+
+		return sndBuffSize;
+	}
+
+	/* 发送水位检查：进入成功的线程投递水位指令，工作线程处理指令时补做其它线程的检查请求后离开 */
+	BOOL EnterSendMark()	{return ::InterlockedIncrement(&sndMarks) == 1;}
+	void RenewSendMark()	{::InterlockedExchange(&sndMarks, 1);}
+	BOOL LeaveSendMark()	{return ::InterlockedCompareExchange(&sndMarks, 0, 1) == 1;}
+	void ClearSendMark()	{::InterlockedExchange(&sndMarks, 0);}
+
+	long QuerySendBufferSize()
 	{
 		long lSize;
 		int len	= (int)(sizeof(lSize));
@@ -608,7 +995,7 @@ struct TSocketObj : public TSocketObjBase
 	}
 	
 	TSocketObj(CPrivateHeap& hp, CBufferObjPool& bfPool)
-	: TSocketObjBase(hp), sndBuff(bfPool)
+	: TSocketObjBase(hp), sndBuff(bfPool), sndQueue(bfPool)
 	{
 
 	}
@@ -639,6 +1026,7 @@ struct TSocketObj : public TSocketObjBase
 		__super::Release(pSocketObj);
 
 		pSocketObj->sndBuff.Release();
+		pSocketObj->sndQueue.Release();
 	}
 
 	void Reset(CONNID dwConnID, SOCKET soClient)
@@ -646,8 +1034,21 @@ struct TSocketObj : public TSocketObjBase
 		__super::Reset(dwConnID);
 		
 		host.Empty();
+		sndQueue.Release();
 
-		socket = soClient;
+		socket		= soClient;
+		smooth		= TRUE;
+		pending		= 0;
+		sndCount	= 0;
+		mails		= 0;
+		flush		= FALSE;
+		ios			= 0;
+		sndHigh		= FALSE;
+		sndMarks	= 0;
+		transmit	= FALSE;
+		sndBuffSize	= 0;
+
+		groups.clear();
 	}
 
 	BOOL GetRemoteHost(LPCSTR* lpszHost, USHORT* pusPort = nullptr)
@@ -664,15 +1065,30 @@ struct TSocketObj : public TSocketObjBase
 /* UDP 数据缓冲区结构 */
 struct TUdpSocketObj : public TSocketObjBase
 {
-	PVOID				pHolder;
-	HANDLE				hTimer;
-
 	CRWLock				csRecv;
-	CCriSec				csSend;
 
+	char				pack2[CACHE_LINE];
+
+	volatile BOOL		smooth;
+	volatile long		pending;
+	volatile long		sndCount;
+
+	CCriSec				csSend;
 	TUdpBufferObjList	sndBuff;
+
+	char				pack3[CACHE_LINE];
+
+	PVOID				pHolder;
 	volatile DWORD		detectFails;
 
+	long Pending()		{return pending;}
+	BOOL IsPending()	{return pending > 0;}
+	BOOL IsSmooth()		{return smooth;}
+	void TurnOnSmooth()	{::InterlockedExchange((volatile long*)&smooth, TRUE);}
+
+	BOOL TurnOffSmooth()
+		{return ::InterlockedCompareExchange((volatile long*)&smooth, FALSE, TRUE) == TRUE;}
+
 	BOOL IsCanSend			() {return sndCount <= GetSendBufferSize();}
 	long GetSendBufferSize	() {return (4 * DEFAULT_SOCKET_SNDBUFF_SIZE);}
 
@@ -733,21 +1149,45 @@ struct TUdpSocketObj : public TSocketObjBase
 	{
 		__super::Reset(dwConnID);
 
+		smooth		= TRUE;
+		pending		= 0;
+		sndCount	= 0;
 		pHolder		= nullptr;
-		hTimer		= nullptr;
 		detectFails	= 0;
 	}
 };
 
+#ifdef _DEBUG
+
+/* 调试模式下输出 Socket 对象各分区的偏移，并检查各热字段位于所属分区内（避免调整字段时破坏分区布局） */
+template<class T> void CheckSocketObjLayout(LPCSTR lpszName, const T* pSocketObj)
+{
+	const char* p		= (const char*)pSocketObj;
+	const char* pRecv	= (const char*)&pSocketObj->pack1 + CACHE_LINE;
+	const char* pSend	= (const char*)&pSocketObj->pack2 + CACHE_LINE;
+	const char* pCold	= (const char*)&pSocketObj->pack3 + CACHE_LINE;
+
+	TRACE("<LAYOUT> %s (size: %Iu, recv: %Iu, send: %Iu, cold: %Iu)\n", lpszName, sizeof(T), pRecv - p, pSend - p, pCold - p);
+
+	ASSERT((const char*)&pSocketObj->connected < (const char*)&pSocketObj->pack1);
+	ASSERT((const char*)&pSocketObj->activeTime >= pRecv && (const char*)&pSocketObj->csRecv < (const char*)&pSocketObj->pack2);
+	ASSERT((const char*)&pSocketObj->smooth >= pSend && (const char*)&pSocketObj->csSend < (const char*)&pSocketObj->pack3);
+	ASSERT((const char*)&pSocketObj->pending >= pSend && (const char*)&pSocketObj->sndCount < (const char*)&pSocketObj->pack3);
+}
+
+#endif
+
 /* 有效 TSocketObj 缓存 */
-typedef CRingCache2<TSocketObj, CONNID, true>		TSocketObjPtrPool;
+typedef CSlotMap<TSocketObj, CONNID>				TSocketObjPtrPool;
 /* 失效 TSocketObj 缓存 */
 typedef CRingPool<TSocketObj>						TSocketObjPtrList;
 /* 失效 TSocketObj 垃圾回收结构链表 */
 typedef CCASQueue<TSocketObj>						TSocketObjPtrQueue;
+/* 失效 TSocketObj 纪元回收结构 */
+typedef CEpochGCT<TSocketObj>						TSocketObjPtrGC;
 
 /* 有效 TUdpSocketObj 缓存 */
-typedef CRingCache2<TUdpSocketObj, CONNID, true>	TUdpSocketObjPtrPool;
+typedef CSlotMap<TUdpSocketObj, CONNID>				TUdpSocketObjPtrPool;
 /* 失效 TUdpSocketObj 缓存 */
 typedef CRingPool<TUdpSocketObj>					TUdpSocketObjPtrList;
 /* 失效 TUdpSocketObj 垃圾回收结构链表 */
@@ -782,6 +1222,20 @@ typedef TSockAddrMap::iterator			TSockAddrMapI;
 /* 地址-连接 ID 哈希表 const 迭代器 */
 typedef TSockAddrMap::const_iterator	TSockAddrMapCI;
 
+/* 连接分组结构 */
+struct TConnGroup
+{
+	CSimpleRWLock	cs;
+	vector<CONNID>	members;
+};
+
+/* 分组 ID-连接分组哈希表 */
+typedef unordered_map<DWORD, TConnGroup*>	TConnGroupMap;
+/* 分组 ID-连接分组哈希表迭代器 */
+typedef TConnGroupMap::iterator				TConnGroupMapI;
+/* 分组 ID-连接分组哈希表 const 迭代器 */
+typedef TConnGroupMap::const_iterator		TConnGroupMapCI;
+
 /* IClient 组件关闭上下文 */
 struct TClientCloseContext
 {
@@ -895,7 +1349,8 @@ enum EnIocpCommand
 	IOCP_CMD_DISCONNECT	= 0xFFFFFFF2,	// 断开连接
 	IOCP_CMD_SEND		= 0xFFFFFFF3,	// 发送数据
 	IOCP_CMD_UNPAUSE	= 0xFFFFFFF4,	// 取消暂停
-	IOCP_CMD_TIMEOUT	= 0xFFFFFFF5	// 保活超时
+	IOCP_CMD_TIMEOUT	= 0xFFFFFFF5,	// 保活超时
+	IOCP_CMD_WATERMARK	= 0xFFFFFFF6	// 发送水位
 };
 
 /* IOCP 命令处理动作 */
@@ -913,7 +1368,10 @@ BOOL PostIocpDisconnect(HANDLE hIOCP, CONNID dwConnID);
 BOOL PostIocpSend(HANDLE hIOCP, CONNID dwConnID);
 BOOL PostIocpUnpause(HANDLE hIOCP, CONNID dwConnID);
 BOOL PostIocpTimeout(HANDLE hIOCP, CONNID dwConnID);
+BOOL PostIocpWatermark(HANDLE hIOCP, CONNID dwConnID);
 BOOL PostIocpClose(HANDLE hIOCP, CONNID dwConnID, int iErrorCode);
+BOOL PostIocpMail(HANDLE hIOCP, CONNID dwConnID, TBufferObj* pBufferObj);
+BOOL PostIocpAccepted(HANDLE hIOCP, CONNID dwConnID, TBufferObj* pBufferObj);
 
 /************************************************************************
 名称：setsockopt() 帮助方法
@@ -940,6 +1398,7 @@ int SSO_SendTimeOut			(SOCKET sock, int ms);
 int SSO_ReuseAddress		(SOCKET sock, EnReuseAddressPolicy opt);
 int SSO_ExclusiveAddressUse	(SOCKET sock, BOOL bExclusive = TRUE);
 int SSO_UDP_ConnReset		(SOCKET sock, BOOL bNewBehavior = TRUE);
+int SSO_UDP_SendMsgSize		(SOCKET sock, DWORD dwMsgSize);
 
 /************************************************************************
 名称：Socket 操作方法
@@ -952,6 +1411,8 @@ int SSO_UDP_ConnReset		(SOCKET sock, BOOL bNewBehavior = TRUE);
 #define IOCP_PENDING(rs)		((rs) == WSA_IO_PENDING)
 /* 检测 IOCP 操作返回值：NO_ERROR 或 WSA_IO_PENDING 则返回 TRUE */
 #define IOCP_SUCCESS(rs)		(IOCP_NO_ERROR(rs) || IOCP_PENDING(rs))
+/* 检测批量出队的完成通知状态：NTSTATUS 非错误值则返回 TRUE */
+#define IOCP_OV_SUCCESS(pov)	((LONG)((pov)->Internal) >= 0)
 
 /* 检查是否 UDP RESET 错误 */
 #define IS_UDP_RESET_ERROR(rs)	((rs) == WSAENETRESET || (rs) == WSAECONNRESET)
@@ -978,6 +1439,10 @@ int PostConnectNotCheck		(LPFN_CONNECTEX pfnConnectEx, SOCKET soClient, const HP
 int PostSend				(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 /* 投递 WSASend() */
 int PostSendNotCheck		(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+/* 投递 TransmitFile()，并把 WSA_IO_PENDING 转换为 NO_ERROR */
+int PostTransmitFile		(LPFN_TRANSMITFILE pfnTransmitFile, TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+/* 投递 TransmitFile() */
+int PostTransmitFileNotCheck(LPFN_TRANSMITFILE pfnTransmitFile, TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 /* 投递 WSARecv()，并把 WSA_IO_PENDING 转换为 NO_ERROR */
 int PostReceive				(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 /* 投递 WSARecv() */
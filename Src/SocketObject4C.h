@@ -129,6 +129,13 @@ public:
 				: HR_IGNORE;
 	}
 
+	virtual EnHandleResult OnSendWatermark(T* pSender, CONNID dwConnID, BOOL bHigh, int iPending)
+	{
+		return	(m_fnOnSendWatermark)
+				? m_fnOnSendWatermark(C_HP_Object::FromSecond<offset>(pSender), dwConnID, bHigh, iPending)
+				: HR_IGNORE;
+	}
+
 public:
 	C_HP_ServerListenerT()
 	: m_fnOnPrepareListen	(nullptr)
@@ -139,6 +146,7 @@ public:
 	, m_fnOnPullReceive		(nullptr)
 	, m_fnOnClose			(nullptr)
 	, m_fnOnShutdown		(nullptr)
+	, m_fnOnSendWatermark	(nullptr)
 	{
 	}
 
@@ -151,6 +159,7 @@ public:
 	HP_FN_Server_OnPullReceive		m_fnOnPullReceive	;
 	HP_FN_Server_OnClose			m_fnOnClose			;
 	HP_FN_Server_OnShutdown			m_fnOnShutdown		;
+	HP_FN_Server_OnSendWatermark	m_fnOnSendWatermark	;
 };
 
 template<class T, class L, size_t offset = 0> class C_HP_AgentListenerT : public L
@@ -325,14 +334,17 @@ public:
 typedef C_HP_ServerListenerT<ITcpServer, ITcpServerListener>						C_HP_TcpServerListener;
 typedef C_HP_ServerListenerT<ITcpServer, ITcpServerListener, sizeof(IPullSocket)>	C_HP_TcpPullServerListener;
 typedef C_HP_ServerListenerT<ITcpServer, ITcpServerListener, sizeof(IPackSocket)>	C_HP_TcpPackServerListener;
+typedef C_HP_ServerListenerT<ITcpServer, ITcpServerListener, sizeof(IFramedSocket)>	C_HP_TcpFramedServerListener;
 
 typedef C_HP_AgentListenerT<ITcpAgent, ITcpAgentListener>							C_HP_TcpAgentListener;
 typedef C_HP_AgentListenerT<ITcpAgent, ITcpAgentListener, sizeof(IPullSocket)>		C_HP_TcpPullAgentListener;
 typedef C_HP_AgentListenerT<ITcpAgent, ITcpAgentListener, sizeof(IPackSocket)>		C_HP_TcpPackAgentListener;
+typedef C_HP_AgentListenerT<ITcpAgent, ITcpAgentListener, sizeof(IFramedSocket)>	C_HP_TcpFramedAgentListener;
 
 typedef C_HP_ClientListenerT<ITcpClient, ITcpClientListener>						C_HP_TcpClientListener;
 typedef C_HP_ClientListenerT<ITcpClient, ITcpClientListener, sizeof(IPullClient)>	C_HP_TcpPullClientListener;
 typedef C_HP_ClientListenerT<ITcpClient, ITcpClientListener, sizeof(IPackClient)>	C_HP_TcpPackClientListener;
+typedef C_HP_ClientListenerT<ITcpClient, ITcpClientListener, sizeof(IFramedClient)>	C_HP_TcpFramedClientListener;
 
 #ifdef _UDP_SUPPORT
 
@@ -609,6 +621,8 @@ public:
 		{return m_lsnServer.OnClose(pSender, dwConnID, enOperation, iErrorCode);}
 	virtual EnHandleResult OnShutdown(ITcpServer* pSender)
 		{return m_lsnServer.OnShutdown(pSender);}
+	virtual EnHandleResult OnSendWatermark(ITcpServer* pSender, CONNID dwConnID, BOOL bHigh, int iPending)
+		{return m_lsnServer.OnSendWatermark(pSender, dwConnID, bHigh, iPending);}
 
 public:
 	C_HP_HttpServerBaseListener1 m_lsnHttp;
@@ -158,6 +158,15 @@ void CTcpAgent::PrepareStart()
 	m_bfObjPool.SetPoolHold(m_dwFreeBufferObjHold);
 
 	m_bfObjPool.Prepare();
+
+	if(m_bZeroByteReceive)
+	{
+		m_bfNotifyPool.SetItemCapacity(RECV_NOTIFY_BUFFER_SIZE);
+		m_bfNotifyPool.SetPoolSize(m_dwFreeBufferObjPool);
+		m_bfNotifyPool.SetPoolHold(m_dwFreeBufferObjHold);
+
+		m_bfNotifyPool.Prepare();
+	}
 }
 
 BOOL CTcpAgent::CheckStarting()
@@ -417,6 +426,7 @@ void CTcpAgent::AddFreeBufferObj(TBufferObj* pBufferObj)
 void CTcpAgent::ReleaseFreeBuffer()
 {
 	m_bfObjPool.Clear();
+	m_bfNotifyPool.Clear();
 }
 
 TSocketObj* CTcpAgent::FindSocketObj(CONNID dwConnID)
@@ -897,6 +907,12 @@ void CTcpAgent::HandleIo(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pB
 		return;
 	}
 
+	if(m_bZeroByteReceive && pBufferObj->operation == SO_RECEIVE)
+	{
+		HandleNotify(dwConnID, pSocketObj, pBufferObj);
+		return;
+	}
+
 	if(dwBytes == 0 && pBufferObj->operation != SO_CONNECT)
 	{
 		AddFreeSocketObj(pSocketObj, SCF_CLOSE);
@@ -926,7 +942,9 @@ void CTcpAgent::HandleError(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj*
 {
 	CheckError(pSocketObj, pBufferObj->operation, dwErrorCode);
 
-	if(pBufferObj->operation != SO_SEND || pBufferObj->ReleaseSendCounter() == 0)
+	if(m_bZeroByteReceive && pBufferObj->operation == SO_RECEIVE)
+		m_bfNotifyPool.PutFreeItem(pBufferObj);
+	else if(pBufferObj->operation != SO_SEND || pBufferObj->ReleaseSendCounter() == 0)
 		AddFreeBufferObj(pBufferObj);
 }
 
@@ -1037,8 +1055,45 @@ int CTcpAgent::DoUnpause(CONNID dwConnID)
 	return DoReceive(pSocketObj, GetFreeBufferObj());
 }
 
+void CTcpAgent::HandleNotify(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pNotifyObj)
+{
+	m_bfNotifyPool.PutFreeItem(pNotifyObj);
+
+	if(m_bMarkSilence) pSocketObj->activeTime = ::TimeGetTime();
+
+	TBufferObj* pBufferObj	= GetFreeBufferObj();
+	pBufferObj->client		= pSocketObj->socket;
+	EnHandleResult hr		= HR_OK;
+
+	if(::ContinueReceive(this, pSocketObj, pBufferObj, hr))
+	{
+		{
+			CSpinLock locallock(pSocketObj->sgPause);
+
+			pSocketObj->recving = FALSE;
+		}
+
+		DoReceive(pSocketObj, pBufferObj);
+	}
+
+	if(hr == HR_CLOSED)
+	{
+		AddFreeBufferObj(pBufferObj);
+	}
+	else if(hr == HR_ERROR)
+	{
+		TRACE("<S-CNNID: %Iu> OnReceive() event return 'HR_ERROR', connection will be closed !\n", dwConnID);
+
+		AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, ENSURE_ERROR_CANCELLED);
+		AddFreeBufferObj(pBufferObj);
+	}
+}
+
 int CTcpAgent::DoReceive(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
 {
+	if(m_bZeroByteReceive)
+		return DoNotify(pSocketObj, pBufferObj);
+
 	int result		= NO_ERROR;
 	BOOL bNeedFree	= FALSE;
 
@@ -1067,6 +1122,39 @@ int CTcpAgent::DoReceive(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
 	return result;
 }
 
+int CTcpAgent::DoNotify(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	AddFreeBufferObj(pBufferObj);
+
+	int result				= NO_ERROR;
+	BOOL bNeedFree			= FALSE;
+	TBufferObj* pNotifyObj	= m_bfNotifyPool.PickFreeItem();
+
+	{
+		CSpinLock locallock(pSocketObj->sgPause);
+
+		if(pSocketObj->paused || pSocketObj->recving)
+			bNeedFree = TRUE;
+		else
+		{
+			pSocketObj->recving	 = TRUE;
+			pNotifyObj->buff.len = 0;
+
+			result = ::PostReceive(pSocketObj, pNotifyObj);
+		}
+	}
+
+	if(result != NO_ERROR)
+	{
+		CheckError(pSocketObj, SO_RECEIVE, result);
+		bNeedFree = TRUE;
+	}
+
+	if(bNeedFree) m_bfNotifyPool.PutFreeItem(pNotifyObj);
+
+	return result;
+}
+
 BOOL CTcpAgent::PauseReceive(CONNID dwConnID, BOOL bPause)
 {
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
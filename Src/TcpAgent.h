@@ -95,6 +95,7 @@ public:
 	virtual void SetKeepAliveTime			(DWORD dwKeepAliveTime)			{ENSURE_HAS_STOPPED(); m_dwKeepAliveTime			= dwKeepAliveTime;}
 	virtual void SetKeepAliveInterval		(DWORD dwKeepAliveInterval)		{ENSURE_HAS_STOPPED(); m_dwKeepAliveInterval		= dwKeepAliveInterval;}
 	virtual void SetMarkSilence				(BOOL bMarkSilence)				{ENSURE_HAS_STOPPED(); m_bMarkSilence				= bMarkSilence;}
+	virtual void SetZeroByteReceive			(BOOL bZeroByteReceive)			{ENSURE_HAS_STOPPED(); m_bZeroByteReceive			= bZeroByteReceive;}
 
 	virtual EnReuseAddressPolicy GetReuseAddressPolicy	()	{return m_enReusePolicy;}
 	virtual EnSendPolicy GetSendPolicy					()	{return m_enSendPolicy;}
@@ -110,6 +111,7 @@ public:
 	virtual DWORD GetKeepAliveTime			()	{return m_dwKeepAliveTime;}
 	virtual DWORD GetKeepAliveInterval		()	{return m_dwKeepAliveInterval;}
 	virtual BOOL  IsMarkSilence				()	{return m_bMarkSilence;}
+	virtual BOOL  IsZeroByteReceive			()	{return m_bZeroByteReceive;}
 
 protected:
 	virtual EnHandleResult FirePrepareConnect(CONNID dwConnID, SOCKET socket)
@@ -227,6 +229,7 @@ private:
 	void HandleConnect		(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 	void HandleSend			(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 	void HandleReceive		(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	void HandleNotify		(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pNotifyObj);
 
 	int SendInternal(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
 	int SendPack	(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength);
@@ -236,6 +239,7 @@ private:
 
 	int DoUnpause	(CONNID dwConnID);
 	int DoReceive	(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	int DoNotify	(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 	int DoSend		(CONNID dwConnID);
 	int DoSend		(TSocketObj* pSocketObj);
 	int DoSendPack	(TSocketObj* pSocketObj);
@@ -267,6 +271,7 @@ public:
 	, m_dwKeepAliveTime			(DEFALUT_TCP_KEEPALIVE_TIME)
 	, m_dwKeepAliveInterval		(DEFALUT_TCP_KEEPALIVE_INTERVAL)
 	, m_bMarkSilence			(TRUE)
+	, m_bZeroByteReceive		(FALSE)
 	, m_soAddr					(AF_UNSPEC, TRUE)
 	, m_evWait					(TRUE, TRUE)
 	{
@@ -294,6 +299,7 @@ private:
 	DWORD m_dwKeepAliveTime;
 	DWORD m_dwKeepAliveInterval;
 	BOOL  m_bMarkSilence;
+	BOOL  m_bZeroByteReceive;
 
 private:
 	static const CInitSocket sm_wsSocket;
@@ -314,6 +320,7 @@ private:
 
 	CPrivateHeap		m_phSocket;
 	CBufferObjPool		m_bfObjPool;
+	CBufferObjPool		m_bfNotifyPool;
 
 	CSpinGuard			m_csState;
 
@@ -0,0 +1,175 @@
+﻿/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#pragma once
+
+#include "TcpAgent.h"
+#include "MiscHelper.h"
+#include "Common/BufferPool.h"
+
+template<class T> class CTcpFramedAgentT : public IFramedSocket, public T
+{
+protected:
+	virtual EnHandleResult DoFireHandShake(TSocketObj* pSocketObj)
+	{
+		EnHandleResult result = __super::DoFireHandShake(pSocketObj);
+
+		if(result != HR_ERROR)
+		{
+			TBuffer* pBuffer = m_bfPool.PickFreeBuffer(pSocketObj->connID);
+			ENSURE(SetConnectionReserved(pSocketObj, TBufferFramedInfo::Construct(pBuffer)));
+		}
+
+		return result;
+	}
+
+	virtual EnHandleResult DoFireReceive(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
+	{
+		TBufferFramedInfo* pInfo = nullptr;
+		GetConnectionReserved(pSocketObj, (PVOID*)&pInfo);
+		ASSERT(pInfo);
+
+		TBuffer* pBuffer = (TBuffer*)pInfo->pBuffer;
+		ASSERT(pBuffer && pBuffer->IsValid());
+
+		return ParseFrame(this, pInfo, pBuffer, pSocketObj, m_spec, pData, iLength);
+	}
+
+	virtual EnHandleResult DoFireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
+	{
+		EnHandleResult result = __super::DoFireClose(pSocketObj, enOperation, iErrorCode);
+
+		TBufferFramedInfo* pInfo = nullptr;
+		GetConnectionReserved(pSocketObj, (PVOID*)&pInfo);
+
+		if(pInfo != nullptr)
+		{
+			m_bfPool.PutFreeBuffer(pInfo->pBuffer);
+			TBufferFramedInfo::Destruct(pInfo);
+		}
+
+		return result;
+	}
+
+	virtual EnHandleResult DoFireShutdown()
+	{
+		EnHandleResult result = __super::DoFireShutdown();
+
+		m_bfPool.Clear();
+
+		return result;
+	}
+
+	virtual EnHandleResult BeforeUnpause(TSocketObj* pSocketObj)
+	{
+		CCriSecLock locallock(pSocketObj->csRecv);
+
+		if(!TSocketObj::IsValid(pSocketObj))
+			return (EnHandleResult)HR_CLOSED;
+
+		if(pSocketObj->IsPaused())
+			return HR_IGNORE;
+
+		TBufferFramedInfo* pInfo = nullptr;
+		GetConnectionReserved(pSocketObj, (PVOID*)&pInfo);
+		ASSERT(pInfo);
+
+		TBuffer* pBuffer = (TBuffer*)pInfo->pBuffer;
+		ASSERT(pBuffer && pBuffer->IsValid());
+
+		return ParseFrame(this, pInfo, pBuffer, pSocketObj, m_spec);
+	}
+
+	virtual BOOL CheckParams()
+	{
+		if(m_spec.IsValid())
+			return __super::CheckParams();
+
+		SetLastError(SE_INVALID_PARAM, __FUNCTION__, ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	virtual void PrepareStart()
+	{
+		__super::PrepareStart();
+
+		m_bfPool.SetMaxCacheSize	(GetMaxConnectionCount());
+		m_bfPool.SetItemCapacity	(GetSocketBufferSize());
+		m_bfPool.SetItemPoolSize	(GetFreeBufferObjPool());
+		m_bfPool.SetItemPoolHold	(GetFreeBufferObjHold());
+		m_bfPool.SetBufferLockTime	(GetFreeSocketObjLockTime());
+		m_bfPool.SetBufferPoolSize	(GetFreeSocketObjPool());
+		m_bfPool.SetBufferPoolHold	(GetFreeSocketObjHold());
+
+		m_bfPool.Prepare();
+	}
+
+public:
+	virtual void SetFrameHeaderSize		(DWORD dwHeaderSize)	{ENSURE_HAS_STOPPED(); m_spec.headerSize	= dwHeaderSize;}
+	virtual void SetLengthFieldOffset	(DWORD dwOffset)		{ENSURE_HAS_STOPPED(); m_spec.lengthOffset	= dwOffset;}
+	virtual void SetLengthFieldSize		(DWORD dwSize)			{ENSURE_HAS_STOPPED(); m_spec.lengthSize	= dwSize;}
+	virtual void SetLengthFieldBigEndian(BOOL bBigEndian)		{ENSURE_HAS_STOPPED(); m_spec.bigEndian		= bBigEndian;}
+	virtual void SetLengthIncludeHeader	(BOOL bIncludeHeader)	{ENSURE_HAS_STOPPED(); m_spec.includeHeader	= bIncludeHeader;}
+	virtual void SetLengthAdjustment	(int iAdjustment)		{ENSURE_HAS_STOPPED(); m_spec.adjustment	= iAdjustment;}
+	virtual void SetMaxFrameSize		(DWORD dwMaxFrameSize)	{ENSURE_HAS_STOPPED(); m_spec.maxFrameSize	= dwMaxFrameSize;}
+	virtual DWORD GetFrameHeaderSize	()						{return m_spec.headerSize;}
+	virtual DWORD GetLengthFieldOffset	()						{return m_spec.lengthOffset;}
+	virtual DWORD GetLengthFieldSize	()						{return m_spec.lengthSize;}
+	virtual BOOL IsLengthFieldBigEndian	()						{return m_spec.bigEndian;}
+	virtual BOOL IsLengthIncludeHeader	()						{return m_spec.includeHeader;}
+	virtual int GetLengthAdjustment		()						{return m_spec.adjustment;}
+	virtual DWORD GetMaxFrameSize		()						{return m_spec.maxFrameSize;}
+
+private:
+	EnHandleResult DoFireSuperReceive(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
+		{return __super::DoFireReceive(pSocketObj, pData, iLength);}
+
+	friend EnHandleResult ParseFrame<>	(CTcpFramedAgentT* pThis, TBufferFramedInfo* pInfo, TBuffer* pBuffer, TSocketObj* pSocket, const TFrameSpec& spec);
+	friend EnHandleResult ParseFrame<>	(CTcpFramedAgentT* pThis, TBufferFramedInfo* pInfo, TBuffer* pBuffer, TSocketObj* pSocket, const TFrameSpec& spec,
+										const BYTE* pData, int iLength);
+
+public:
+	CTcpFramedAgentT(ITcpAgentListener* pListener)
+	: T(pListener)
+	{
+
+	}
+
+	virtual ~CTcpFramedAgentT()
+	{
+		ENSURE_STOP();
+	}
+
+private:
+	TFrameSpec	m_spec;
+	CBufferPool	m_bfPool;
+};
+
+typedef CTcpFramedAgentT<CTcpAgent> CTcpFramedAgent;
+
+#ifdef _SSL_SUPPORT
+
+#include "SSLAgent.h"
+typedef CTcpFramedAgentT<CSSLAgent> CSSLFramedAgent;
+
+#endif
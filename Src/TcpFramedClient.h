@@ -0,0 +1,112 @@
+﻿/*
+ * Copyright: JessMA Open Source (ldcsaa@gmail.com)
+ *
+ * Author	: Bruce Liang
+ * Website	: https://github.com/ldcsaa
+ * Project	: https://github.com/ldcsaa/HP-Socket
+ * Blog		: http://www.cnblogs.com/ldcsaa
+ * Wiki		: http://www.oschina.net/p/hp-socket
+ * QQ Group	: 44636872, 75375912
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#pragma once
+
+#include "TcpClient.h"
+#include "MiscHelper.h"
+
+template<class T> class CTcpFramedClientT : public IFramedClient, public T
+{
+protected:
+	virtual EnHandleResult DoFireReceive(ITcpClient* pSender, const BYTE* pData, int iLength)
+	{
+		return ParseFrame(this, &m_frInfo, &m_lsBuffer, (CTcpFramedClientT*)pSender, m_spec, pData, iLength);
+	}
+
+	virtual BOOL BeforeUnpause()
+	{
+		return (ParseFrame(this, &m_frInfo, &m_lsBuffer, (CTcpFramedClientT*)this, m_spec) != HR_ERROR);
+	}
+
+	virtual BOOL CheckParams()
+	{
+		if(m_spec.IsValid())
+			return __super::CheckParams();
+
+		SetLastError(SE_INVALID_PARAM, __FUNCTION__, ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	virtual void Reset()
+	{
+		m_lsBuffer.Clear();
+		m_frInfo.Reset();
+
+		__super::Reset();
+	}
+
+public:
+	virtual void SetFrameHeaderSize		(DWORD dwHeaderSize)	{ENSURE_HAS_STOPPED(); m_spec.headerSize	= dwHeaderSize;}
+	virtual void SetLengthFieldOffset	(DWORD dwOffset)		{ENSURE_HAS_STOPPED(); m_spec.lengthOffset	= dwOffset;}
+	virtual void SetLengthFieldSize		(DWORD dwSize)			{ENSURE_HAS_STOPPED(); m_spec.lengthSize	= dwSize;}
+	virtual void SetLengthFieldBigEndian(BOOL bBigEndian)		{ENSURE_HAS_STOPPED(); m_spec.bigEndian		= bBigEndian;}
+	virtual void SetLengthIncludeHeader	(BOOL bIncludeHeader)	{ENSURE_HAS_STOPPED(); m_spec.includeHeader	= bIncludeHeader;}
+	virtual void SetLengthAdjustment	(int iAdjustment)		{ENSURE_HAS_STOPPED(); m_spec.adjustment	= iAdjustment;}
+	virtual void SetMaxFrameSize		(DWORD dwMaxFrameSize)	{ENSURE_HAS_STOPPED(); m_spec.maxFrameSize	= dwMaxFrameSize;}
+	virtual DWORD GetFrameHeaderSize	()						{return m_spec.headerSize;}
+	virtual DWORD GetLengthFieldOffset	()						{return m_spec.lengthOffset;}
+	virtual DWORD GetLengthFieldSize	()						{return m_spec.lengthSize;}
+	virtual BOOL IsLengthFieldBigEndian	()						{return m_spec.bigEndian;}
+	virtual BOOL IsLengthIncludeHeader	()						{return m_spec.includeHeader;}
+	virtual int GetLengthAdjustment		()						{return m_spec.adjustment;}
+	virtual DWORD GetMaxFrameSize		()						{return m_spec.maxFrameSize;}
+
+private:
+	EnHandleResult DoFireSuperReceive(ITcpClient* pSender, const BYTE* pData, int iLength)
+		{return __super::DoFireReceive(pSender, pData, iLength);}
+
+	friend EnHandleResult ParseFrame<>	(CTcpFramedClientT* pThis, TFramedInfo<TItemListEx>* pInfo, TItemListEx* pBuffer, CTcpFramedClientT* pSocket,
+										const TFrameSpec& spec);
+	friend EnHandleResult ParseFrame<>	(CTcpFramedClientT* pThis, TFramedInfo<TItemListEx>* pInfo, TItemListEx* pBuffer, CTcpFramedClientT* pSocket,
+										const TFrameSpec& spec, const BYTE* pData, int iLength);
+
+public:
+	CTcpFramedClientT(ITcpClientListener* pListener)
+	: T				(pListener)
+	, m_frInfo		(nullptr)
+	, m_lsBuffer	(m_itPool)
+	{
+
+	}
+
+	virtual ~CTcpFramedClientT()
+	{
+		ENSURE_STOP();
+	}
+
+private:
+	TFrameSpec	m_spec;
+
+	TFramedInfo<TItemListEx>	m_frInfo;
+	TItemListEx					m_lsBuffer;
+};
+
+typedef CTcpFramedClientT<CTcpClient> CTcpFramedClient;
+
+#ifdef _SSL_SUPPORT
+
+#include "SSLClient.h"
+typedef CTcpFramedClientT<CSSLClient> CSSLFramedClient;
+
+#endif
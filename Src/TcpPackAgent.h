@@ -148,6 +148,8 @@ private:
 		{return __super::DoFireReceive(pSocketObj, pData, iLength);}
 
 	friend EnHandleResult ParsePack<>	(CTcpPackAgentT* pThis, TBufferPackInfo* pInfo, TBuffer* pBuffer, TSocketObj* pSocket, DWORD dwMaxPackSize, USHORT usPackHeaderFlag);
+	friend EnHandleResult ParsePack<>	(CTcpPackAgentT* pThis, TBufferPackInfo* pInfo, TBuffer* pBuffer, TSocketObj* pSocket, DWORD dwMaxPackSize, USHORT usPackHeaderFlag,
+										const BYTE* pData, int iLength);
 
 public:
 	CTcpPackAgentT(ITcpAgentListener* pListener)
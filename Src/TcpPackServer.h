@@ -41,7 +41,26 @@ public:
 		return __super::SendPackets(dwConnID, buffers.get(), iNewCount);
 	}
 
+	virtual BOOL SendToMany(const CONNID pConnIDs[], int iConnCount, const WSABUF pBuffers[], int iCount)
+	{
+		// 不能共享发送时逐个连接调用 SendPackets()，由其添加包头
+		if(!IsSharedSendable())
+			return __super::SendToMany(pConnIDs, iConnCount, pBuffers, iCount);
+
+		int iNewCount = iCount + 1;
+		unique_ptr<WSABUF[]> buffers(new WSABUF[iNewCount]);
+
+		DWORD dwHeader;
+		if(!::AddPackHeader(pBuffers, iCount, buffers, m_dwMaxPackSize, m_usHeaderFlag, dwHeader))
+			return FALSE;
+
+		return __super::SendToMany(pConnIDs, iConnCount, buffers.get(), iNewCount);
+	}
+
 protected:
+	virtual BOOL IsZeroCopySendable() {return FALSE;}
+	virtual BOOL IsTransmitSendable	() {return FALSE;}
+
 	virtual EnHandleResult DoFireHandShake(TSocketObj* pSocketObj)
 	{
 		EnHandleResult result = __super::DoFireHandShake(pSocketObj);
@@ -148,6 +167,8 @@ private:
 		{return __super::DoFireReceive(pSocketObj, pData, iLength);}
 
 	friend EnHandleResult ParsePack<>	(CTcpPackServerT* pThis, TBufferPackInfo* pInfo, TBuffer* pBuffer, TSocketObj* pSocket, DWORD dwMaxPackSize, USHORT usPackHeaderFlag);
+	friend EnHandleResult ParsePack<>	(CTcpPackServerT* pThis, TBufferPackInfo* pInfo, TBuffer* pBuffer, TSocketObj* pSocket, DWORD dwMaxPackSize, USHORT usPackHeaderFlag,
+										const BYTE* pData, int iLength);
 
 public:
 	CTcpPackServerT(ITcpServerListener* pListener)
@@ -31,12 +31,16 @@ template<class T> class CTcpPullAgentT : public IPullSocket, public T
 public:
 	virtual EnFetchResult Fetch(CONNID dwConnID, BYTE* pData, int iLength)
 	{
+		CEpochLock epochlock(m_bfPool.GetEpoch());
+
 		TBuffer* pBuffer = m_bfPool[dwConnID];
 		return ::FetchBuffer(pBuffer, pData, iLength);
 	}
 
 	virtual EnFetchResult Peek(CONNID dwConnID, BYTE* pData, int iLength)
 	{
+		CEpochLock epochlock(m_bfPool.GetEpoch());
+
 		TBuffer* pBuffer = m_bfPool[dwConnID];
 		return ::PeekBuffer(pBuffer, pData, iLength);
 	}
@@ -44,7 +44,7 @@ EnHandleResult CTcpServer::TriggerFireReceive(TSocketObj* pSocketObj, TBufferObj
 
 	if(TSocketObj::IsValid(pSocketObj))
 	{
-		CCriSecLock locallock(pSocketObj->csRecv);
+		CCriSecCondLock locallock(pSocketObj->csRecv, !m_bWorkerAffinity);
 
 		if(TSocketObj::IsValid(pSocketObj))
 		{
@@ -56,11 +56,21 @@ EnHandleResult CTcpServer::TriggerFireReceive(TSocketObj* pSocketObj, TBufferObj
 }
 
 EnHandleResult CTcpServer::TriggerFireSend(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	EnHandleResult rs = TriggerFireSend(pSocketObj, (BYTE*)pBufferObj->buff.buf, pBufferObj->buff.len);
+
+	if(pBufferObj->ReleaseSendCounter() == 0)
+		AddFreeBufferObj(pBufferObj);
+
+	return rs;
+}
+
+EnHandleResult CTcpServer::TriggerFireSend(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
 {
 	EnHandleResult rs = (EnHandleResult)HR_CLOSED;
 
 	if(m_enOnSendSyncPolicy == OSSP_NONE)
-		rs = TRIGGER(FireSend(pSocketObj, (BYTE*)pBufferObj->buff.buf, pBufferObj->buff.len));
+		rs = TRIGGER(FireSend(pSocketObj, pData, iLength));
 	else
 	{
 		ASSERT(m_enOnSendSyncPolicy >= OSSP_CLOSE && m_enOnSendSyncPolicy <= OSSP_RECEIVE);
@@ -71,7 +81,7 @@ EnHandleResult CTcpServer::TriggerFireSend(TSocketObj* pSocketObj, TBufferObj* p
 
 			if(TSocketObj::IsValid(pSocketObj))
 			{
-				rs = TRIGGER(FireSend(pSocketObj, (BYTE*)pBufferObj->buff.buf, pBufferObj->buff.len));
+				rs = TRIGGER(FireSend(pSocketObj, pData, iLength));
 			}
 		}
 	}
@@ -82,9 +92,6 @@ EnHandleResult CTcpServer::TriggerFireSend(TSocketObj* pSocketObj, TBufferObj* p
 		ASSERT(FALSE);
 	}
 
-	if(pBufferObj->ReleaseSendCounter() == 0)
-		AddFreeBufferObj(pBufferObj);
-
 	return rs;
 }
 
@@ -135,13 +142,16 @@ BOOL CTcpServer::CheckParams()
 		((int)m_dwAcceptSocketCount > 0)														&&
 		((int)m_dwSocketBufferSize >= MIN_SOCKET_BUFFER_SIZE)									&&
 		((int)m_dwSocketListenQueue > 0)														&&
-		((int)m_dwFreeSocketObjLockTime >= 1000)												&&
 		((int)m_dwFreeSocketObjPool >= 0)														&&
 		((int)m_dwFreeBufferObjPool >= 0)														&&
 		((int)m_dwFreeSocketObjHold >= 0)														&&
 		((int)m_dwFreeBufferObjHold >= 0)														&&
 		((int)m_dwKeepAliveTime >= 1000 || m_dwKeepAliveTime == 0)								&&
-		((int)m_dwKeepAliveInterval >= 1000 || m_dwKeepAliveInterval == 0)						)
+		((int)m_dwKeepAliveInterval >= 1000 || m_dwKeepAliveInterval == 0)						&&
+		(m_dwSilenceTimeout <= MAX_CONNECTION_PERIOD)											&&
+		(m_dwMaxLifetime <= MAX_CONNECTION_PERIOD)												&&
+		((int)m_dwSendHighWatermark >= 0)														&&
+		(m_dwSendHighWatermark == 0 || m_dwSendLowWatermark < m_dwSendHighWatermark)			)
 		return TRUE;
 
 	SetLastError(SE_INVALID_PARAM, __FUNCTION__, ERROR_INVALID_PARAMETER);
@@ -156,8 +166,30 @@ void CTcpServer::PrepareStart()
 	m_bfObjPool.SetItemCapacity(m_dwSocketBufferSize);
 	m_bfObjPool.SetPoolSize(m_dwFreeBufferObjPool);
 	m_bfObjPool.SetPoolHold(m_dwFreeBufferObjHold);
+	m_bfObjPool.SetLocalHigh(m_dwFreeBufferObjLocalHigh);
+	m_bfObjPool.SetLocalLow(m_dwFreeBufferObjLocalLow);
 
 	m_bfObjPool.Prepare();
+
+#ifdef _DEBUG
+	TSocketObj* pSocketObj = TSocketObj::Construct(m_phSocket, m_bfObjPool);
+	::CheckSocketObjLayout("TSocketObj", pSocketObj);
+	TSocketObj::Destruct(pSocketObj);
+#endif
+
+	if(m_bZeroByteReceive)
+	{
+		m_bfNotifyPool.SetItemCapacity(RECV_NOTIFY_BUFFER_SIZE);
+		m_bfNotifyPool.SetPoolSize(m_dwFreeBufferObjPool);
+		m_bfNotifyPool.SetPoolHold(m_dwFreeBufferObjHold);
+		m_bfNotifyPool.SetLocalHigh(m_dwFreeBufferObjLocalHigh);
+		m_bfNotifyPool.SetLocalLow(m_dwFreeBufferObjLocalLow);
+
+		m_bfNotifyPool.Prepare();
+	}
+
+	if(IsNeedEvictConnection())
+		m_tqEvict.CreateTimer(EvictTimerProc, this, m_twEvict.GetTick());
 }
 
 BOOL CTcpServer::CheckStarting()
@@ -223,10 +255,12 @@ BOOL CTcpServer::CreateListenSocket(LPCTSTR lpszBindAddress, USHORT usPort)
 						m_pfnAcceptEx				= ::Get_AcceptEx_FuncPtr(m_soListen);
 						m_pfnGetAcceptExSockaddrs	= ::Get_GetAcceptExSockaddrs_FuncPtr(m_soListen);
 						m_pfnDisconnectEx			= ::Get_DisconnectEx_FuncPtr(m_soListen);
+						m_pfnTransmitFile			= ::Get_TransmitFile_FuncPtr(m_soListen);
 
 						ASSERT(m_pfnAcceptEx);
 						ASSERT(m_pfnGetAcceptExSockaddrs);
 						ASSERT(m_pfnDisconnectEx);
+						ASSERT(m_pfnTransmitFile);
 
 						isOK = TRUE;
 					}
@@ -250,18 +284,34 @@ BOOL CTcpServer::CreateListenSocket(LPCTSTR lpszBindAddress, USHORT usPort)
 
 BOOL CTcpServer::CreateCompletePort()
 {
-	m_hCompletePort	= ::CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 0);
-	
-	if(m_hCompletePort == nullptr)
-		SetLastError(SE_CP_CREATE, __FUNCTION__, ::GetLastError());
+	// 连接亲和模式下每个工作线程拥有独立的完成端口，0 号完成端口同时负责监听 Socket
+	DWORD dwCount = m_bWorkerAffinity ? m_dwWorkerThreadCount : 1;
+
+	for(DWORD i = 0; i < dwCount; i++)
+	{
+		HANDLE hCompletePort = ::CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 0);
+
+		if(hCompletePort == nullptr)
+		{
+			SetLastError(SE_CP_CREATE, __FUNCTION__, ::GetLastError());
+			return FALSE;
+		}
 
-	return (m_hCompletePort != nullptr);
+		m_vtCompletePorts.push_back(hCompletePort);
+	}
+
+	m_hCompletePort = m_vtCompletePorts[0];
+
+	return TRUE;
 }
 
 BOOL CTcpServer::CreateWorkerThreads()
 {
 	BOOL isOK = TRUE;
 
+	m_iWorkerIndex = 0;
+	m_vtWorkerThreadIDs.assign(m_dwWorkerThreadCount, 0);
+
 	for(DWORD i = 0; i < m_dwWorkerThreadCount; i++)
 	{
 		HANDLE hThread = (HANDLE)_beginthreadex(nullptr, 0, WorkerThreadProc, (LPVOID)this, 0, nullptr);
@@ -328,12 +378,17 @@ BOOL CTcpServer::Stop()
 
 void CTcpServer::Reset()
 {
+	ReleaseGroups();
+
+	m_tqEvict.Reset();
+	m_twEvict.Reset();
 	m_phSocket.Reset();
 
 	m_iRemainAcceptSockets		= 0;
 	m_pfnAcceptEx				= nullptr;
 	m_pfnGetAcceptExSockaddrs	= nullptr;
 	m_pfnDisconnectEx			= nullptr;
+	m_pfnTransmitFile			= nullptr;
 	m_enState					= SS_STOPPED;
 	m_usFamily					= AF_UNSPEC;
 
@@ -368,21 +423,12 @@ void CTcpServer::ReleaseClientSocket()
 
 TSocketObj*	CTcpServer::GetFreeSocketObj(CONNID dwConnID, SOCKET soClient)
 {
-	DWORD dwIndex;
 	TSocketObj* pSocketObj = nullptr;
 
-	if(m_lsFreeSocket.TryLock(&pSocketObj, dwIndex))
-	{
-		if(::GetTimeGap32(pSocketObj->freeTime) >= m_dwFreeSocketObjLockTime)
-			ENSURE(m_lsFreeSocket.ReleaseLock(nullptr, dwIndex));
-		else
-		{
-			ENSURE(m_lsFreeSocket.ReleaseLock(pSocketObj, dwIndex));
-			pSocketObj = nullptr;
-		}
-	}
+	// 空闲池中的对象均已经过纪元回收，可直接复用
+	if(!m_lsFreeSocket.TryGet(&pSocketObj))
+		pSocketObj = CreateSocketObj();
 
-	if(!pSocketObj) pSocketObj = CreateSocketObj();
 	pSocketObj->Reset(dwConnID, soClient);
 
 	return pSocketObj;
@@ -393,20 +439,21 @@ void CTcpServer::AddFreeSocketObj(TSocketObj* pSocketObj, EnSocketCloseFlag enFl
 	if(!InvalidSocketObj(pSocketObj))
 		return;
 
+	LeaveAllGroups(pSocketObj);
 	CloseClientSocketObj(pSocketObj, enFlag, enOperation, iErrorCode);
 
 	m_bfActiveSockets.Remove(pSocketObj->connID);
+	m_twEvict.Cancel(&pSocketObj->timer);
 	TSocketObj::Release(pSocketObj);
 
+	m_gcSocket.Retire(pSocketObj);
+
 	ReleaseGCSocketObj();
-	
-	if(!m_lsFreeSocket.TryPut(pSocketObj))
-		m_lsGCSocket.PushBack(pSocketObj);
 }
 
 void CTcpServer::ReleaseGCSocketObj(BOOL bForce)
 {
-	::ReleaseGCObj(m_lsGCSocket, m_dwFreeSocketObjLockTime, bForce);
+	m_gcSocket.Reclaim(m_lsFreeSocket, bForce);
 }
 
 BOOL CTcpServer::InvalidSocketObj(TSocketObj* pSocketObj)
@@ -425,6 +472,36 @@ void CTcpServer::AddClientSocketObj(CONNID dwConnID, TSocketObj* pSocketObj, con
 	pSocketObj->SetConnected();
 
 	ENSURE(m_bfActiveSockets.ReleaseLock(dwConnID, pSocketObj));
+
+	if(IsNeedEvictConnection())
+		m_twEvict.Schedule(&pSocketObj->timer, GetEvictDelay(pSocketObj, pSocketObj->connTime));
+}
+
+DWORD CTcpServer::GetEvictDelay(TSocketObj* pSocketObj, DWORD dwCurrent)
+{
+	DWORD dwDelay = INFINITE;
+
+	if(m_dwMaxLifetime > 0)
+	{
+		int iRemain = (int)m_dwMaxLifetime - (int)(dwCurrent - pSocketObj->connTime);
+
+		if(iRemain <= 0)
+			return 0;
+
+		dwDelay = (DWORD)iRemain;
+	}
+
+	if(m_dwSilenceTimeout > 0 && m_bMarkSilence)
+	{
+		int iRemain = (int)m_dwSilenceTimeout - (int)(dwCurrent - pSocketObj->activeTime);
+
+		if(iRemain <= 0)
+			return 0;
+
+		dwDelay = min(dwDelay, (DWORD)iRemain);
+	}
+
+	return dwDelay;
 }
 
 void CTcpServer::ReleaseFreeSocket()
@@ -432,7 +509,7 @@ void CTcpServer::ReleaseFreeSocket()
 	m_lsFreeSocket.Clear();
 
 	ReleaseGCSocketObj(TRUE);
-	ENSURE(m_lsGCSocket.IsEmpty());
+	ENSURE(m_gcSocket.IsEmpty());
 }
 
 TSocketObj* CTcpServer::CreateSocketObj()
@@ -458,12 +535,14 @@ TBufferObj* CTcpServer::GetFreeBufferObj(int iLen)
 
 void CTcpServer::AddFreeBufferObj(TBufferObj* pBufferObj)
 {
+	pBufferObj->Detach();
 	m_bfObjPool.PutFreeItem(pBufferObj);
 }
 
 void CTcpServer::ReleaseFreeBuffer()
 {
 	m_bfObjPool.Clear();
+	m_bfNotifyPool.Clear();
 }
 
 TSocketObj* CTcpServer::FindSocketObj(CONNID dwConnID)
@@ -500,6 +579,8 @@ BOOL CTcpServer::GetListenAddress(TCHAR lpszAddress[], int& iAddressLen, USHORT&
 
 BOOL CTcpServer::GetLocalAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	ASSERT(lpszAddress != nullptr && iAddressLen > 0);
 
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -512,6 +593,8 @@ BOOL CTcpServer::GetLocalAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAdd
 
 BOOL CTcpServer::GetRemoteAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAddressLen, USHORT& usPort)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	ASSERT(lpszAddress != nullptr && iAddressLen > 0);
 
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -527,6 +610,8 @@ BOOL CTcpServer::GetRemoteAddress(CONNID dwConnID, TCHAR lpszAddress[], int& iAd
 
 BOOL CTcpServer::SetConnectionExtra(CONNID dwConnID, PVOID pExtra)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionExtra(pSocketObj, pExtra);
 }
@@ -544,6 +629,8 @@ BOOL CTcpServer::SetConnectionExtra(TSocketObj* pSocketObj, PVOID pExtra)
 
 BOOL CTcpServer::GetConnectionExtra(CONNID dwConnID, PVOID* ppExtra)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionExtra(pSocketObj, ppExtra);
 }
@@ -563,6 +650,8 @@ BOOL CTcpServer::GetConnectionExtra(TSocketObj* pSocketObj, PVOID* ppExtra)
 
 BOOL CTcpServer::SetConnectionReserved(CONNID dwConnID, PVOID pReserved)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionReserved(pSocketObj, pReserved);
 }
@@ -580,6 +669,8 @@ BOOL CTcpServer::SetConnectionReserved(TSocketObj* pSocketObj, PVOID pReserved)
 
 BOOL CTcpServer::GetConnectionReserved(CONNID dwConnID, PVOID* ppReserved)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionReserved(pSocketObj, ppReserved);
 }
@@ -599,6 +690,8 @@ BOOL CTcpServer::GetConnectionReserved(TSocketObj* pSocketObj, PVOID* ppReserved
 
 BOOL CTcpServer::SetConnectionReserved2(CONNID dwConnID, PVOID pReserved2)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return SetConnectionReserved2(pSocketObj, pReserved2);
 }
@@ -616,6 +709,8 @@ BOOL CTcpServer::SetConnectionReserved2(TSocketObj* pSocketObj, PVOID pReserved2
 
 BOOL CTcpServer::GetConnectionReserved2(CONNID dwConnID, PVOID* ppReserved2)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 	return GetConnectionReserved2(pSocketObj, ppReserved2);
 }
@@ -635,6 +730,8 @@ BOOL CTcpServer::GetConnectionReserved2(TSocketObj* pSocketObj, PVOID* ppReserve
 
 BOOL CTcpServer::IsPauseReceive(CONNID dwConnID, BOOL& bPaused)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TSocketObj::IsValid(pSocketObj))
@@ -648,6 +745,8 @@ BOOL CTcpServer::IsPauseReceive(CONNID dwConnID, BOOL& bPaused)
 
 BOOL CTcpServer::IsConnected(CONNID dwConnID)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TSocketObj::IsValid(pSocketObj))
@@ -658,6 +757,8 @@ BOOL CTcpServer::IsConnected(CONNID dwConnID)
 
 BOOL CTcpServer::GetPendingDataLength(CONNID dwConnID, int& iPending)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(TSocketObj::IsValid(pSocketObj))
@@ -669,6 +770,61 @@ BOOL CTcpServer::GetPendingDataLength(CONNID dwConnID, int& iPending)
 	return FALSE;
 }
 
+BOOL CTcpServer::GetHeapClassStat(DWORD dwClass, THeapClassStat& stat)
+{
+	::ZeroMemory(&stat, sizeof(THeapClassStat));
+
+#if !defined(_NOT_USE_PRIVATE_HEAP) && !defined(_NOT_USE_SLAB_HEAP)
+	CPrivateHeap* heaps[] = {&m_phSocket, &m_bfObjPool.GetPrivateHeap(), &m_bfNotifyPool.GetPrivateHeap()};
+
+	for(int i = 0; i < _countof(heaps); i++)
+	{
+		CPrivateHeap::TClassStat cs;
+
+		if(!heaps[i]->GetClassStat(dwClass, cs))
+		{
+			::SetLastError(ERROR_INVALID_PARAMETER);
+			return FALSE;
+		}
+
+		stat.slotSize	 = cs.slotSize;
+		stat.slabCount	+= cs.slabCount;
+		stat.totalSlots	+= cs.totalSlots;
+		stat.usedSlots	+= cs.usedSlots;
+		stat.cachedSlots+= cs.cachedSlots;
+	}
+
+	return TRUE;
+#else
+	::SetLastError(ERROR_CALL_NOT_IMPLEMENTED);
+	return FALSE;
+#endif
+}
+
+BOOL CTcpServer::GetHeapLargeStat(SIZE_T& dwCount, SIZE_T& dwBytes)
+{
+	dwCount	= 0;
+	dwBytes	= 0;
+
+#if !defined(_NOT_USE_PRIVATE_HEAP) && !defined(_NOT_USE_SLAB_HEAP)
+	CPrivateHeap* heaps[] = {&m_phSocket, &m_bfObjPool.GetPrivateHeap(), &m_bfNotifyPool.GetPrivateHeap()};
+
+	for(int i = 0; i < _countof(heaps); i++)
+	{
+		SIZE_T dwHeapCount, dwHeapBytes;
+		heaps[i]->GetLargeStat(dwHeapCount, dwHeapBytes);
+
+		dwCount	+= dwHeapCount;
+		dwBytes	+= dwHeapBytes;
+	}
+
+	return TRUE;
+#else
+	::SetLastError(ERROR_CALL_NOT_IMPLEMENTED);
+	return FALSE;
+#endif
+}
+
 DWORD CTcpServer::GetConnectionCount()
 {
 	return m_bfActiveSockets.Elements();
@@ -681,6 +837,8 @@ BOOL CTcpServer::GetAllConnectionIDs(CONNID pIDs[], DWORD& dwCount)
 
 BOOL CTcpServer::GetConnectPeriod(CONNID dwConnID, DWORD& dwPeriod)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	BOOL isOK				= TRUE;
 	TSocketObj* pSocketObj	= FindSocketObj(dwConnID);
 
@@ -694,6 +852,8 @@ BOOL CTcpServer::GetConnectPeriod(CONNID dwConnID, DWORD& dwPeriod)
 
 BOOL CTcpServer::GetSilencePeriod(CONNID dwConnID, DWORD& dwPeriod)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	if(!m_bMarkSilence)
 		return FALSE;
 
@@ -708,8 +868,269 @@ BOOL CTcpServer::GetSilencePeriod(CONNID dwConnID, DWORD& dwPeriod)
 	return isOK;
 }
 
+DWORD CTcpServer::CreateGroup()
+{
+	if(!HasStarted())
+	{
+		::SetLastError(ERROR_INVALID_STATE);
+		return 0;
+	}
+
+	DWORD dwGroupID;
+
+	do
+	{
+		dwGroupID = (DWORD)::InterlockedIncrement(&m_lGroupID);
+	} while(dwGroupID == 0);
+
+	TConnGroup* pGroup = new TConnGroup;
+
+	{
+		CWriteLock locallock(m_csGroups);
+		m_mpGroups[dwGroupID] = pGroup;
+	}
+
+	return dwGroupID;
+}
+
+BOOL CTcpServer::DestroyGroup(DWORD dwGroupID)
+{
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
+	TConnGroup* pGroup = nullptr;
+
+	{
+		CWriteLock locallock(m_csGroups);
+
+		TConnGroupMapI it = m_mpGroups.find(dwGroupID);
+
+		if(it == m_mpGroups.end())
+		{
+			::SetLastError(ERROR_OBJECT_NOT_FOUND);
+			return FALSE;
+		}
+
+		pGroup = it->second;
+		m_mpGroups.erase(it);
+
+		// 分组已从注册表摘除，不会再有其它线程访问其成员数组
+		for(size_t i = 0, size = pGroup->members.size(); i < size; i++)
+		{
+			TSocketObj* pSocketObj = FindSocketObj(pGroup->members[i]);
+
+			if(!TSocketObj::IsExist(pSocketObj))
+				continue;
+
+			CCriSecLock locallock2(pSocketObj->csSend);
+
+			vector<DWORD>& groups = pSocketObj->groups;
+			vector<DWORD>::iterator it2 = find(groups.begin(), groups.end(), dwGroupID);
+
+			if(it2 != groups.end())
+			{
+				*it2 = groups.back();
+				groups.pop_back();
+			}
+		}
+	}
+
+	delete pGroup;
+
+	return TRUE;
+}
+
+BOOL CTcpServer::JoinGroup(DWORD dwGroupID, CONNID dwConnID)
+{
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
+	CReadLock locallock(m_csGroups);
+
+	TConnGroupMapCI it = m_mpGroups.find(dwGroupID);
+
+	if(it == m_mpGroups.end())
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	TConnGroup* pGroup		= it->second;
+	TSocketObj* pSocketObj	= FindSocketObj(dwConnID);
+
+	if(!TSocketObj::IsValid(pSocketObj))
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	CWriteLock locallock2(pGroup->cs);
+	CCriSecLock locallock3(pSocketObj->csSend);
+
+	// 连接关闭时先置为无效再退出所有分组，在 csSend 保护下检查可避免关闭后再加入
+	if(!TSocketObj::IsValid(pSocketObj) || pSocketObj->connID != dwConnID)
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	vector<DWORD>& groups = pSocketObj->groups;
+
+	if(find(groups.begin(), groups.end(), dwGroupID) == groups.end())
+	{
+		groups.push_back(dwGroupID);
+		pGroup->members.push_back(dwConnID);
+	}
+
+	return TRUE;
+}
+
+BOOL CTcpServer::LeaveGroup(DWORD dwGroupID, CONNID dwConnID)
+{
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
+	CReadLock locallock(m_csGroups);
+
+	TConnGroupMapCI it = m_mpGroups.find(dwGroupID);
+
+	if(it == m_mpGroups.end())
+	{
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+		return FALSE;
+	}
+
+	TConnGroup* pGroup = it->second;
+
+	{
+		CWriteLock locallock2(pGroup->cs);
+
+		vector<CONNID>& members = pGroup->members;
+		vector<CONNID>::iterator it2 = find(members.begin(), members.end(), dwConnID);
+
+		if(it2 == members.end())
+		{
+			::SetLastError(ERROR_OBJECT_NOT_FOUND);
+			return FALSE;
+		}
+
+		*it2 = members.back();
+		members.pop_back();
+
+		TSocketObj* pSocketObj = FindSocketObj(dwConnID);
+
+		if(TSocketObj::IsExist(pSocketObj))
+		{
+			CCriSecLock locallock3(pSocketObj->csSend);
+
+			vector<DWORD>& groups = pSocketObj->groups;
+			vector<DWORD>::iterator it3 = find(groups.begin(), groups.end(), dwGroupID);
+
+			if(it3 != groups.end())
+			{
+				*it3 = groups.back();
+				groups.pop_back();
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+DWORD CTcpServer::GetGroupMemberCount(DWORD dwGroupID)
+{
+	CReadLock locallock(m_csGroups);
+
+	TConnGroupMapCI it = m_mpGroups.find(dwGroupID);
+
+	if(it == m_mpGroups.end())
+		return 0;
+
+	CReadLock locallock2(it->second->cs);
+
+	return (DWORD)it->second->members.size();
+}
+
+BOOL CTcpServer::GetGroupMemberIDs(DWORD dwGroupID, CONNID pIDs[], DWORD& dwCount)
+{
+	CReadLock locallock(m_csGroups);
+
+	TConnGroupMapCI it = m_mpGroups.find(dwGroupID);
+
+	if(it == m_mpGroups.end())
+	{
+		dwCount = 0;
+		::SetLastError(ERROR_OBJECT_NOT_FOUND);
+
+		return FALSE;
+	}
+
+	CReadLock locallock2(it->second->cs);
+
+	const vector<CONNID>& members = it->second->members;
+	DWORD dwSize = (DWORD)members.size();
+
+	if(pIDs == nullptr || dwCount == 0 || dwSize == 0 || dwSize > dwCount)
+	{
+		dwCount = dwSize;
+		return FALSE;
+	}
+
+	for(DWORD i = 0; i < dwSize; i++)
+		pIDs[i] = members[i];
+
+	dwCount = dwSize;
+
+	return TRUE;
+}
+
+void CTcpServer::LeaveAllGroups(TSocketObj* pSocketObj)
+{
+	vector<DWORD> groups;
+
+	{
+		CCriSecLock locallock(pSocketObj->csSend);
+		groups.swap(pSocketObj->groups);
+	}
+
+	if(groups.empty())
+		return;
+
+	CONNID dwConnID = pSocketObj->connID;
+	CReadLock locallock(m_csGroups);
+
+	for(size_t i = 0, size = groups.size(); i < size; i++)
+	{
+		TConnGroupMapCI it = m_mpGroups.find(groups[i]);
+
+		if(it == m_mpGroups.end())
+			continue;
+
+		TConnGroup* pGroup = it->second;
+		CWriteLock locallock2(pGroup->cs);
+
+		vector<CONNID>& members = pGroup->members;
+		vector<CONNID>::iterator it2 = find(members.begin(), members.end(), dwConnID);
+
+		if(it2 != members.end())
+		{
+			*it2 = members.back();
+			members.pop_back();
+		}
+	}
+}
+
+void CTcpServer::ReleaseGroups()
+{
+	CWriteLock locallock(m_csGroups);
+
+	for(TConnGroupMapCI it = m_mpGroups.begin(), end = m_mpGroups.end(); it != end; ++it)
+		delete it->second;
+
+	m_mpGroups.clear();
+}
+
 BOOL CTcpServer::Disconnect(CONNID dwConnID, BOOL bForce)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TSocketObj::IsValid(pSocketObj))
@@ -718,11 +1139,13 @@ BOOL CTcpServer::Disconnect(CONNID dwConnID, BOOL bForce)
 		return FALSE;
 	}
 
-	return ::PostIocpDisconnect(m_hCompletePort, dwConnID);
+	return ::PostIocpDisconnect(GetCompletePort(dwConnID), dwConnID);
 }
 
 BOOL CTcpServer::DisconnectLongConnections(DWORD dwPeriod, BOOL bForce)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	if(dwPeriod > MAX_CONNECTION_PERIOD)
 		return FALSE;
 
@@ -744,6 +1167,8 @@ BOOL CTcpServer::DisconnectLongConnections(DWORD dwPeriod, BOOL bForce)
 
 BOOL CTcpServer::DisconnectSilenceConnections(DWORD dwPeriod, BOOL bForce)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	if(!m_bMarkSilence)
 		return FALSE;
 	if(dwPeriod > MAX_CONNECTION_PERIOD)
@@ -765,6 +1190,29 @@ BOOL CTcpServer::DisconnectSilenceConnections(DWORD dwPeriod, BOOL bForce)
 	return TRUE;
 }
 
+void WINAPI CTcpServer::EvictTimerProc(LPVOID pv, BOOLEAN bTimerFired)
+{
+	CTcpServer* pServer = (CTcpServer*)pv;
+
+	pServer->m_twEvict.Advance(EvictConnectionProc, pServer);
+}
+
+DWORD CTcpServer::EvictConnectionProc(TTimerNode* pNode, PVOID pv)
+{
+	CTcpServer* pServer		= (CTcpServer*)pv;
+	TSocketObj* pSocketObj	= CONTAINING_RECORD(pNode, TSocketObj, timer);
+
+	if(!TSocketObj::IsValid(pSocketObj))
+		return 0;
+
+	DWORD dwDelay = pServer->GetEvictDelay(pSocketObj, ::TimeGetTime());
+
+	if(dwDelay == 0)
+		pServer->Disconnect(pSocketObj->connID);
+
+	return dwDelay;
+}
+
 void CTcpServer::WaitForAcceptSocketClose()
 {
 	while(m_iRemainAcceptSockets > 0)
@@ -782,7 +1230,7 @@ void CTcpServer::WaitForWorkerThreadEnd()
 	int count = (int)m_vtWorkerThreads.size();
 
 	for(int i = 0; i < count; i++)
-		::PostIocpExit(m_hCompletePort);
+		::PostIocpExit(m_vtCompletePorts[i % m_vtCompletePorts.size()]);
 
 	int remain	= count;
 	int index	= 0;
@@ -809,11 +1257,31 @@ void CTcpServer::WaitForWorkerThreadEnd()
 
 void CTcpServer::CloseCompletePort()
 {
-	if(m_hCompletePort != nullptr)
-	{
-		::CloseHandle(m_hCompletePort);
-		m_hCompletePort = nullptr;
-	}
+	for(size_t i = 0; i < m_vtCompletePorts.size(); i++)
+		::CloseHandle(m_vtCompletePorts[i]);
+
+	m_vtCompletePorts.clear();
+	m_hCompletePort = nullptr;
+}
+
+HANDLE CTcpServer::AttachWorkerThread()
+{
+	DWORD dwIndex = (DWORD)::InterlockedIncrement(&m_iWorkerIndex) - 1;
+	ASSERT(dwIndex < m_dwWorkerThreadCount);
+
+	m_vtWorkerThreadIDs[dwIndex] = SELF_THREAD_ID;
+
+	return m_vtCompletePorts[dwIndex % m_vtCompletePorts.size()];
+}
+
+HANDLE CTcpServer::GetCompletePort(CONNID dwConnID)
+{
+	return m_vtCompletePorts[(size_t)(dwConnID % m_vtCompletePorts.size())];
+}
+
+BOOL CTcpServer::IsOwnerThread(CONNID dwConnID)
+{
+	return m_bWorkerAffinity && m_vtWorkerThreadIDs[(size_t)(dwConnID % m_vtWorkerThreadIDs.size())] == SELF_THREAD_ID;
 }
 
 BOOL CTcpServer::DoAccept()
@@ -849,69 +1317,156 @@ BOOL CTcpServer::DoAccept()
 
 UINT WINAPI CTcpServer::WorkerThreadProc(LPVOID pv)
 {
-	CTcpServer* pServer = (CTcpServer*)pv;
+	CTcpServer* pServer		= (CTcpServer*)pv;
+	HANDLE hCompletePort	= pServer->AttachWorkerThread();
+
 	pServer->OnWorkerThreadStart(SELF_THREAD_ID);
 
-	while(TRUE)
+#if _WIN32_WINNT >= _WIN32_WINNT_VISTA
+
+	OVERLAPPED_ENTRY entries[MAX_IOCP_BATCH_ENTRIES];
+	BOOL bExit = FALSE;
+
+	while(!bExit)
 	{
-		DWORD dwErrorCode = NO_ERROR;
+		ULONG ulCount = 0;
 
-		DWORD dwBytes;
-		OVERLAPPED* pOverlapped;
-		TSocketObj* pSocketObj;
-		
-		BOOL result = ::GetQueuedCompletionStatus
+		BOOL result = ::GetQueuedCompletionStatusEx
 												(
-													pServer->m_hCompletePort,
-													&dwBytes,
-													(PULONG_PTR)&pSocketObj,
-													&pOverlapped,
-													INFINITE
+													hCompletePort,
+													entries,
+													MAX_IOCP_BATCH_ENTRIES,
+													&ulCount,
+													INFINITE,
+													FALSE
 												);
 
-		if(pOverlapped == nullptr)
+		if(!result)
 		{
-			EnIocpAction action = pServer->CheckIocpCommand(pOverlapped, dwBytes, (ULONG_PTR)pSocketObj);
+			TRACE("GetQueuedCompletionStatusEx error (SYS: %d)\n", ::GetLastError());
+			ASSERT(FALSE);
 
-			if(action == IOCP_ACT_CONTINUE)
-				continue;
-			else if(action == IOCP_ACT_BREAK)
-				break;
+			break;
 		}
 
-		TBufferObj* pBufferObj	= CONTAINING_RECORD(pOverlapped, TBufferObj, ov);
-		CONNID dwConnID			= pBufferObj->operation != SO_ACCEPT ? pSocketObj->connID : 0;
-
-		if (!result)
 		{
-			DWORD dwFlag	= 0;
-			DWORD dwSysCode = ::GetLastError();
+			// 整个批次处于纪元读者区内，期间取得的 TSocketObj 不会被回收复用
+			CEpochLock locallock(pServer->m_gcSocket.GetEpoch());
 
-			if(pServer->HasStarted())
+			for(ULONG i = 0; i < ulCount; i++)
 			{
-				SOCKET sock	= pBufferObj->operation != SO_ACCEPT ? pBufferObj->client : (SOCKET)pSocketObj;
-				result		= ::WSAGetOverlappedResult(sock, &pBufferObj->ov, &dwBytes, FALSE, &dwFlag);
+				OVERLAPPED_ENTRY& entry = entries[i];
+				OVERLAPPED* pOverlapped	= entry.lpOverlapped;
 
-				if (!result)
+				if(pOverlapped == nullptr && entry.dwNumberOfBytesTransferred == IOCP_CMD_EXIT && bExit)
 				{
-					dwErrorCode = ::WSAGetLastError();
-					TRACE("GetQueuedCompletionStatus error (<S-CNNID: %Iu> SYS: %d, SOCK: %d, FLAG: %d)\n", dwConnID, dwSysCode, dwErrorCode, dwFlag);
+					// 同一批次中的多余退出指令转交给其它工作线程
+					ENSURE(::PostIocpExit(hCompletePort));
+					continue;
 				}
+
+				result = (pOverlapped == nullptr || IOCP_OV_SUCCESS(pOverlapped));
+
+				if(pServer->DispatchCompletion(pOverlapped, entry.dwNumberOfBytesTransferred, entry.lpCompletionKey, result, NO_ERROR) == IOCP_ACT_BREAK)
+					bExit = TRUE;
 			}
-			else
-				dwErrorCode = dwSysCode;
+		}
 
-			ASSERT(dwSysCode != 0 && dwErrorCode != 0);
+		pServer->ReleaseGCSocketObj();
+	}
+
+#else
+
+	while(TRUE)
+	{
+		DWORD dwBytes;
+		OVERLAPPED* pOverlapped;
+		ULONG_PTR ulCompKey;
+
+		BOOL result = ::GetQueuedCompletionStatus
+												(
+													hCompletePort,
+													&dwBytes,
+													&ulCompKey,
+													&pOverlapped,
+													INFINITE
+												);
+
+		EnIocpAction action;
+
+		{
+			CEpochLock locallock(pServer->m_gcSocket.GetEpoch());
+			action = pServer->DispatchCompletion(pOverlapped, dwBytes, ulCompKey, result, result ? NO_ERROR : ::GetLastError());
 		}
 
-		pServer->HandleIo(dwConnID, pSocketObj, pBufferObj, dwBytes, dwErrorCode);
+		if(action == IOCP_ACT_BREAK)
+			break;
+
+		pServer->ReleaseGCSocketObj();
 	}
 
+#endif
+
 	pServer->OnWorkerThreadEnd(SELF_THREAD_ID);
 
 	return 0;
 }
 
+EnIocpAction CTcpServer::DispatchCompletion(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey, BOOL result, DWORD dwSysCode)
+{
+	if(pOverlapped == nullptr)
+		return CheckIocpCommand(pOverlapped, dwBytes, ulCompKey);
+
+	TBufferObj* pBufferObj	= CONTAINING_RECORD(pOverlapped, TBufferObj, ov);
+
+	if(pBufferObj->operation == SO_MAIL)
+	{
+		HandleMail((CONNID)ulCompKey, pBufferObj);
+		return IOCP_ACT_GOON;
+	}
+	else if(pBufferObj->operation == SO_ACCEPTED)
+	{
+		HandleAccepted((CONNID)ulCompKey, pBufferObj);
+		return IOCP_ACT_GOON;
+	}
+
+	DWORD dwErrorCode		= NO_ERROR;
+	TSocketObj* pSocketObj	= (TSocketObj*)ulCompKey;
+	CONNID dwConnID			= pBufferObj->operation != SO_ACCEPT ? pSocketObj->connID : 0;
+
+	if (!result)
+	{
+		DWORD dwFlag = 0;
+
+		// dwSysCode 为 NO_ERROR 表示调用方无法获取系统错误代码（批量出队），需通过 WSAGetOverlappedResult() 获取
+		if(HasStarted() || dwSysCode == NO_ERROR)
+		{
+			SOCKET sock	= pBufferObj->operation != SO_ACCEPT ? pBufferObj->client : (SOCKET)pSocketObj;
+			result		= ::WSAGetOverlappedResult(sock, &pBufferObj->ov, &dwBytes, FALSE, &dwFlag);
+
+			if (!result)
+			{
+				dwErrorCode = ::WSAGetLastError();
+				TRACE("GetQueuedCompletionStatus error (<S-CNNID: %Iu> SYS: %d, SOCK: %d, FLAG: %d)\n", dwConnID, dwSysCode, dwErrorCode, dwFlag);
+			}
+		}
+		else
+			dwErrorCode = dwSysCode;
+
+		ASSERT(result || dwErrorCode != 0);
+	}
+
+	BOOL bSocketIo = (pBufferObj->operation != SO_ACCEPT);
+
+	HandleIo(dwConnID, pSocketObj, pBufferObj, dwBytes, dwErrorCode);
+
+	// 完成通知处理完毕后才允许回收 TSocketObj（完成键直接引用该对象）
+	if(bSocketIo)
+		pSocketObj->EndIo();
+
+	return IOCP_ACT_GOON;
+}
+
 EnIocpAction CTcpServer::CheckIocpCommand(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey)
 {
 	ASSERT(pOverlapped == nullptr);
@@ -923,6 +1478,7 @@ EnIocpAction CTcpServer::CheckIocpCommand(OVERLAPPED* pOverlapped, DWORD dwBytes
 	{
 	case IOCP_CMD_SEND		: DoSend(dwConnID)			; break;
 	case IOCP_CMD_UNPAUSE	: DoUnpause(dwConnID)		; break;
+	case IOCP_CMD_WATERMARK	: DoSendWatermark(dwConnID)	; break;
 	case IOCP_CMD_ACCEPT	: DoAccept()				; break;
 	case IOCP_CMD_DISCONNECT: ForceDisconnect(dwConnID)	; break;
 	case IOCP_CMD_EXIT		: action = IOCP_ACT_BREAK	; break;
@@ -948,6 +1504,12 @@ void CTcpServer::HandleIo(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* p
 		return;
 	}
 
+	if(m_bZeroByteReceive && pBufferObj->operation == SO_RECEIVE)
+	{
+		HandleNotify(dwConnID, pSocketObj, pBufferObj);
+		return;
+	}
+
 	if(dwBytes == 0 && pBufferObj->operation != SO_ACCEPT)
 	{
 		AddFreeSocketObj(pSocketObj, SCF_CLOSE);
@@ -980,17 +1542,55 @@ void CTcpServer::HandleError(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj
 	else
 	{
 		::ManualCloseSocket(pBufferObj->client);
-		ENSURE(::PostIocpAccept(m_hCompletePort));
+		DoAccept();
 	}
 
-	if(pBufferObj->operation != SO_SEND || pBufferObj->ReleaseSendCounter() == 0)
+	// TransmitFile() 投递成功后投递方不再访问缓冲区，不使用发送计数，由完成通知直接回收
+	if(m_bZeroByteReceive && pBufferObj->operation == SO_RECEIVE)
+		m_bfNotifyPool.PutFreeItem(pBufferObj);
+	else if(pBufferObj->operation != SO_SEND || pBufferObj->transfer != nullptr || pBufferObj->ReleaseSendCounter() == 0)
 		AddFreeBufferObj(pBufferObj);
 }
 
 void CTcpServer::HandleAccept(SOCKET soListen, TBufferObj* pBufferObj)
 {
-	ENSURE(::PostIocpAccept(m_hCompletePort));
+	// 在当前工作线程直接补投 AcceptEx，避免经由完成端口指令中转
+	DoAccept();
+
+	CONNID dwConnID = 0;
+
+	if(!HasStarted() || !m_bfActiveSockets.AcquireLock(dwConnID))
+	{
+		::ManualCloseSocket(pBufferObj->client, SD_BOTH);
+		AddFreeBufferObj(pBufferObj);
+
+		return;
+	}
+
+	// 连接亲和模式下监听 Socket 只能关联 0 号完成端口，连接 ID 锁定后（其它线程不可见）转交所属工作线程完成后续处理，
+	// 使建立连接及 OnAccept 事件的开销分摊到各工作线程
+	if(m_bWorkerAffinity && !IsOwnerThread(dwConnID) && ::PostIocpAccepted(GetCompletePort(dwConnID), dwConnID, pBufferObj))
+		return;
+
+	AcceptClient(dwConnID, soListen, pBufferObj);
+}
+
+void CTcpServer::HandleAccepted(CONNID dwConnID, TBufferObj* pBufferObj)
+{
+	if(!HasStarted())
+	{
+		::ManualCloseSocket(pBufferObj->client, SD_BOTH);
+		ENSURE(m_bfActiveSockets.ReleaseLock(dwConnID, nullptr));
+		AddFreeBufferObj(pBufferObj);
+
+		return;
+	}
+
+	AcceptClient(dwConnID, m_soListen, pBufferObj);
+}
 
+void CTcpServer::AcceptClient(CONNID dwConnID, SOCKET soListen, TBufferObj* pBufferObj)
+{
 	int iLocalSockaddrLen;
 	int iRemoteSockaddrLen;
 	HP_PSOCKADDR pLocalSockAddr;
@@ -1010,24 +1610,14 @@ void CTcpServer::HandleAccept(SOCKET soListen, TBufferObj* pBufferObj)
 								&iRemoteSockaddrLen
 							);
 
-	CONNID dwConnID = 0;
-	SOCKET socket	= pBufferObj->client;
-
-	if(!HasStarted() || !m_bfActiveSockets.AcquireLock(dwConnID))
-	{
-		::ManualCloseSocket(socket, SD_BOTH);
-		AddFreeBufferObj(pBufferObj);
-
-		return;
-	}
-
-	TSocketObj* pSocketObj = GetFreeSocketObj(dwConnID, socket);
+	SOCKET socket			= pBufferObj->client;
+	TSocketObj* pSocketObj	= GetFreeSocketObj(dwConnID, socket);
 	pSocketObj->csRecv.Lock();
 
 	AddClientSocketObj(dwConnID, pSocketObj, *pRemoteSockAddr);
 
 	::SSO_UpdateAcceptContext(socket, soListen);
-	::CreateIoCompletionPort((HANDLE)socket, m_hCompletePort, (ULONG_PTR)pSocketObj, 0);
+	::CreateIoCompletionPort((HANDLE)socket, GetCompletePort(dwConnID), (ULONG_PTR)pSocketObj, 0);
 
 	if(TriggerFireAccept(pSocketObj) != HR_ERROR)
 		DoReceive(pSocketObj, pBufferObj);
@@ -1040,6 +1630,12 @@ void CTcpServer::HandleAccept(SOCKET soListen, TBufferObj* pBufferObj)
 
 void CTcpServer::HandleSend(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj)
 {
+	if(pBufferObj->transfer != nullptr)
+	{
+		HandleTransmit(dwConnID, pSocketObj, pBufferObj);
+		return;
+	}
+
 	long iLength = -(long)(pBufferObj->buff.len);
 
 	switch(m_enSendPolicy)
@@ -1075,6 +1671,46 @@ void CTcpServer::HandleSend(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj*
 	default:
 		ASSERT(FALSE);
 	}
+
+	CheckSendWatermark(pSocketObj);
+}
+
+void CTcpServer::HandleTransmit(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	int iLength = (int)pBufferObj->buff.len;
+	::InterlockedExchangeAdd(&GetTransmitCounter(pSocketObj), -iLength);
+
+	BOOL bCompleted = pBufferObj->transfer->Advance();
+
+	TriggerFireSend(pSocketObj, nullptr, iLength);
+	CheckSendWatermark(pSocketObj);
+
+	if(bCompleted)
+		AddFreeBufferObj(pBufferObj);
+
+	int result = NO_ERROR;
+
+	{
+		CCriSecCondLock locallock(pSocketObj->csSend, !m_bWorkerAffinity);
+
+		if(!TSocketObj::IsValid(pSocketObj))
+		{
+			if(!bCompleted) AddFreeBufferObj(pBufferObj);
+			result = ERROR_OBJECT_NOT_FOUND;
+		}
+		else if(!bCompleted)
+			result = DoTransmit(pSocketObj, pBufferObj);
+		else if(m_enSendPolicy == SP_DIRECT)
+			result = FlushDirect(pSocketObj);
+		else
+			pSocketObj->transmit = FALSE;
+	}
+
+	// 文件传输完成后继续发送排在其后的数据
+	if(result == NO_ERROR && bCompleted && m_enSendPolicy != SP_DIRECT)
+		DoSend(pSocketObj);
+	else if(result != NO_ERROR)
+		CheckError(pSocketObj, SO_SEND, result);
 }
 
 void CTcpServer::HandleReceive(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj)
@@ -1110,6 +1746,43 @@ void CTcpServer::HandleReceive(CONNID dwConnID, TSocketObj* pSocketObj, TBufferO
 	}
 }
 
+void CTcpServer::HandleMail(CONNID dwConnID, TBufferObj* pBufferObj)
+{
+	TSocketObj* pSocketObj	= FindSocketObj(dwConnID);
+	BOOL bValid				= TSocketObj::IsValid(pSocketObj);
+	int result				= NO_ERROR;
+
+	while(pBufferObj != nullptr)
+	{
+		TBufferObj* pNext = pBufferObj->next;
+
+		if(!bValid || result != NO_ERROR)
+			AddFreeBufferObj(pBufferObj);
+		else if(pBufferObj->transfer != nullptr)
+			result = DoSendObj(pSocketObj, pBufferObj);
+		else if(pBufferObj->shared != nullptr)
+		{
+			result = DoSendShared(pSocketObj, pBufferObj->shared);
+			AddFreeBufferObj(pBufferObj);
+		}
+		else
+		{
+			result = SendInternal(pSocketObj, &pBufferObj->buff, 1);
+			AddFreeBufferObj(pBufferObj);
+		}
+
+		pBufferObj = pNext;
+	}
+
+	if(!bValid)
+		return;
+
+	::InterlockedDecrement(&pSocketObj->mails);
+
+	if(result != NO_ERROR)
+		CheckError(pSocketObj, SO_SEND, result);
+}
+
 int CTcpServer::DoUnpause(CONNID dwConnID)
 {
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -1130,8 +1803,45 @@ int CTcpServer::DoUnpause(CONNID dwConnID)
 	return DoReceive(pSocketObj, GetFreeBufferObj());
 }
 
+void CTcpServer::HandleNotify(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pNotifyObj)
+{
+	m_bfNotifyPool.PutFreeItem(pNotifyObj);
+
+	if(m_bMarkSilence) pSocketObj->activeTime = ::TimeGetTime();
+
+	TBufferObj* pBufferObj	= GetFreeBufferObj();
+	pBufferObj->client		= pSocketObj->socket;
+	EnHandleResult hr		= HR_OK;
+
+	if(::ContinueReceive(this, pSocketObj, pBufferObj, hr))
+	{
+		{
+			CSpinLock locallock(pSocketObj->sgPause);
+
+			pSocketObj->recving = FALSE;
+		}
+
+		DoReceive(pSocketObj, pBufferObj);
+	}
+
+	if(hr == HR_CLOSED)
+	{
+		AddFreeBufferObj(pBufferObj);
+	}
+	else if(hr == HR_ERROR)
+	{
+		TRACE("<S-CNNID: %Iu> OnReceive() event return 'HR_ERROR', connection will be closed !\n", dwConnID);
+
+		AddFreeSocketObj(pSocketObj, SCF_ERROR, SO_RECEIVE, ENSURE_ERROR_CANCELLED);
+		AddFreeBufferObj(pBufferObj);
+	}
+}
+
 int CTcpServer::DoReceive(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
 {
+	if(m_bZeroByteReceive)
+		return DoNotify(pSocketObj, pBufferObj);
+
 	int result		= NO_ERROR;
 	BOOL bNeedFree	= FALSE;
 
@@ -1145,7 +1855,11 @@ int CTcpServer::DoReceive(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
 			pSocketObj->recving	 = TRUE;
 			pBufferObj->buff.len = m_dwSocketBufferSize;
 
+			pSocketObj->BeginIo();
 			result = ::PostReceive(pSocketObj, pBufferObj);
+
+			if(result != NO_ERROR)
+				pSocketObj->EndIo();
 		}
 	}
 
@@ -1160,8 +1874,47 @@ int CTcpServer::DoReceive(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
 	return result;
 }
 
+int CTcpServer::DoNotify(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	AddFreeBufferObj(pBufferObj);
+
+	int result				= NO_ERROR;
+	BOOL bNeedFree			= FALSE;
+	TBufferObj* pNotifyObj	= m_bfNotifyPool.PickFreeItem();
+
+	{
+		CSpinLock locallock(pSocketObj->sgPause);
+
+		if(pSocketObj->paused || pSocketObj->recving)
+			bNeedFree = TRUE;
+		else
+		{
+			pSocketObj->recving	 = TRUE;
+			pNotifyObj->buff.len = 0;
+
+			pSocketObj->BeginIo();
+			result = ::PostReceive(pSocketObj, pNotifyObj);
+
+			if(result != NO_ERROR)
+				pSocketObj->EndIo();
+		}
+	}
+
+	if(result != NO_ERROR)
+	{
+		CheckError(pSocketObj, SO_RECEIVE, result);
+		bNeedFree = TRUE;
+	}
+
+	if(bNeedFree) m_bfNotifyPool.PutFreeItem(pNotifyObj);
+
+	return result;
+}
+
 BOOL CTcpServer::PauseReceive(CONNID dwConnID, BOOL bPause)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TSocketObj::IsValid(pSocketObj))
@@ -1179,7 +1932,7 @@ BOOL CTcpServer::PauseReceive(CONNID dwConnID, BOOL bPause)
 		pSocketObj->paused = bPause;
 	}
 
-	if(!bPause) PostIocpUnpause(m_hCompletePort, dwConnID);
+	if(!bPause) PostIocpUnpause(GetCompletePort(dwConnID), dwConnID);
 
 	return TRUE;
 }
@@ -1199,6 +1952,8 @@ BOOL CTcpServer::Send(CONNID dwConnID, const BYTE* pBuffer, int iLength, int iOf
 
 BOOL CTcpServer::DoSendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
 	ASSERT(pBuffers && iCount > 0);
 
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
@@ -1220,12 +1975,25 @@ BOOL CTcpServer::DoSendPackets(TSocketObj* pSocketObj, const WSABUF pBuffers[],
 
 	if(pBuffers && iCount > 0)
 	{
-		CCriSecLock locallock(pSocketObj->csSend);
-
-		if(TSocketObj::IsValid(pSocketObj))
-			result = SendInternal(pSocketObj, pBuffers, iCount);
+		if(m_bWorkerAffinity)
+			result = SendByOwner(pSocketObj, pBuffers, iCount);
+		else if(m_enSendPolicy != SP_DIRECT)
+		{
+			// SP_PACK / SP_SAFE 策略通过无锁队列发送，无需锁定 csSend
+			if(TSocketObj::IsValid(pSocketObj))
+				result = SendInternal(pSocketObj, pBuffers, iCount);
+			else
+				result = ERROR_OBJECT_NOT_FOUND;
+		}
 		else
-			result = ERROR_OBJECT_NOT_FOUND;
+		{
+			CCriSecLock locallock(pSocketObj->csSend);
+
+			if(TSocketObj::IsValid(pSocketObj))
+				result = SendInternal(pSocketObj, pBuffers, iCount);
+			else
+				result = ERROR_OBJECT_NOT_FOUND;
+		}
 	}
 	else
 		result = ERROR_INVALID_PARAMETER;
@@ -1233,7 +2001,7 @@ BOOL CTcpServer::DoSendPackets(TSocketObj* pSocketObj, const WSABUF pBuffers[],
 	if(result != NO_ERROR)
 	{
 		if(m_enSendPolicy == SP_DIRECT && TSocketObj::IsValid(pSocketObj))
-			::PostIocpClose(m_hCompletePort, pSocketObj->connID, result);
+			::PostIocpClose(GetCompletePort(pSocketObj->connID), pSocketObj->connID, result);
 
 		::SetLastError(result);
 	}
@@ -1241,58 +2009,587 @@ BOOL CTcpServer::DoSendPackets(TSocketObj* pSocketObj, const WSABUF pBuffers[],
 	return (result == NO_ERROR);
 }
 
-int CTcpServer::SendInternal(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+BOOL CTcpServer::SendZeroCopy(CONNID dwConnID, const BYTE* pBuffer, int iLength, Fn_SendBufferRelease fnRelease, PVOID pvArg)
 {
-	int result = NO_ERROR;
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
 
-	for(int i = 0; i < iCount; i++)
+	ASSERT(pBuffer && iLength > 0);
+
+	if(!pBuffer || iLength <= 0)
 	{
-		int iBufLen = pBuffers[i].len;
+		if(fnRelease != nullptr)
+			fnRelease(pBuffer, iLength, pvArg);
 
-		if(iBufLen > 0)
-		{
-			BYTE* pBuffer = (BYTE*)pBuffers[i].buf;
-			ASSERT(pBuffer);
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
 
-			switch(m_enSendPolicy)
-			{
-			case SP_PACK:	result = SendPack(pSocketObj, pBuffer, iBufLen);	break;
-			case SP_SAFE:	result = SendSafe(pSocketObj, pBuffer, iBufLen);	break;
-			case SP_DIRECT:	result = SendDirect(pSocketObj, pBuffer, iBufLen);	break;
-			default: ASSERT(FALSE);	result = ERROR_INVALID_INDEX;				break;
-			}
+	if(!IsZeroCopySendable())
+	{
+		WSABUF buffer;
+		buffer.len = iLength;
+		buffer.buf = (char*)pBuffer;
 
-			if(result != NO_ERROR)
-				break;
-		}
-	}
+		BOOL isOK	= SendPackets(dwConnID, &buffer, 1);
+		int result	= isOK ? NO_ERROR : ::GetLastError();
 
-	return result;
-}
+		if(fnRelease != nullptr)
+			fnRelease(pBuffer, iLength, pvArg);
 
-int CTcpServer::SendPack(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength)
-{
-	return CatAndPost(pSocketObj, pBuffer, iLength);
-}
+		if(!isOK) ::SetLastError(result);
 
-int CTcpServer::SendSafe(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength)
+		return isOK;
+	}
+
+	int result				= NO_ERROR;
+	TSharedBuffer* pShared	= TSharedBuffer::Construct(pBuffer, iLength, fnRelease, pvArg);
+	TSocketObj* pSocketObj	= FindSocketObj(dwConnID);
+
+	if(TSocketObj::IsValid(pSocketObj))
+		result = SendShared(pSocketObj, pShared);
+	else
+		result = ERROR_OBJECT_NOT_FOUND;
+
+	if(result != NO_ERROR && TSocketObj::IsValid(pSocketObj))
+		::PostIocpClose(GetCompletePort(pSocketObj->connID), pSocketObj->connID, result);
+
+	pShared->Release();
+
+	if(result != NO_ERROR)
+		::SetLastError(result);
+
+	return (result == NO_ERROR);
+}
+
+static VOID __HP_CALL FreeSharedCopy(const BYTE* pData, int iLength, PVOID pvArg)
 {
-	return CatAndPost(pSocketObj, pBuffer, iLength);
+	FREE(pData);
 }
 
-int CTcpServer::CatAndPost(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength)
+BOOL CTcpServer::SendToMany(const CONNID pConnIDs[], int iConnCount, const WSABUF pBuffers[], int iCount)
 {
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
+	ASSERT(pConnIDs && iConnCount > 0 && pBuffers && iCount > 0);
+
+	if(!pConnIDs || iConnCount <= 0 || !pBuffers || iCount <= 0)
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
 	int result = NO_ERROR;
 
-	pSocketObj->sndBuff.Cat(pBuffer, iLength);
-	pSocketObj->pending += iLength;
+	if(!IsSharedSendable())
+	{
+		for(int i = 0; i < iConnCount; i++)
+		{
+			if(!SendPackets(pConnIDs[i], pBuffers, iCount))
+				result = ::GetLastError();
+		}
+
+		if(result != NO_ERROR)
+			::SetLastError(result);
+
+		return (result == NO_ERROR);
+	}
+
+	int iLength = 0;
+
+	for(int i = 0; i < iCount; i++)
+		iLength += (int)pBuffers[i].len;
+
+	if(iLength <= 0)
+	{
+		::SetLastError(ERROR_INVALID_PARAMETER);
+		return FALSE;
+	}
+
+	// 数据只复制一次，所有连接共享同一个引用计数缓冲区，最后一个发送完成时释放
+	BYTE* pData = MALLOC(BYTE, iLength);
+
+	if(pData == nullptr)
+	{
+		::SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+		return FALSE;
+	}
+
+	BYTE* pCopy = pData;
+
+	for(int i = 0; i < iCount; i++)
+	{
+		memcpy(pCopy, pBuffers[i].buf, pBuffers[i].len);
+		pCopy += pBuffers[i].len;
+	}
+
+	TSharedBuffer* pShared = TSharedBuffer::Construct(pData, iLength, FreeSharedCopy, nullptr);
+
+	for(int i = 0; i < iConnCount; i++)
+	{
+		int rs					= NO_ERROR;
+		TSocketObj* pSocketObj	= FindSocketObj(pConnIDs[i]);
+
+		if(TSocketObj::IsValid(pSocketObj))
+			rs = SendShared(pSocketObj, pShared);
+		else
+			rs = ERROR_OBJECT_NOT_FOUND;
+
+		if(rs != NO_ERROR)
+		{
+			if(TSocketObj::IsValid(pSocketObj))
+				::PostIocpClose(GetCompletePort(pSocketObj->connID), pSocketObj->connID, rs);
+
+			result = rs;
+		}
+	}
+
+	pShared->Release();
+
+	if(result != NO_ERROR)
+		::SetLastError(result);
+
+	return (result == NO_ERROR);
+}
+
+BOOL CTcpServer::SendToGroup(DWORD dwGroupID, const WSABUF pBuffers[], int iCount)
+{
+	vector<CONNID> members;
+
+	{
+		CReadLock locallock(m_csGroups);
+
+		TConnGroupMapCI it = m_mpGroups.find(dwGroupID);
+
+		if(it == m_mpGroups.end())
+		{
+			::SetLastError(ERROR_OBJECT_NOT_FOUND);
+			return FALSE;
+		}
+
+		// 复制成员快照后释放分组锁，发送期间不阻塞加入 / 退出分组
+		CReadLock locallock2(it->second->cs);
+		members = it->second->members;
+	}
+
+	if(members.empty())
+		return TRUE;
+
+	return SendToMany(&members[0], (int)members.size(), pBuffers, iCount);
+}
+
+int CTcpServer::SendShared(TSocketObj* pSocketObj, TSharedBuffer* pShared)
+{
+	if(m_bWorkerAffinity)
+	{
+		if(!TSocketObj::IsValid(pSocketObj))
+			return ERROR_OBJECT_NOT_FOUND;
+
+		// 非所属工作线程或有待处理邮件时经邮件转交以保持发送顺序，邮件只引用共享缓冲区而不复制数据
+		if(pSocketObj->mails == 0 && IsOwnerThread(pSocketObj->connID))
+			return DoSendShared(pSocketObj, pShared);
 
-	if(pSocketObj->IsCanSend() && pSocketObj->IsSmooth() && !::PostIocpSend(m_hCompletePort, pSocketObj->connID))
-		result = ::GetLastError();
+		TBufferObj* pBufferObj = m_bfObjPool.PickFreeItem();
+		pBufferObj->AttachShared(pShared, 0, pShared->length);
+		pBufferObj->next = nullptr;
+
+		return PostMail(pSocketObj, pBufferObj);
+	}
+
+	if(m_enSendPolicy != SP_DIRECT)
+	{
+		if(!TSocketObj::IsValid(pSocketObj))
+			return ERROR_OBJECT_NOT_FOUND;
+
+		return DoSendShared(pSocketObj, pShared);
+	}
+
+	CCriSecLock locallock(pSocketObj->csSend);
+
+	if(!TSocketObj::IsValid(pSocketObj))
+		return ERROR_OBJECT_NOT_FOUND;
+
+	return DoSendShared(pSocketObj, pShared);
+}
+
+int CTcpServer::DoSendShared(TSocketObj* pSocketObj, TSharedBuffer* pShared)
+{
+	if(m_enSendPolicy != SP_DIRECT)
+		return CatAndPost(pSocketObj, pShared);
+
+	TBufferObj* pBufferObj = m_bfObjPool.PickFreeItem();
+	pBufferObj->AttachShared(pShared, 0, pShared->length);
+
+	return DoSendObj(pSocketObj, pBufferObj);
+}
+
+int CTcpServer::SendObj(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	if(!TSocketObj::IsValid(pSocketObj))
+	{
+		AddFreeBufferObj(pBufferObj);
+		return ERROR_OBJECT_NOT_FOUND;
+	}
+
+	if(m_bWorkerAffinity)
+	{
+		// 非所属工作线程或有待处理邮件时经邮件转交（转交数据块本身，不复制数据）以保持发送顺序
+		if(pSocketObj->mails == 0 && IsOwnerThread(pSocketObj->connID))
+			return DoSendObj(pSocketObj, pBufferObj);
+
+		pBufferObj->next = nullptr;
+
+		return PostMail(pSocketObj, pBufferObj);
+	}
+
+	if(m_enSendPolicy != SP_DIRECT)
+		return DoSendObj(pSocketObj, pBufferObj);
+
+	CCriSecLock locallock(pSocketObj->csSend);
+
+	if(!TSocketObj::IsValid(pSocketObj))
+	{
+		AddFreeBufferObj(pBufferObj);
+		return ERROR_OBJECT_NOT_FOUND;
+	}
+
+	return DoSendObj(pSocketObj, pBufferObj);
+}
+
+int CTcpServer::DoSendObj(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	TFileTransfer* pTransfer = pBufferObj->transfer;
+
+	if(m_enSendPolicy != SP_DIRECT)
+	{
+		// 文件传输数据块按首段长度计入待发送数据，轮到它时由 SendItem() 开始传输
+		if(pTransfer != nullptr)
+			pBufferObj->buff.len = pTransfer->Prepare();
+
+		::InterlockedExchangeAdd(&pSocketObj->pending, (long)pBufferObj->buff.len);
+		CheckSendWatermark(pSocketObj);
+
+		pSocketObj->sndQueue.Push(pBufferObj);
+
+		return PostFlush(pSocketObj);
+	}
+
+	// SP_DIRECT 策略的 pending 为已投递未完成的数据，文件传输数据块在每段投递时计入
+	if(pTransfer == nullptr)
+	{
+		::InterlockedExchangeAdd(&pSocketObj->pending, (long)pBufferObj->buff.len);
+		CheckSendWatermark(pSocketObj);
+	}
+
+	// 文件传输期间的数据排在文件之后，传输完成时由 FlushDirect() 按顺序投递
+	if(pSocketObj->transmit)
+	{
+		pSocketObj->sndBuff.PushBack(pBufferObj);
+		return NO_ERROR;
+	}
+
+	return PostDirect(pSocketObj, pBufferObj);
+}
+
+int CTcpServer::PostDirect(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	if(pBufferObj->transfer != nullptr)
+	{
+		pSocketObj->transmit = TRUE;
+		return DoTransmit(pSocketObj, pBufferObj);
+	}
+
+	int iLength = (int)pBufferObj->buff.len;
+
+	pSocketObj->BeginIo();
+
+	int result		= ::PostSend(pSocketObj, pBufferObj);
+	LONG sndCounter	= pBufferObj->ReleaseSendCounter();
+
+	if(result != NO_ERROR)
+		pSocketObj->EndIo();
+
+	if(sndCounter == 0 || result != NO_ERROR)
+	{
+		AddFreeBufferObj(pBufferObj);
+
+		if(result != NO_ERROR)
+			::InterlockedExchangeAdd(&pSocketObj->pending, -iLength);
+	}
 
 	return result;
 }
 
+int CTcpServer::FlushDirect(TSocketObj* pSocketObj)
+{
+	int result = NO_ERROR;
+	pSocketObj->transmit = FALSE;
+
+	// 遇到下一个文件传输数据块时重新进入传输状态，其后的数据继续等待
+	while(result == NO_ERROR && !pSocketObj->transmit)
+	{
+		TBufferObj* pBufferObj = pSocketObj->sndBuff.PopFront();
+
+		if(pBufferObj == nullptr)
+			break;
+
+		result = PostDirect(pSocketObj, pBufferObj);
+	}
+
+	return result;
+}
+
+int CTcpServer::StartTransmit(TSocketObj* pSocketObj, CAtlFile& file, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail)
+{
+	TBufferObj* pBufferObj	= m_bfObjPool.PickFreeItem();
+	pBufferObj->transfer	= TFileTransfer::Construct(file, ullOffset, ullLength, pHead, pTail);
+
+	return SendObj(pSocketObj, pBufferObj);
+}
+
+int CTcpServer::DoTransmit(TSocketObj* pSocketObj, TBufferObj* pBufferObj)
+{
+	int iLength				= pBufferObj->transfer->Prepare();
+	volatile long& lCounter	= GetTransmitCounter(pSocketObj);
+
+	::InterlockedExchangeAdd(&lCounter, iLength);
+	CheckSendWatermark(pSocketObj);
+
+	// 投递成功后缓冲区随时可能被完成通知回收，不能再访问 pBufferObj
+	pSocketObj->BeginIo();
+
+	int result = ::PostTransmitFile(m_pfnTransmitFile, pSocketObj, pBufferObj);
+
+	if(result != NO_ERROR)
+	{
+		pSocketObj->EndIo();
+		::InterlockedExchangeAdd(&lCounter, -iLength);
+		AddFreeBufferObj(pBufferObj);
+	}
+
+	return result;
+}
+
+int CTcpServer::ReadAndSendFile(CONNID dwConnID, CAtlFile& file, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail)
+{
+	ULONGLONG ullExtra = (pHead ? pHead->len : 0) + (pTail ? pTail->len : 0);
+
+	if(ullLength + ullExtra > MAX_SMALL_FILE_SIZE)
+		return ERROR_FILE_TOO_LARGE;
+
+	WSABUF szBuf[3];
+	CBufferPtr buffer((size_t)ullLength);
+
+	if(ullLength > 0)
+	{
+		DWORD dwRead = 0;
+		HRESULT hr	 = file.Seek((LONGLONG)ullOffset, FILE_BEGIN);
+
+		if(SUCCEEDED(hr))
+			hr = file.Read(buffer.Ptr(), (DWORD)ullLength, dwRead);
+
+		if(FAILED(hr))
+			return HRESULT_CODE(hr);
+		if(dwRead != (DWORD)ullLength)
+			return ERROR_HANDLE_EOF;
+	}
+
+	szBuf[1].len = (ULONG)buffer.Size();
+	szBuf[1].buf = (char*)buffer.Ptr();
+
+	if(pHead) memcpy(&szBuf[0], pHead, sizeof(WSABUF));
+	else	  memset(&szBuf[0], 0, sizeof(WSABUF));
+
+	if(pTail) memcpy(&szBuf[2], pTail, sizeof(WSABUF));
+	else	  memset(&szBuf[2], 0, sizeof(WSABUF));
+
+	if(!SendPackets(dwConnID, szBuf, 3))
+		return ::GetLastError();
+
+	return NO_ERROR;
+}
+
+int CTcpServer::SendInternal(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	switch(m_enSendPolicy)
+	{
+	case SP_PACK:
+	case SP_SAFE:	return CatAndPost(pSocketObj, pBuffers, iCount);
+	case SP_DIRECT:	break;
+	default:		ASSERT(FALSE); return ERROR_INVALID_INDEX;
+	}
+
+	int result = NO_ERROR;
+
+	for(int i = 0; i < iCount; i++)
+	{
+		int iBufLen = pBuffers[i].len;
+
+		if(iBufLen > 0)
+		{
+			BYTE* pBuffer = (BYTE*)pBuffers[i].buf;
+			ASSERT(pBuffer);
+
+			result = SendDirect(pSocketObj, pBuffer, iBufLen);
+
+			if(result != NO_ERROR)
+				break;
+		}
+	}
+
+	return result;
+}
+
+int CTcpServer::SendByOwner(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	if(!TSocketObj::IsValid(pSocketObj))
+		return ERROR_OBJECT_NOT_FOUND;
+
+	// 所属工作线程在没有待处理邮件时直接发送，否则经邮件转交以保持发送顺序
+	if(pSocketObj->mails == 0 && IsOwnerThread(pSocketObj->connID))
+		return SendInternal(pSocketObj, pBuffers, iCount);
+
+	return SendMail(pSocketObj, pBuffers, iCount);
+}
+
+int CTcpServer::SendMail(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	TBufferObjList lsMail(m_bfObjPool);
+
+	for(int i = 0; i < iCount; i++)
+	{
+		if(pBuffers[i].len > 0)
+			lsMail.Cat((const BYTE*)pBuffers[i].buf, (int)pBuffers[i].len);
+	}
+
+	if(lsMail.IsEmpty())
+		return NO_ERROR;
+
+	TBufferObj* pHead = nullptr;
+	TBufferObj* pTail = nullptr;
+	TBufferObj* pItem;
+
+	while((pItem = lsMail.PopFront()) != nullptr)
+	{
+		if(pTail != nullptr)
+			pTail->next = pItem;
+		else
+			pHead = pItem;
+
+		pTail = pItem;
+	}
+
+	return PostMail(pSocketObj, pHead);
+}
+
+int CTcpServer::PostMail(TSocketObj* pSocketObj, TBufferObj* pHead)
+{
+	TBufferObj* pItem;
+	CONNID dwConnID = pSocketObj->connID;
+	::InterlockedIncrement(&pSocketObj->mails);
+
+	if(::PostIocpMail(GetCompletePort(dwConnID), dwConnID, pHead))
+		return NO_ERROR;
+
+	int result = ::GetLastError();
+	::InterlockedDecrement(&pSocketObj->mails);
+
+	while((pItem = pHead) != nullptr)
+	{
+		pHead = pItem->next;
+		AddFreeBufferObj(pItem);
+	}
+
+	return result;
+}
+
+int CTcpServer::CatAndPost(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount)
+{
+	int iLength = pSocketObj->sndQueue.Cat(pBuffers, iCount);
+
+	if(iLength == 0)
+		return NO_ERROR;
+
+	::InterlockedExchangeAdd(&pSocketObj->pending, iLength);
+	CheckSendWatermark(pSocketObj);
+
+	return PostFlush(pSocketObj);
+}
+
+int CTcpServer::CatAndPost(TSocketObj* pSocketObj, TSharedBuffer* pShared)
+{
+	int iLength = pSocketObj->sndQueue.Cat(pShared, (int)m_dwSocketBufferSize);
+
+	::InterlockedExchangeAdd(&pSocketObj->pending, iLength);
+	CheckSendWatermark(pSocketObj);
+
+	return PostFlush(pSocketObj);
+}
+
+int CTcpServer::PostFlush(TSocketObj* pSocketObj)
+{
+	// 只有把连接从空闲切换为待发送状态的线程投递发送指令，其余线程的数据由该指令一并发送
+	if(pSocketObj->sndQueue.IsEmpty() || pSocketObj->transmit || !pSocketObj->IsSmooth() || !pSocketObj->IsCanSend() || !pSocketObj->MarkFlush())
+		return NO_ERROR;
+
+	if(::PostIocpSend(GetCompletePort(pSocketObj->connID), pSocketObj->connID))
+		return NO_ERROR;
+
+	pSocketObj->UnmarkFlush();
+
+	return ::GetLastError();
+}
+
+void CTcpServer::CheckSendWatermark(TSocketObj* pSocketObj)
+{
+	if(m_dwSendHighWatermark == 0 || !IsSendWatermarkCrossed(pSocketObj) || !pSocketObj->EnterSendMark())
+		return;
+
+	// 调用方可能持有 csSend，水位通知转交连接所属的工作线程在锁外触发
+	if(!::PostIocpWatermark(GetCompletePort(pSocketObj->connID), pSocketObj->connID))
+		pSocketObj->ClearSendMark();
+}
+
+BOOL CTcpServer::IsSendWatermarkCrossed(TSocketObj* pSocketObj)
+{
+	// pending 为尚未投递（SP_DIRECT 为尚未完成）的数据，sndCount 为已投递未完成的数据
+	long lBacklog = pSocketObj->pending + pSocketObj->sndCount;
+
+	if(pSocketObj->sndHigh)
+		return lBacklog <= (long)m_dwSendLowWatermark;
+	else
+		return lBacklog >= (long)m_dwSendHighWatermark;
+}
+
+void CTcpServer::DoSendWatermark(CONNID dwConnID)
+{
+	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
+
+	if(!TSocketObj::IsValid(pSocketObj))
+		return;
+
+	// 水位状态转换与 OnSendWatermark 通知由同一线程串行完成，期间其它线程的检查请求在此循环中补做，
+	// 保证通知高低交替、按序到达，且最终状态与最后一次检查时的待发送数据一致
+	do
+	{
+		pSocketObj->RenewSendMark();
+
+		if(!TSocketObj::IsValid(pSocketObj) || !IsSendWatermarkCrossed(pSocketObj))
+			continue;
+
+		long lBacklog		= pSocketObj->pending + pSocketObj->sndCount;
+		BOOL bHigh			= !pSocketObj->sndHigh;
+		pSocketObj->sndHigh	= bHigh;
+
+		EnHandleResult rs = FireSendWatermark(pSocketObj, bHigh, (int)lBacklog);
+
+		if(rs == HR_ERROR)
+		{
+			TRACE("<S-CNNID: %Iu> OnSendWatermark() event should not return 'HR_ERROR' !!\n", pSocketObj->connID);
+			ASSERT(FALSE);
+		}
+	} while(!pSocketObj->LeaveSendMark());
+}
+
 int CTcpServer::SendDirect(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength)
 {
 	int result	= NO_ERROR;
@@ -1304,22 +2601,10 @@ int CTcpServer::SendDirect(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLen
 		TBufferObj* pBufferObj = GetFreeBufferObj(iBufferSize);
 		memcpy(pBufferObj->buff.buf, pBuffer, iBufferSize);
 
-		::InterlockedExchangeAdd(&pSocketObj->pending, iBufferSize);
-
-		result			= ::PostSend(pSocketObj, pBufferObj);
-		LONG sndCounter	= pBufferObj->ReleaseSendCounter();
-
-		if(sndCounter == 0 || result != NO_ERROR)
-		{
-			AddFreeBufferObj(pBufferObj);
-			
-			if(result != NO_ERROR)
-			{
-				::InterlockedExchangeAdd(&pSocketObj->pending, -iBufferSize);
+		result = DoSendObj(pSocketObj, pBufferObj);
 
-				break;
-			}
-		}
+		if(result != NO_ERROR)
+			break;
 
 		iRemain -= iBufferSize;
 		pBuffer += iBufferSize;
@@ -1332,10 +2617,12 @@ int CTcpServer::DoSend(CONNID dwConnID)
 {
 	TSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
-	if(TSocketObj::IsValid(pSocketObj))
-		return DoSend(pSocketObj);
+	if(!TSocketObj::IsValid(pSocketObj))
+		return ERROR_OBJECT_NOT_FOUND;
 
-	return ERROR_OBJECT_NOT_FOUND;
+	pSocketObj->UnmarkFlush();
+
+	return DoSend(pSocketObj);
 }
 
 int CTcpServer::DoSend(TSocketObj* pSocketObj)
@@ -1358,7 +2645,7 @@ int CTcpServer::DoSendPack(TSocketObj* pSocketObj)
 	if(pSocketObj->IsPending() && pSocketObj->TurnOffSmooth())
 	{
 		{
-			CCriSecLock locallock(pSocketObj->csSend);
+			CCriSecCondLock locallock(pSocketObj->csSend, !m_bWorkerAffinity);
 
 			if(!TSocketObj::IsValid(pSocketObj))
 				return ERROR_OBJECT_NOT_FOUND;
@@ -1369,8 +2656,9 @@ int CTcpServer::DoSendPack(TSocketObj* pSocketObj)
 			pSocketObj->TurnOnSmooth();
 		}
 
-		if(result == WSA_IO_PENDING && pSocketObj->IsSmooth())
-			::PostIocpSend(m_hCompletePort, pSocketObj->connID);
+		// 发送期间入队的数据可能未触发发送指令
+		if(IOCP_SUCCESS(result))
+			result = PostFlush(pSocketObj);
 	}
 
 	if(!IOCP_SUCCESS(result))
@@ -1385,7 +2673,7 @@ int CTcpServer::DoSendSafe(TSocketObj* pSocketObj)
 
 	if(pSocketObj->sndCount < lSendBuffSize && !pSocketObj->IsSmooth())
 	{
-		CCriSecLock locallock(pSocketObj->csSend);
+		CCriSecCondLock locallock(pSocketObj->csSend, !m_bWorkerAffinity);
 
 		if(!TSocketObj::IsValid(pSocketObj))
 			return ERROR_OBJECT_NOT_FOUND;
@@ -1398,7 +2686,7 @@ int CTcpServer::DoSendSafe(TSocketObj* pSocketObj)
 
 	if(pSocketObj->IsPending() && pSocketObj->IsSmooth())
 	{
-		CCriSecLock locallock(pSocketObj->csSend);
+		CCriSecCondLock locallock(pSocketObj->csSend, !m_bWorkerAffinity);
 
 		if(!TSocketObj::IsValid(pSocketObj))
 			return ERROR_OBJECT_NOT_FOUND;
@@ -1410,10 +2698,13 @@ int CTcpServer::DoSendSafe(TSocketObj* pSocketObj)
 			result = SendItem(pSocketObj);
 
 			if(result == NO_ERROR)
-				pSocketObj->smooth = TRUE;
+				pSocketObj->TurnOnSmooth();
 		}
 	}
 
+	if(result == NO_ERROR)
+		result = PostFlush(pSocketObj);
+
 	if(!IOCP_SUCCESS(result))
 		CheckError(pSocketObj, SO_SEND, result);
 
@@ -1422,21 +2713,41 @@ int CTcpServer::DoSendSafe(TSocketObj* pSocketObj)
 
 int CTcpServer::SendItem(TSocketObj* pSocketObj)
 {
+	// 文件传输期间暂停发送，排在其后的数据在传输完成后继续发送
+	if(pSocketObj->transmit)
+		return NO_ERROR;
+
 	int result = NO_ERROR;
 
+	pSocketObj->sndQueue.PopAll(pSocketObj->sndBuff);
+
 	while(pSocketObj->sndBuff.Size() > 0)
 	{
 		TBufferObj* pBufferObj	= pSocketObj->sndBuff.PopFront();
 		int iBufferSize			= pBufferObj->buff.len;
 
+		::InterlockedExchangeAdd(&pSocketObj->pending, -iBufferSize);
+
+		if(pBufferObj->transfer != nullptr)
+		{
+			pSocketObj->transmit = TRUE;
+			result = DoTransmit(pSocketObj, pBufferObj);
+
+			break;
+		}
+
 		ASSERT(iBufferSize > 0 && iBufferSize <= (int)m_dwSocketBufferSize);
 
-		pSocketObj->pending	   -= iBufferSize;
 		::InterlockedExchangeAdd(&pSocketObj->sndCount, iBufferSize);
 
+		pSocketObj->BeginIo();
+
 		result			= ::PostSendNotCheck(pSocketObj, pBufferObj);
 		LONG sndCounter	= pBufferObj->ReleaseSendCounter();
 
+		if(!IOCP_SUCCESS(result))
+			pSocketObj->EndIo();
+
 		if(sndCounter == 0 || !IOCP_SUCCESS(result))
 			AddFreeBufferObj(pBufferObj);
 
@@ -1464,6 +2775,69 @@ BOOL CTcpServer::SendSmallFile(CONNID dwConnID, LPCTSTR lpszFileName, const LPWS
 	return SendPackets(dwConnID, szBuf, 3);
 }
 
+BOOL CTcpServer::SendFile(CONNID dwConnID, LPCTSTR lpszFileName, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail)
+{
+	ASSERT(lpszFileName != nullptr);
+
+	CAtlFile file;
+	HRESULT hr = file.Create(lpszFileName, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN);
+
+	if(FAILED(hr))
+	{
+		::SetLastError(HRESULT_CODE(hr));
+		return FALSE;
+	}
+
+	return DoSendFile(dwConnID, file, ullOffset, ullLength, pHead, pTail);
+}
+
+BOOL CTcpServer::DoSendFile(CONNID dwConnID, CAtlFile& file, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail)
+{
+	CEpochLock epochlock(m_gcSocket.GetEpoch());
+
+	int result = NO_ERROR;
+	ULONGLONG ullSize;
+
+	HRESULT hr = file.GetSize(ullSize);
+
+	if(FAILED(hr))
+		result = HRESULT_CODE(hr);
+	else if(ullOffset > ullSize)
+		result = ERROR_INVALID_PARAMETER;
+	else
+	{
+		if(ullLength == 0)
+			ullLength = ullSize - ullOffset;
+
+		if(ullLength > ullSize - ullOffset)
+			result = ERROR_INVALID_PARAMETER;
+		else if(ullLength == 0 && (pHead == nullptr || pHead->len == 0) && (pTail == nullptr || pTail->len == 0))
+			result = ERROR_FILE_INVALID;
+	}
+
+	if(result == NO_ERROR)
+	{
+		TSocketObj* pSocketObj = FindSocketObj(dwConnID);
+
+		if(!TSocketObj::IsValid(pSocketObj))
+			result = ERROR_OBJECT_NOT_FOUND;
+		else if(!IsTransmitSendable())
+			result = ReadAndSendFile(dwConnID, file, ullOffset, ullLength, pHead, pTail);
+		else
+		{
+			result = StartTransmit(pSocketObj, file, ullOffset, ullLength, pHead, pTail);
+
+			if(result != NO_ERROR && m_enSendPolicy == SP_DIRECT && TSocketObj::IsValid(pSocketObj))
+				::PostIocpClose(GetCompletePort(dwConnID), dwConnID, result);
+		}
+	}
+
+	if(result != NO_ERROR)
+		::SetLastError(result);
+
+	return (result == NO_ERROR);
+}
+
 void CTcpServer::CheckError(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
 {
 	if(iErrorCode != WSAENOTSOCK && iErrorCode != ERROR_OPERATION_ABORTED)
@@ -36,7 +36,11 @@ public:
 	virtual BOOL Stop	();
 	virtual BOOL Send	(CONNID dwConnID, const BYTE* pBuffer, int iLength, int iOffset = 0);
 	virtual BOOL SendSmallFile	(CONNID dwConnID, LPCTSTR lpszFileName, const LPWSABUF pHead = nullptr, const LPWSABUF pTail = nullptr);
+	virtual BOOL SendFile		(CONNID dwConnID, LPCTSTR lpszFileName, ULONGLONG ullOffset = 0, ULONGLONG ullLength = 0, const LPWSABUF pHead = nullptr, const LPWSABUF pTail = nullptr);
 	virtual BOOL SendPackets	(CONNID dwConnID, const WSABUF pBuffers[], int iCount)	{return DoSendPackets(dwConnID, pBuffers, iCount);}
+	virtual BOOL SendZeroCopy	(CONNID dwConnID, const BYTE* pBuffer, int iLength, Fn_SendBufferRelease fnRelease, PVOID pvArg = nullptr);
+	virtual BOOL SendToMany		(const CONNID pConnIDs[], int iConnCount, const WSABUF pBuffers[], int iCount);
+	virtual BOOL SendToGroup	(DWORD dwGroupID, const WSABUF pBuffers[], int iCount);
 	virtual BOOL PauseReceive	(CONNID dwConnID, BOOL bPause = TRUE);
 	virtual BOOL Wait			(DWORD dwMilliseconds = INFINITE) {return m_evWait.Wait(dwMilliseconds);}
 	virtual BOOL			HasStarted					()	{return m_enState == SS_STARTED || m_enState == SS_STARTING;}
@@ -55,6 +59,13 @@ public:
 	virtual BOOL GetAllConnectionIDs	(CONNID pIDs[], DWORD& dwCount);
 	virtual BOOL GetConnectPeriod		(CONNID dwConnID, DWORD& dwPeriod);
 	virtual BOOL GetSilencePeriod		(CONNID dwConnID, DWORD& dwPeriod);
+
+	virtual DWORD CreateGroup			();
+	virtual BOOL DestroyGroup			(DWORD dwGroupID);
+	virtual BOOL JoinGroup				(DWORD dwGroupID, CONNID dwConnID);
+	virtual BOOL LeaveGroup				(DWORD dwGroupID, CONNID dwConnID);
+	virtual DWORD GetGroupMemberCount	(DWORD dwGroupID);
+	virtual BOOL GetGroupMemberIDs		(DWORD dwGroupID, CONNID pIDs[], DWORD& dwCount);
 	virtual EnSocketError GetLastError	()	{return m_enLastError;}
 	virtual LPCTSTR	GetLastErrorDesc	()	{return ::GetSocketErrorDesc(m_enLastError);}
 
@@ -99,6 +110,14 @@ public:
 	virtual void SetKeepAliveTime			(DWORD dwKeepAliveTime)			{ENSURE_HAS_STOPPED(); m_dwKeepAliveTime			= dwKeepAliveTime;}
 	virtual void SetKeepAliveInterval		(DWORD dwKeepAliveInterval)		{ENSURE_HAS_STOPPED(); m_dwKeepAliveInterval		= dwKeepAliveInterval;}
 	virtual void SetMarkSilence				(BOOL bMarkSilence)				{ENSURE_HAS_STOPPED(); m_bMarkSilence				= bMarkSilence;}
+	virtual void SetZeroByteReceive			(BOOL bZeroByteReceive)			{ENSURE_HAS_STOPPED(); m_bZeroByteReceive			= bZeroByteReceive;}
+	virtual void SetWorkerAffinity			(BOOL bWorkerAffinity)			{ENSURE_HAS_STOPPED(); m_bWorkerAffinity			= bWorkerAffinity;}
+	virtual void SetSilenceTimeout			(DWORD dwSilenceTimeout)		{ENSURE_HAS_STOPPED(); m_dwSilenceTimeout			= dwSilenceTimeout;}
+	virtual void SetMaxLifetime				(DWORD dwMaxLifetime)			{ENSURE_HAS_STOPPED(); m_dwMaxLifetime				= dwMaxLifetime;}
+	virtual void SetSendHighWatermark		(DWORD dwSendHighWatermark)		{ENSURE_HAS_STOPPED(); m_dwSendHighWatermark		= dwSendHighWatermark;}
+	virtual void SetSendLowWatermark		(DWORD dwSendLowWatermark)		{ENSURE_HAS_STOPPED(); m_dwSendLowWatermark			= dwSendLowWatermark;}
+	virtual void SetFreeBufferObjLocalHigh	(DWORD dwFreeBufferObjLocalHigh){ENSURE_HAS_STOPPED(); m_dwFreeBufferObjLocalHigh	= dwFreeBufferObjLocalHigh;}
+	virtual void SetFreeBufferObjLocalLow	(DWORD dwFreeBufferObjLocalLow)	{ENSURE_HAS_STOPPED(); m_dwFreeBufferObjLocalLow	= dwFreeBufferObjLocalLow;}
 
 	virtual EnReuseAddressPolicy GetReuseAddressPolicy	()	{return m_enReusePolicy;}
 	virtual EnSendPolicy GetSendPolicy					()	{return m_enSendPolicy;}
@@ -116,6 +135,17 @@ public:
 	virtual DWORD GetKeepAliveTime			()	{return m_dwKeepAliveTime;}
 	virtual DWORD GetKeepAliveInterval		()	{return m_dwKeepAliveInterval;}
 	virtual BOOL  IsMarkSilence				()	{return m_bMarkSilence;}
+	virtual BOOL  IsZeroByteReceive			()	{return m_bZeroByteReceive;}
+	virtual BOOL  IsWorkerAffinity			()	{return m_bWorkerAffinity;}
+	virtual DWORD GetSilenceTimeout			()	{return m_dwSilenceTimeout;}
+	virtual DWORD GetMaxLifetime			()	{return m_dwMaxLifetime;}
+	virtual DWORD GetSendHighWatermark		()	{return m_dwSendHighWatermark;}
+	virtual DWORD GetSendLowWatermark		()	{return m_dwSendLowWatermark;}
+	virtual DWORD GetFreeBufferObjLocalHigh	()	{return m_dwFreeBufferObjLocalHigh;}
+	virtual DWORD GetFreeBufferObjLocalLow	()	{return m_dwFreeBufferObjLocalLow;}
+	virtual void GetFreeBufferObjLocalStat	(ULONGLONG& ullHits, ULONGLONG& ullMisses)	{m_bfObjPool.GetLocalCacheStat(ullHits, ullMisses);}
+	virtual BOOL GetHeapClassStat			(DWORD dwClass, THeapClassStat& stat);
+	virtual BOOL GetHeapLargeStat			(SIZE_T& dwCount, SIZE_T& dwBytes);
 
 protected:
 	virtual EnHandleResult FirePrepareListen(SOCKET soListen)
@@ -134,6 +164,8 @@ protected:
 		{return DoFireReceive(pSocketObj, iLength);}
 	virtual EnHandleResult FireSend(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return DoFireSend(pSocketObj, pData, iLength);}
+	virtual EnHandleResult FireSendWatermark(TSocketObj* pSocketObj, BOOL bHigh, int iPending)
+		{return DoFireSendWatermark(pSocketObj, bHigh, iPending);}
 	virtual EnHandleResult FireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
 		{return DoFireClose(pSocketObj, enOperation, iErrorCode);}
 	virtual EnHandleResult FireShutdown()
@@ -151,6 +183,8 @@ protected:
 		{return m_pListener->OnReceive(this, pSocketObj->connID, iLength);}
 	virtual EnHandleResult DoFireSend(TSocketObj* pSocketObj, const BYTE* pData, int iLength)
 		{return m_pListener->OnSend(this, pSocketObj->connID, pData, iLength);}
+	virtual EnHandleResult DoFireSendWatermark(TSocketObj* pSocketObj, BOOL bHigh, int iPending)
+		{return m_pListener->OnSendWatermark(this, pSocketObj->connID, bHigh, iPending);}
 	virtual EnHandleResult DoFireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode)
 		{return m_pListener->OnClose(this, pSocketObj->connID, enOperation, iErrorCode);}
 	virtual EnHandleResult DoFireShutdown()
@@ -163,17 +197,24 @@ protected:
 
 	virtual EnHandleResult BeforeUnpause(TSocketObj* pSocketObj) {return HR_IGNORE;}
 
+	virtual BOOL IsZeroCopySendable() {return m_enSendPolicy == SP_DIRECT;}
+	virtual BOOL IsSharedSendable	() {return TRUE;}
+	virtual BOOL IsTransmitSendable	() {return TRUE;}
+
 	virtual void OnWorkerThreadStart(THR_ID dwThreadID) {}
 	virtual void OnWorkerThreadEnd(THR_ID dwThreadID) {}
 
 	BOOL DoSendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iCount);
 	BOOL DoSendPackets(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+	BOOL DoSendFile(CONNID dwConnID, CAtlFile& file, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail);
 	TSocketObj* FindSocketObj(CONNID dwConnID);
+	CEpoch& GetSocketEpoch() {return m_gcSocket.GetEpoch();}
 
 private:
 	EnHandleResult TriggerFireAccept(TSocketObj* pSocketObj);
 	EnHandleResult TriggerFireReceive(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 	EnHandleResult TriggerFireSend(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	EnHandleResult TriggerFireSend(TSocketObj* pSocketObj, const BYTE* pData, int iLength);
 	EnHandleResult TriggerFireClose(TSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode);
 
 protected:
@@ -213,6 +254,8 @@ private:
 	TSocketObj*	CreateSocketObj();
 	void		DeleteSocketObj(TSocketObj* pSocketObj);
 	BOOL		InvalidSocketObj(TSocketObj* pSocketObj);
+	void		LeaveAllGroups(TSocketObj* pSocketObj);
+	void		ReleaseGroups();
 	void		ReleaseGCSocketObj(BOOL bForce = FALSE);
 
 	void		AddClientSocketObj(CONNID dwConnID, TSocketObj* pSocketObj, const HP_SOCKADDR& remoteAddr);
@@ -222,25 +265,61 @@ private:
 	friend BOOL ContinueReceive<>(CTcpServer* pThis, TSocketObj* pSocketObj, TBufferObj* pBufferObj, EnHandleResult& hr);
 
 	static UINT WINAPI WorkerThreadProc(LPVOID pv);
+	static void WINAPI EvictTimerProc(LPVOID pv, BOOLEAN bTimerFired);
+	static DWORD EvictConnectionProc(TTimerNode* pNode, PVOID pv);
 
+	EnIocpAction DispatchCompletion(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey, BOOL result, DWORD dwSysCode);
 	EnIocpAction CheckIocpCommand(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey);
 
 	void ForceDisconnect(CONNID dwConnID);
 	void HandleIo		(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj, DWORD dwBytes, DWORD dwErrorCode);
 	void HandleError	(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj, DWORD dwErrorCode);
 	void HandleAccept	(SOCKET soListen, TBufferObj* pBufferObj);
+	void HandleAccepted	(CONNID dwConnID, TBufferObj* pBufferObj);
+	void AcceptClient	(CONNID dwConnID, SOCKET soListen, TBufferObj* pBufferObj);
 	void HandleSend		(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	void HandleTransmit	(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 	void HandleReceive	(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	void HandleNotify	(CONNID dwConnID, TSocketObj* pSocketObj, TBufferObj* pNotifyObj);
+	void HandleMail		(CONNID dwConnID, TBufferObj* pBufferObj);
+
+	HANDLE AttachWorkerThread();
+	HANDLE GetCompletePort	(CONNID dwConnID);
+	BOOL IsOwnerThread		(CONNID dwConnID);
+
+	BOOL IsNeedEvictConnection	()	{return m_dwMaxLifetime > 0 || (m_dwSilenceTimeout > 0 && m_bMarkSilence);}
+	DWORD GetEvictDelay			(TSocketObj* pSocketObj, DWORD dwCurrent);
 
 	int SendInternal(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
-	int SendPack	(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength);
-	int SendSafe	(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength);
-	int CatAndPost	(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength);
+	int SendByOwner	(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+	int SendMail	(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+	int PostMail	(TSocketObj* pSocketObj, TBufferObj* pHead);
+	int CatAndPost	(TSocketObj* pSocketObj, const WSABUF pBuffers[], int iCount);
+	int CatAndPost	(TSocketObj* pSocketObj, TSharedBuffer* pShared);
+	int PostFlush	(TSocketObj* pSocketObj);
+	void CheckSendWatermark(TSocketObj* pSocketObj);
+	void DoSendWatermark(CONNID dwConnID);
+	BOOL IsSendWatermarkCrossed(TSocketObj* pSocketObj);
 	int SendDirect	(TSocketObj* pSocketObj, const BYTE* pBuffer, int iLength);
+	int SendShared	(TSocketObj* pSocketObj, TSharedBuffer* pShared);
+	int DoSendShared(TSocketObj* pSocketObj, TSharedBuffer* pShared);
+	int SendObj		(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	int DoSendObj	(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	int PostDirect	(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	int FlushDirect	(TSocketObj* pSocketObj);
+
+	int StartTransmit	(TSocketObj* pSocketObj, CAtlFile& file, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail);
+	int DoTransmit		(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	int ReadAndSendFile	(CONNID dwConnID, CAtlFile& file, ULONGLONG ullOffset, ULONGLONG ullLength, const LPWSABUF pHead, const LPWSABUF pTail);
+
+	/* 文件传输已投递未完成的数据：SP_DIRECT 策略计入 pending，其它策略计入 sndCount */
+	volatile long& GetTransmitCounter(TSocketObj* pSocketObj)
+		{return (m_enSendPolicy == SP_DIRECT) ? pSocketObj->pending : pSocketObj->sndCount;}
 
 	BOOL DoAccept	();
 	int DoUnpause	(CONNID dwConnID);
 	int DoReceive	(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
+	int DoNotify	(TSocketObj* pSocketObj, TBufferObj* pBufferObj);
 	int DoSend		(CONNID dwConnID);
 	int DoSend		(TSocketObj* pSocketObj);
 	int DoSendPack	(TSocketObj* pSocketObj);
@@ -255,9 +334,12 @@ public:
 	, m_hCompletePort			(nullptr)
 	, m_soListen				(INVALID_SOCKET)
 	, m_iRemainAcceptSockets	(0)
+	, m_iWorkerIndex			(0)
+	, m_lGroupID				(0)
 	, m_pfnAcceptEx				(nullptr)
 	, m_pfnGetAcceptExSockaddrs	(nullptr)
 	, m_pfnDisconnectEx			(nullptr)
+	, m_pfnTransmitFile			(nullptr)
 	, m_enLastError				(SE_OK)
 	, m_enState					(SS_STOPPED)
 	, m_usFamily				(AF_UNSPEC)
@@ -277,6 +359,14 @@ public:
 	, m_dwKeepAliveTime			(DEFALUT_TCP_KEEPALIVE_TIME)
 	, m_dwKeepAliveInterval		(DEFALUT_TCP_KEEPALIVE_INTERVAL)
 	, m_bMarkSilence			(TRUE)
+	, m_bZeroByteReceive		(FALSE)
+	, m_bWorkerAffinity			(FALSE)
+	, m_dwSilenceTimeout		(0)
+	, m_dwMaxLifetime			(0)
+	, m_dwSendHighWatermark		(0)
+	, m_dwSendLowWatermark		(0)
+	, m_dwFreeBufferObjLocalHigh(DEFAULT_BUFFER_CACHE_LOCAL_HIGH)
+	, m_dwFreeBufferObjLocalLow	(DEFAULT_BUFFER_CACHE_LOCAL_LOW)
 	, m_evWait					(TRUE, TRUE)
 	{
 		ASSERT(sm_wsSocket.IsValid());
@@ -305,6 +395,14 @@ private:
 	DWORD m_dwKeepAliveTime;
 	DWORD m_dwKeepAliveInterval;
 	BOOL  m_bMarkSilence;
+	BOOL  m_bZeroByteReceive;
+	BOOL  m_bWorkerAffinity;
+	DWORD m_dwSilenceTimeout;
+	DWORD m_dwMaxLifetime;
+	DWORD m_dwSendHighWatermark;
+	DWORD m_dwSendLowWatermark;
+	DWORD m_dwFreeBufferObjLocalHigh;
+	DWORD m_dwFreeBufferObjLocalLow;
 
 private:
 	static const CInitSocket	sm_wsSocket;
@@ -314,6 +412,7 @@ private:
 	LPFN_ACCEPTEX				m_pfnAcceptEx;
 	LPFN_GETACCEPTEXSOCKADDRS	m_pfnGetAcceptExSockaddrs;
 	LPFN_DISCONNECTEX			m_pfnDisconnectEx;
+	LPFN_TRANSMITFILE			m_pfnTransmitFile;
 
 	ADDRESS_FAMILY				m_usFamily;
 
@@ -325,16 +424,27 @@ private:
 	EnSocketError		m_enLastError;
 
 	vector<HANDLE>		m_vtWorkerThreads;
+	vector<HANDLE>		m_vtCompletePorts;
+	vector<THR_ID>		m_vtWorkerThreadIDs;
 
 	CPrivateHeap		m_phSocket;
 	CBufferObjPool		m_bfObjPool;
+	CBufferObjPool		m_bfNotifyPool;
 
 	CSpinGuard			m_csState;
 
+	CTimerQueue			m_tqEvict;
+	CTimingWheel		m_twEvict;
+
 	TSocketObjPtrPool	m_bfActiveSockets;
 
+	CSimpleRWLock		m_csGroups;
+	TConnGroupMap		m_mpGroups;
+
 	TSocketObjPtrList	m_lsFreeSocket;
-	TSocketObjPtrQueue	m_lsGCSocket;
+	TSocketObjPtrGC		m_gcSocket;
 
 	volatile long		m_iRemainAcceptSockets;
+	volatile long		m_iWorkerIndex;
+	volatile long		m_lGroupID;
 };
@@ -63,6 +63,8 @@ public:
 	virtual void SetMaxTransUnit		(DWORD dwMaxTransUnit)		{ENSURE_HAS_STOPPED(); m_dwMtu						= dwMaxTransUnit;}
 	virtual void SetMaxMessageSize		(DWORD dwMaxMessageSize)	{ENSURE_HAS_STOPPED(); m_arqAttr.dwMaxMessageSize	= dwMaxMessageSize;}
 	virtual void SetHandShakeTimeout	(DWORD dwHandShakeTimeout)	{ENSURE_HAS_STOPPED(); m_arqAttr.dwHandShakeTimeout	= dwHandShakeTimeout;}
+	virtual void SetFecDataShards		(DWORD dwDataShards)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFecDataShards	= dwDataShards;}
+	virtual void SetFecParityShards		(DWORD dwParityShards)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFecParityShards	= dwParityShards;}
 
 	virtual BOOL IsNoDelay				()	{return m_arqAttr.bNoDelay;}
 	virtual BOOL IsTurnoffCongestCtrl	()	{return m_arqAttr.bTurnoffNc;}
@@ -75,12 +77,15 @@ public:
 	virtual DWORD GetMaxTransUnit		()	{return m_arqAttr.dwMtu;}
 	virtual DWORD GetMaxMessageSize		()	{return m_arqAttr.dwMaxMessageSize;}
 	virtual DWORD GetHandShakeTimeout	()	{return m_arqAttr.dwHandShakeTimeout;}
+	virtual DWORD GetFecDataShards		()	{return m_arqAttr.dwFecDataShards;}
+	virtual DWORD GetFecParityShards	()	{return m_arqAttr.dwFecParityShards;}
 
 	virtual BOOL GetWaitingSendMessageCount	(int& iCount);
 
 public:
 	const TArqAttr& GetArqAttribute		()	{return m_arqAttr;}
 	Fn_ArqOutputProc GetArqOutputProc	()	{return ArqOutputProc;}
+	CArqSegmentPool* GetArqSegmentPool	()	{return nullptr;}
 
 private:
 	static int ArqOutputProc(const char* pBuffer, int iLength, IKCPCB* kcp, LPVOID pv);
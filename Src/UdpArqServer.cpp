@@ -42,9 +42,32 @@ BOOL CUdpArqServer::CheckParams()
 		m_arqAttr.dwMtu = m_dwMtu;
 	}
 
+	m_arqAttr.bSegmentOffload = m_bSegmentOffload;
+
 	return __super::CheckParams() && m_arqAttr.IsValid();
 }
 
+DWORD CUdpArqServer::GetBufferObjCapacity()
+{
+	DWORD dwCapacity = __super::GetBufferObjCapacity();
+
+	if(m_arqAttr.bSegmentOffload)
+		dwCapacity = max(dwCapacity, m_arqAttr.dwMtu * ARQ_MAX_OFFLOAD_SEGMENTS);
+
+	return dwCapacity;
+}
+
+EnHandleResult CUdpArqServer::FirePrepareListen(SOCKET soListen)
+{
+	if(m_arqAttr.bSegmentOffload && ::SSO_UDP_SendMsgSize(soListen, m_arqAttr.dwMtu) == SOCKET_ERROR)
+	{
+		TRACE("<S-ARQ> UDP segment offload is not supported (SOCK: %d), fall back to normal send\n", ::WSAGetLastError());
+		m_arqAttr.bSegmentOffload = FALSE;
+	}
+
+	return __super::FirePrepareListen(soListen);
+}
+
 void CUdpArqServer::PrepareStart()
 {
 	__super::PrepareStart();
@@ -53,7 +76,8 @@ void CUdpArqServer::PrepareStart()
 	m_ssPool.SetSessionPoolSize(GetFreeSocketObjPool());
 	m_ssPool.SetSessionPoolHold(GetFreeSocketObjHold());
 
-	m_ssPool.Prepare();
+	m_sgPool.Prepare(m_arqAttr.dwMtu);
+	m_ssPool.Prepare(m_arqAttr.dwFlushInterval);
 }
 
 void CUdpArqServer::Reset()
@@ -62,6 +86,10 @@ void CUdpArqServer::Reset()
 
 	m_ssPool.Clear();
 
+	TRACE("<S-ARQ> KCP segment pool (hit: %llu, miss: %llu, oversize: %llu)\n", m_sgPool.GetHitCount(), m_sgPool.GetMissCount(), m_sgPool.GetOversizeCount());
+
+	m_sgPool.Clear();
+
 	__super::Reset();
 }
 
@@ -153,6 +181,8 @@ BOOL CUdpArqServer::SendPackets(CONNID dwConnID, const WSABUF pBuffers[], int iC
 
 int CUdpArqServer::SendArq(TUdpSocketObj* pSocketObj, const BYTE* pBuffer, int iLength)
 {
+	CEpochLock epochlock(m_ssPool.GetEpoch());
+
 	CArqSessionEx* pSession = nullptr;
 	GetConnectionReserved(pSocketObj, (PVOID*)&pSession);
 
@@ -192,6 +222,8 @@ EnHandleResult CUdpArqServer::FireAccept(TUdpSocketObj* pSocketObj)
 
 EnHandleResult CUdpArqServer::FireReceive(TUdpSocketObj* pSocketObj, const BYTE* pData, int iLength)
 {
+	CEpochLock epochlock(m_ssPool.GetEpoch());
+
 	CArqSessionEx* pSession = nullptr;
 	GetConnectionReserved(pSocketObj, (PVOID*)&pSession);
 
@@ -214,6 +246,8 @@ EnHandleResult CUdpArqServer::FireClose(TUdpSocketObj* pSocketObj, EnSocketOpera
 
 BOOL CUdpArqServer::GetWaitingSendMessageCount(CONNID dwConnID, int& iCount)
 {
+	CEpochLock epochlock(m_ssPool.GetEpoch());
+
 	TUdpSocketObj* pSocketObj = FindSocketObj(dwConnID);
 
 	if(!TUdpSocketObj::IsValid(pSocketObj))
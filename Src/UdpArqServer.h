@@ -48,9 +48,12 @@ protected:
 	virtual EnHandleResult FireReceive(TUdpSocketObj* pSocketObj, const BYTE* pData, int iLength);
 	virtual EnHandleResult FireClose(TUdpSocketObj* pSocketObj, EnSocketOperation enOperation, int iErrorCode);
 
+	virtual EnHandleResult FirePrepareListen(SOCKET soListen);
+
 	virtual BOOL CheckParams();
 	virtual void PrepareStart();
 	virtual void Reset();
+	virtual DWORD GetBufferObjCapacity();
 	virtual void OnWorkerThreadStart(THR_ID dwThreadID);
 
 public:
@@ -65,6 +68,9 @@ public:
 	virtual void SetMaxTransUnit		(DWORD dwMaxTransUnit)		{ENSURE_HAS_STOPPED(); m_dwMtu						= dwMaxTransUnit;}
 	virtual void SetMaxMessageSize		(DWORD dwMaxMessageSize)	{ENSURE_HAS_STOPPED(); m_arqAttr.dwMaxMessageSize	= dwMaxMessageSize;}
 	virtual void SetHandShakeTimeout	(DWORD dwHandShakeTimeout)	{ENSURE_HAS_STOPPED(); m_arqAttr.dwHandShakeTimeout	= dwHandShakeTimeout;}
+	virtual void SetSegmentOffload		(BOOL bSegmentOffload)		{ENSURE_HAS_STOPPED(); m_bSegmentOffload			= bSegmentOffload;}
+	virtual void SetFecDataShards		(DWORD dwDataShards)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFecDataShards	= dwDataShards;}
+	virtual void SetFecParityShards		(DWORD dwParityShards)		{ENSURE_HAS_STOPPED(); m_arqAttr.dwFecParityShards	= dwParityShards;}
 
 	virtual BOOL IsNoDelay				()	{return m_arqAttr.bNoDelay;}
 	virtual BOOL IsTurnoffCongestCtrl	()	{return m_arqAttr.bTurnoffNc;}
@@ -77,12 +83,20 @@ public:
 	virtual DWORD GetMaxTransUnit		()	{return m_arqAttr.dwMtu;}
 	virtual DWORD GetMaxMessageSize		()	{return m_arqAttr.dwMaxMessageSize;}
 	virtual DWORD GetHandShakeTimeout	()	{return m_arqAttr.dwHandShakeTimeout;}
+	virtual BOOL IsSegmentOffload		()	{return m_bSegmentOffload;}
+	virtual DWORD GetFecDataShards		()	{return m_arqAttr.dwFecDataShards;}
+	virtual DWORD GetFecParityShards	()	{return m_arqAttr.dwFecParityShards;}
+
+	virtual ULONGLONG GetSegmentPoolHitCount		()	{return m_sgPool.GetHitCount();}
+	virtual ULONGLONG GetSegmentPoolMissCount		()	{return m_sgPool.GetMissCount();}
+	virtual ULONGLONG GetSegmentPoolOversizeCount	()	{return m_sgPool.GetOversizeCount();}
 
 	virtual BOOL GetWaitingSendMessageCount	(CONNID dwConnID, int& iCount);
 
 public:
 	const TArqAttr& GetArqAttribute		()	{return m_arqAttr;}
 	Fn_ArqOutputProc GetArqOutputProc	()	{return ArqOutputProc;}
+	CArqSegmentPool* GetArqSegmentPool	()	{return &m_sgPool;}
 
 private:
 	int SendArq(TUdpSocketObj* pSocketObj, const BYTE* pBuffer, int iLength);
@@ -92,7 +106,8 @@ private:
 public:
 	CUdpArqServer(IUdpServerListener* pListener)
 	: CUdpServer(pListener)
-	, m_dwMtu	(0)
+	, m_dwMtu			(0)
+	, m_bSegmentOffload	(DEFAULT_ARQ_SEGMENT_OFFLOAD)
 	{
 		
 	}
@@ -107,11 +122,13 @@ private:
 
 private:
 	DWORD			m_dwMtu;
+	BOOL			m_bSegmentOffload;
 	TArqAttr		m_arqAttr;
 
 	CCriSec			m_csRcBuffers;
 	CRecvBufferMap	m_rcBuffers;
 
+	CArqSegmentPool	m_sgPool;
 	CArqSessionPool m_ssPool;
 };
 
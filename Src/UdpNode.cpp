@@ -535,13 +535,73 @@ UINT WINAPI CUdpNode::WorkerThreadProc(LPVOID pv)
 	CUdpNode* pNode	= (CUdpNode*)pv;
 	pNode->OnWorkerThreadStart(SELF_THREAD_ID);
 
+#if _WIN32_WINNT >= _WIN32_WINNT_VISTA
+
+	OVERLAPPED_ENTRY entries[MAX_IOCP_BATCH_ENTRIES];
+	BOOL bExit = FALSE;
+
+	while(!bExit)
+	{
+		ULONG ulCount	= 0;
+		BOOL bSend		= FALSE;
+
+		BOOL result = ::GetQueuedCompletionStatusEx
+												(
+													pNode->m_hCompletePort,
+													entries,
+													MAX_IOCP_BATCH_ENTRIES,
+													&ulCount,
+													INFINITE,
+													FALSE
+												);
+
+		if(!result)
+		{
+			TRACE("GetQueuedCompletionStatusEx error (SYS: %d)\n", ::GetLastError());
+			ASSERT(FALSE);
+
+			break;
+		}
+
+		for(ULONG i = 0; i < ulCount; i++)
+		{
+			OVERLAPPED_ENTRY& entry = entries[i];
+			OVERLAPPED* pOverlapped	= entry.lpOverlapped;
+
+			if(pOverlapped == nullptr)
+			{
+				if(entry.dwNumberOfBytesTransferred == IOCP_CMD_EXIT && bExit)
+				{
+					// 同一批次中的多余退出指令转交给其它工作线程
+					ENSURE(::PostIocpExit(pNode->m_hCompletePort));
+					continue;
+				}
+				else if(entry.dwNumberOfBytesTransferred == IOCP_CMD_SEND)
+				{
+					// 同一批次中的发送指令合并，在批次结束时统一发送
+					bSend = TRUE;
+					continue;
+				}
+			}
+
+			result = (pOverlapped == nullptr || IOCP_OV_SUCCESS(pOverlapped));
+
+			if(pNode->DispatchCompletion(pOverlapped, entry.dwNumberOfBytesTransferred, entry.lpCompletionKey, result, NO_ERROR) == IOCP_ACT_BREAK)
+				bExit = TRUE;
+		}
+
+		if(bSend)
+			pNode->ProcessSend();
+	}
+
+#else
+
 	while(TRUE)
 	{
-		DWORD dwErrorCode = NO_ERROR;
 		DWORD dwBytes;
-		ULONG_PTR ulCompKey;
 		OVERLAPPED* pOverlapped;
-		
+		ULONG_PTR ulCompKey;
+
 		BOOL result = ::GetQueuedCompletionStatus
 												(
 													pNode->m_hCompletePort,
@@ -551,45 +611,49 @@ UINT WINAPI CUdpNode::WorkerThreadProc(LPVOID pv)
 													INFINITE
 												);
 
-		if(pOverlapped == nullptr)
-		{
-			EnIocpAction action = pNode->CheckIocpCommand(pOverlapped, dwBytes, ulCompKey);
+		if(pNode->DispatchCompletion(pOverlapped, dwBytes, ulCompKey, result, result ? NO_ERROR : ::GetLastError()) == IOCP_ACT_BREAK)
+			break;
+	}
 
-			if(action == IOCP_ACT_CONTINUE)
-				continue;
-			else if(action == IOCP_ACT_BREAK)
-				break;
-		}
+#endif
 
-		TUdpBufferObj* pBufferObj = CONTAINING_RECORD(pOverlapped, TUdpBufferObj, ov);
+	pNode->OnWorkerThreadEnd(SELF_THREAD_ID);
+
+	return 0;
+}
 
-		if (!result)
+EnIocpAction CUdpNode::DispatchCompletion(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey, BOOL result, DWORD dwSysCode)
+{
+	if(pOverlapped == nullptr)
+		return CheckIocpCommand(pOverlapped, dwBytes, ulCompKey);
+
+	DWORD dwErrorCode			= NO_ERROR;
+	TUdpBufferObj* pBufferObj	= CONTAINING_RECORD(pOverlapped, TUdpBufferObj, ov);
+
+	if (!result)
+	{
+		DWORD dwFlag = 0;
+
+		// dwSysCode 为 NO_ERROR 表示调用方无法获取系统错误代码（批量出队），需通过 WSAGetOverlappedResult() 获取
+		if(HasStarted() || dwSysCode == NO_ERROR)
 		{
-			DWORD dwFlag	= 0;
-			DWORD dwSysCode = ::GetLastError();
+			result = ::WSAGetOverlappedResult((SOCKET)ulCompKey, &pBufferObj->ov, &dwBytes, FALSE, &dwFlag);
 
-			if(pNode->HasStarted())
+			if (!result)
 			{
-				result = ::WSAGetOverlappedResult((SOCKET)ulCompKey, &pBufferObj->ov, &dwBytes, FALSE, &dwFlag);
-
-				if (!result)
-				{
-					dwErrorCode = ::WSAGetLastError();
-					TRACE("GetQueuedCompletionStatus error (<NODE: 0x%X> SYS: %d, SOCK: %d, FLAG: %d)\n", pNode, dwSysCode, dwErrorCode, dwFlag);
-				}
+				dwErrorCode = ::WSAGetLastError();
+				TRACE("GetQueuedCompletionStatus error (<NODE: 0x%X> SYS: %d, SOCK: %d, FLAG: %d)\n", this, dwSysCode, dwErrorCode, dwFlag);
 			}
-			else
-				dwErrorCode = dwSysCode;
-
-			ASSERT(dwSysCode != 0 && dwErrorCode != 0);
 		}
+		else
+			dwErrorCode = dwSysCode;
 
-		pNode->HandleIo(pBufferObj, dwBytes, dwErrorCode);
+		ASSERT(result || dwErrorCode != 0);
 	}
 
-	pNode->OnWorkerThreadEnd(SELF_THREAD_ID);
+	HandleIo(pBufferObj, dwBytes, dwErrorCode);
 
-	return 0;
+	return IOCP_ACT_GOON;
 }
 
 EnIocpAction CUdpNode::CheckIocpCommand(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey)
@@ -118,6 +118,7 @@ private:
 	TUdpBufferObj*	GetFreeBufferObj(int iLen = -1);
 	void			AddFreeBufferObj(TUdpBufferObj* pBufferObj);
 
+	EnIocpAction DispatchCompletion(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey, BOOL result, DWORD dwSysCode);
 	EnIocpAction CheckIocpCommand(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey);
 	void HandleIo(TUdpBufferObj* pBufferObj, DWORD dwBytes, DWORD dwErrorCode);
 	void HandleError(TUdpBufferObj* pBufferObj, DWORD dwErrorCode);
@@ -157,11 +157,20 @@ void CUdpServer::PrepareStart()
 	m_bfActiveSockets.Reset(m_dwMaxConnectionCount);
 	m_lsFreeSocket.Reset(m_dwFreeSocketObjPool);
 
-	m_bfObjPool.SetItemCapacity(m_dwMaxDatagramSize);
+	m_bfObjPool.SetItemCapacity(GetBufferObjCapacity());
 	m_bfObjPool.SetPoolSize(m_dwFreeBufferObjPool);
 	m_bfObjPool.SetPoolHold(m_dwFreeBufferObjHold);
 
 	m_bfObjPool.Prepare();
+
+#ifdef _DEBUG
+	TUdpSocketObj* pSocketObj = TUdpSocketObj::Construct(m_phSocket, m_bfObjPool);
+	::CheckSocketObjLayout("TUdpSocketObj", pSocketObj);
+	TUdpSocketObj::Destruct(pSocketObj);
+#endif
+
+	if(IsNeedDetectConnection())
+		m_tqDetect.CreateTimer(DetectTimerProc, this, m_twDetect.GetTick());
 }
 
 BOOL CUdpServer::CheckStarting()
@@ -319,6 +328,7 @@ BOOL CUdpServer::Stop()
 void CUdpServer::Reset()
 {
 	m_tqDetect.Reset();
+	m_twDetect.Reset();
 	m_phSocket.Reset();
 
 	m_iRemainPostReceives	= 0;
@@ -422,8 +432,7 @@ void CUdpServer::AddFreeSocketObj(TUdpSocketObj* pSocketObj, EnSocketCloseFlag e
 		m_mpClientAddr.erase(&pSocketObj->remoteAddr);
 	}
 
-	if(pSocketObj->hTimer != nullptr)
-		m_tqDetect.DeleteTimer(pSocketObj->hTimer);
+	m_twDetect.Cancel(&pSocketObj->timer);
 
 	TUdpSocketObj::Release(pSocketObj);
 
@@ -447,13 +456,13 @@ void CUdpServer::AddClientSocketObj(CONNID dwConnID, TUdpSocketObj* pSocketObj,
 {
 	ASSERT(FindSocketObj(dwConnID) == nullptr);
 
-	if(IsNeedDetectConnection())
-		pSocketObj->hTimer	= m_tqDetect.CreateTimer(DetectConnectionProc, pSocketObj, m_dwDetectInterval);
-
 	pSocketObj->pHolder		= this;
 	pSocketObj->connTime	= ::TimeGetTime();
 	pSocketObj->activeTime	= pSocketObj->connTime;
 
+	if(IsNeedDetectConnection())
+		m_twDetect.Schedule(&pSocketObj->timer, m_dwDetectInterval);
+
 	remoteAddr.Copy(pSocketObj->remoteAddr);
 	pSocketObj->SetConnected();
 
@@ -866,13 +875,82 @@ UINT WINAPI CUdpServer::WorkerThreadProc(LPVOID pv)
 	CUdpServer* pServer	= (CUdpServer*)pv;
 	pServer->OnWorkerThreadStart(SELF_THREAD_ID);
 
+#if _WIN32_WINNT >= _WIN32_WINNT_VISTA
+
+	OVERLAPPED_ENTRY entries[MAX_IOCP_BATCH_ENTRIES];
+	CONNID sends[MAX_IOCP_BATCH_ENTRIES];
+	BOOL bExit = FALSE;
+
+	while(!bExit)
+	{
+		ULONG ulCount = 0;
+		ULONG ulSends = 0;
+
+		BOOL result = ::GetQueuedCompletionStatusEx
+												(
+													pServer->m_hCompletePort,
+													entries,
+													MAX_IOCP_BATCH_ENTRIES,
+													&ulCount,
+													INFINITE,
+													FALSE
+												);
+
+		if(!result)
+		{
+			TRACE("GetQueuedCompletionStatusEx error (SYS: %d)\n", ::GetLastError());
+			ASSERT(FALSE);
+
+			break;
+		}
+
+		for(ULONG i = 0; i < ulCount; i++)
+		{
+			OVERLAPPED_ENTRY& entry = entries[i];
+			OVERLAPPED* pOverlapped	= entry.lpOverlapped;
+
+			if(pOverlapped == nullptr)
+			{
+				if(entry.dwNumberOfBytesTransferred == IOCP_CMD_EXIT && bExit)
+				{
+					// 同一批次中的多余退出指令转交给其它工作线程
+					ENSURE(::PostIocpExit(pServer->m_hCompletePort));
+					continue;
+				}
+				else if(entry.dwNumberOfBytesTransferred == IOCP_CMD_SEND)
+				{
+					// 同一批次中同一连接的发送指令合并，在批次结束时统一发送
+					CONNID dwConnID = (CONNID)entry.lpCompletionKey;
+					ULONG j			= 0;
+
+					while(j < ulSends && sends[j] != dwConnID)
+						++j;
+
+					if(j == ulSends)
+						sends[ulSends++] = dwConnID;
+
+					continue;
+				}
+			}
+
+			result = (pOverlapped == nullptr || IOCP_OV_SUCCESS(pOverlapped));
+
+			if(pServer->DispatchCompletion(pOverlapped, entry.dwNumberOfBytesTransferred, entry.lpCompletionKey, result, NO_ERROR) == IOCP_ACT_BREAK)
+				bExit = TRUE;
+		}
+
+		for(ULONG j = 0; j < ulSends; j++)
+			pServer->DoSend(sends[j]);
+	}
+
+#else
+
 	while(TRUE)
 	{
-		DWORD dwErrorCode = NO_ERROR;
 		DWORD dwBytes;
-		ULONG_PTR ulCompKey;
 		OVERLAPPED* pOverlapped;
-		
+		ULONG_PTR ulCompKey;
+
 		BOOL result = ::GetQueuedCompletionStatus
 												(
 													pServer->m_hCompletePort,
@@ -882,46 +960,50 @@ UINT WINAPI CUdpServer::WorkerThreadProc(LPVOID pv)
 													INFINITE
 												);
 
-		if(pOverlapped == nullptr)
-		{
-			EnIocpAction action = pServer->CheckIocpCommand(pOverlapped, dwBytes, ulCompKey);
+		if(pServer->DispatchCompletion(pOverlapped, dwBytes, ulCompKey, result, result ? NO_ERROR : ::GetLastError()) == IOCP_ACT_BREAK)
+			break;
+	}
 
-			if(action == IOCP_ACT_CONTINUE)
-				continue;
-			else if(action == IOCP_ACT_BREAK)
-				break;
-		}
+#endif
+
+	pServer->OnWorkerThreadEnd(SELF_THREAD_ID);
+
+	return 0;
+}
+
+EnIocpAction CUdpServer::DispatchCompletion(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey, BOOL result, DWORD dwSysCode)
+{
+	if(pOverlapped == nullptr)
+		return CheckIocpCommand(pOverlapped, dwBytes, ulCompKey);
 
-		TUdpBufferObj* pBufferObj	= CONTAINING_RECORD(pOverlapped, TUdpBufferObj, ov);
-		CONNID dwConnID				= pServer->FindConnectionID(&pBufferObj->remoteAddr);
+	DWORD dwErrorCode			= NO_ERROR;
+	TUdpBufferObj* pBufferObj	= CONTAINING_RECORD(pOverlapped, TUdpBufferObj, ov);
+	CONNID dwConnID				= FindConnectionID(&pBufferObj->remoteAddr);
+
+	if (!result)
+	{
+		DWORD dwFlag = 0;
 
-		if (!result)
+		// dwSysCode 为 NO_ERROR 表示调用方无法获取系统错误代码（批量出队），需通过 WSAGetOverlappedResult() 获取
+		if(HasStarted() || dwSysCode == NO_ERROR)
 		{
-			DWORD dwFlag	= 0;
-			DWORD dwSysCode = ::GetLastError();
+			result = ::WSAGetOverlappedResult((SOCKET)ulCompKey, &pBufferObj->ov, &dwBytes, FALSE, &dwFlag);
 
-			if(pServer->HasStarted())
+			if (!result)
 			{
-				result = ::WSAGetOverlappedResult((SOCKET)ulCompKey, &pBufferObj->ov, &dwBytes, FALSE, &dwFlag);
-
-				if (!result)
-				{
-					dwErrorCode = ::WSAGetLastError();
-					TRACE("GetQueuedCompletionStatus error (<S-CNNID: %Iu> SYS: %d, SOCK: %d, FLAG: %d)\n", dwConnID, dwSysCode, dwErrorCode, dwFlag);
-				}
+				dwErrorCode = ::WSAGetLastError();
+				TRACE("GetQueuedCompletionStatus error (<S-CNNID: %Iu> SYS: %d, SOCK: %d, FLAG: %d)\n", dwConnID, dwSysCode, dwErrorCode, dwFlag);
 			}
-			else
-				dwErrorCode = dwSysCode;
-
-			ASSERT(dwSysCode != 0 && dwErrorCode != 0);
 		}
+		else
+			dwErrorCode = dwSysCode;
 
-		pServer->HandleIo(dwConnID, pBufferObj, dwBytes, dwErrorCode);
+		ASSERT(result || dwErrorCode != 0);
 	}
 
-	pServer->OnWorkerThreadEnd(SELF_THREAD_ID);
+	HandleIo(dwConnID, pBufferObj, dwBytes, dwErrorCode);
 
-	return 0;
+	return IOCP_ACT_GOON;
 }
 
 EnIocpAction CUdpServer::CheckIocpCommand(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey)
@@ -1440,7 +1522,7 @@ int CUdpServer::SendItem(TUdpSocketObj* pSocketObj)
 		int iBufferSize		 = pBufferObj->buff.len;
 		pSocketObj->pending	-= iBufferSize;
 
-		ASSERT(iBufferSize > 0 && iBufferSize <= (int)m_dwMaxDatagramSize);
+		ASSERT(iBufferSize > 0 && iBufferSize <= (int)m_bfObjPool.GetItemCapacity());
 
 		::InterlockedExchangeAdd(&pSocketObj->sndCount, iBufferSize);
 
@@ -1479,19 +1561,27 @@ BOOL CUdpServer::SendDetectPackage(CONNID dwConnID, TUdpSocketObj* pSocketObj)
 	return isOK;
 }
 
-void WINAPI CUdpServer::DetectConnectionProc(LPVOID pv, BOOLEAN bTimerFired)
+void WINAPI CUdpServer::DetectTimerProc(LPVOID pv, BOOLEAN bTimerFired)
 {
-	TUdpSocketObj* pSocketObj = (TUdpSocketObj*)pv;
+	CUdpServer* pServer = (CUdpServer*)pv;
 
-	if(TUdpSocketObj::IsValid(pSocketObj))
-	{
-		CUdpServer* pServer = (CUdpServer*)pSocketObj->pHolder;
+	pServer->m_twDetect.Advance(DetectConnectionProc, pServer);
+}
 
-		if(pSocketObj->detectFails >= pServer->m_dwDetectAttempts)
-			::PostIocpTimeout(pServer->m_hCompletePort, pSocketObj->connID);
-		else
-			::InterlockedIncrement(&pSocketObj->detectFails);
-	}
+DWORD CUdpServer::DetectConnectionProc(TTimerNode* pNode, PVOID pv)
+{
+	CUdpServer* pServer			= (CUdpServer*)pv;
+	TUdpSocketObj* pSocketObj	= CONTAINING_RECORD(pNode, TUdpSocketObj, timer);
+
+	if(!TUdpSocketObj::IsValid(pSocketObj))
+		return 0;
+
+	if(pSocketObj->detectFails >= pServer->m_dwDetectAttempts)
+		::PostIocpTimeout(pServer->m_hCompletePort, pSocketObj->connID);
+	else
+		::InterlockedIncrement(&pSocketObj->detectFails);
+
+	return pServer->m_dwDetectInterval;
 }
 
 #endif
@@ -142,6 +142,8 @@ protected:
 	virtual void PrepareStart();
 	virtual void Reset();
 
+	virtual DWORD GetBufferObjCapacity() {return m_dwMaxDatagramSize;}
+
 	virtual void OnWorkerThreadStart(THR_ID dwThreadID) {}
 	virtual void OnWorkerThreadEnd(THR_ID dwThreadID) {}
 
@@ -172,7 +174,8 @@ private:
 	friend void ContinueReceiveFrom<>(CUdpServer* pThis, TUdpBufferObj* pBufferObj);
 	
 	static UINT WINAPI WorkerThreadProc(LPVOID pv);
-	static void WINAPI DetectConnectionProc(LPVOID pv, BOOLEAN bTimerFired);
+	static void WINAPI DetectTimerProc(LPVOID pv, BOOLEAN bTimerFired);
+	static DWORD DetectConnectionProc(TTimerNode* pNode, PVOID pv);
 
 private:
 	BOOL CheckStarting();
@@ -209,6 +212,7 @@ private:
 	CONNID			FindConnectionID(const HP_SOCKADDR* pAddr);
 
 private:
+	EnIocpAction DispatchCompletion(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey, BOOL result, DWORD dwSysCode);
 	EnIocpAction CheckIocpCommand(OVERLAPPED* pOverlapped, DWORD dwBytes, ULONG_PTR ulCompKey);
 
 	void ForceDisconnect(CONNID dwConnID, BOOL bNotify = FALSE);
@@ -316,6 +320,7 @@ private:
 	CCriSec					m_csAccept;
 
 	CTimerQueue				m_tqDetect;
+	CTimingWheel			m_twDetect;
 
 	TUdpSocketObjPtrPool	m_bfActiveSockets;
 